@@ -5,11 +5,23 @@
  * @date 10/23/2019
  */
 
-#include <pybind11/pybind11.h>
+#include "NumpyHelper.h"
 #include <pybind11/stl.h>
 #include "interface/AbcInterface.h"
+#include "interface/AigCheckpoint.h"
 
 namespace py = pybind11;
+
+/// @brief the return value of an action: the step result if asked for, otherwise whether it succeeded
+static py::object actionResult(const PROJECT_NAMESPACE::AbcInterface &abc, bool success, bool step)
+{
+    if (step)
+    {
+        return py::cast(abc.lastStep());
+    }
+    return py::cast(success);
+}
+
 void initAbcInterfaceAPI(py::module &m)
 {
     py::class_<PROJECT_NAMESPACE::AbcInterface>(m , "AbcInterface")
@@ -17,19 +29,272 @@ void initAbcInterfaceAPI(py::module &m)
         .def("start", &PROJECT_NAMESPACE::AbcInterface::start, "Start the ABC framework")
         .def("end", &PROJECT_NAMESPACE::AbcInterface::end, "Stop the ABC framework")
         .def("read", &PROJECT_NAMESPACE::AbcInterface::read, "Read a file")
+        .def("write", &PROJECT_NAMESPACE::AbcInterface::write, "Write the current network in the format of the file extension, e.g. .aig",
+                py::arg("filename"))
+        .def("execute",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, const std::string &cmd, bool step) { return actionResult(abc, abc.execute(cmd), step); },
+                "Execute any ABC command or script as one action. Returns the StepResult if step is set",
+                py::arg("cmd"), py::arg("step") = false)
         .def("aigStats", &PROJECT_NAMESPACE::AbcInterface::aigStats, "Get the AIG stats from the ABC framework`")
-        .def("balance", &PROJECT_NAMESPACE::AbcInterface::balance, "balance action",
-                py::arg("l") = false, py::arg("d") = false, py::arg("s") = false, py::arg("x") = false)
-        .def("resub", &PROJECT_NAMESPACE::AbcInterface::resub, "resub action",
+        .def("balance",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool l, bool d, bool s, bool x, bool step)
+                { return actionResult(abc, abc.balance(l, d, s, x), step); },
+                "balance action. Returns the StepResult if step is set",
+                py::arg("l") = false, py::arg("d") = false, py::arg("s") = false, py::arg("x") = false, py::arg("step") = false)
+        .def("resub",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, PROJECT_NAMESPACE::IntType k, PROJECT_NAMESPACE::IntType n, PROJECT_NAMESPACE::IntType f, bool l, bool z, bool step)
+                { return actionResult(abc, abc.resub(k, n, f, l, z), step); },
+                "resub action. Returns the StepResult if step is set",
                 py::arg("k") = -1, py::arg("n") = -1, py::arg("f") = -1,
-                py::arg("l") = false, py::arg("z") = false)
-        .def("rewrite", &PROJECT_NAMESPACE::AbcInterface::rewrite, "rewrite action",
-                py::arg("l") = false, py::arg("z") = false)
-        .def("refactor", &PROJECT_NAMESPACE::AbcInterface::refactor, "refactor action",
-                py::arg("n") = -1, py::arg("l") = false, py::arg("z") = false)
-        .def("compress2rs", &PROJECT_NAMESPACE::AbcInterface::compress2rs)
+                py::arg("l") = false, py::arg("z") = false, py::arg("step") = false)
+        .def("rewrite",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool l, bool z, bool step)
+                { return actionResult(abc, abc.rewrite(l, z), step); },
+                "rewrite action. Returns the StepResult if step is set",
+                py::arg("l") = false, py::arg("z") = false, py::arg("step") = false)
+        .def("refactor",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, PROJECT_NAMESPACE::IntType n, bool l, bool z, bool step)
+                { return actionResult(abc, abc.refactor(n, l, z), step); },
+                "refactor action. Returns the StepResult if step is set",
+                py::arg("n") = -1, py::arg("l") = false, py::arg("z") = false, py::arg("step") = false)
+        .def("compress2rs",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool step) { return actionResult(abc, abc.compress2rs(), step); },
+                "compress2rs baseline, recorded as one step. Returns the StepResult if step is set", py::arg("step") = false)
+        .def("takeAction",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, PROJECT_NAMESPACE::IntType action, bool step) { return actionResult(abc, abc.takeAction(action), step); },
+                "Take an action of the discrete action space AbcAction. Returns the StepResult if step is set", py::arg("action"), py::arg("step") = false)
+        .def("giaBalance",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool d, bool step) { return actionResult(abc, abc.giaBalance(d), step); },
+                "&b action on the GIA. Returns the StepResult if step is set", py::arg("d") = false, py::arg("step") = false)
+        .def("giaSyn2",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool step) { return actionResult(abc, abc.giaSyn2(), step); },
+                "&syn2 action on the GIA. Returns the StepResult if step is set", py::arg("step") = false)
+        .def("giaDc2",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool step) { return actionResult(abc, abc.giaDc2(), step); },
+                "&dc2 action on the GIA. Returns the StepResult if step is set", py::arg("step") = false)
+        .def("giaDch",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, bool step) { return actionResult(abc, abc.giaDch(), step); },
+                "&dch action on the GIA. Returns the StepResult if step is set", py::arg("step") = false)
+        .def("takeGiaAction",
+                [](PROJECT_NAMESPACE::AbcInterface &abc, PROJECT_NAMESPACE::IntType action, bool step) { return actionResult(abc, abc.takeGiaAction(action), step); },
+                "Take an action of the GIA action space GiaAction. Returns the StepResult if step is set", py::arg("action"), py::arg("step") = false)
+        .def("setGiaMode", &PROJECT_NAMESPACE::AbcInterface::setGiaMode,
+                "Whether read moves the design to the GIA right away", py::arg("giaMode") = true)
+        .def("giaMode", &PROJECT_NAMESPACE::AbcInterface::giaMode, "Whether read moves the design to the GIA")
+        .def("isGiaCurrent", &PROJECT_NAMESPACE::AbcInterface::isGiaCurrent, "Whether the current design is the GIA rather than the network")
+        .def("setStepTracking", &PROJECT_NAMESPACE::AbcInterface::setStepTracking,
+                "Whether the step results count the created and removed nodes", py::arg("stepTracking") = true)
+        .def("setActionTimeout", &PROJECT_NAMESPACE::AbcInterface::setActionTimeout,
+                "The time budget of each action in seconds, 0 for none. An action past it fails and leaves the network as before; "
+                "compress2rs keeps the network of its finished sub-actions", py::arg("timeoutSec"))
+        .def("actionTimeout", &PROJECT_NAMESPACE::AbcInterface::actionTimeout, "The time budget of each action in seconds. 0 for none")
+        .def("lastStep", &PROJECT_NAMESPACE::AbcInterface::lastStep, "The StepResult of the last action")
         .def("aigNode", &PROJECT_NAMESPACE::AbcInterface::aigNode, "Get one AigNode")
-        .def("numNodes", &PROJECT_NAMESPACE::AbcInterface::numNodes, "Get the number of nodes");
+        .def("numNodes", &PROJECT_NAMESPACE::AbcInterface::numNodes, "Get the number of nodes")
+        .def("updateGraph", &PROJECT_NAMESPACE::AbcInterface::updateGraph, "Update the mirrored graph. Also done by read and aigStats")
+        .def("setCompressedFanouts", &PROJECT_NAMESPACE::AbcInterface::setCompressedFanouts,
+                "Whether the graph update packs the fanouts, sorted and group varint coded", py::arg("compressed") = true)
+        .def("compressedFanouts", &PROJECT_NAMESPACE::AbcInterface::compressedFanouts, "Whether the graph update packs the fanouts")
+        .def("setCompactIds", &PROJECT_NAMESPACE::AbcInterface::setCompactIds,
+                "Whether the graph update renumbers the mirror with dense, topologically ordered ids", py::arg("compactIds") = true)
+        .def("compactIds", &PROJECT_NAMESPACE::AbcInterface::compactIds, "Whether the graph update compacts the ids")
+        .def("compactToAbc", [](const PROJECT_NAMESPACE::AbcInterface &abc) { return toNumpy(abc.compactToAbc()); },
+                "The ABC object id of each node of the mirror. Empty unless the ids are compacted")
+        .def("abcToCompact", [](const PROJECT_NAMESPACE::AbcInterface &abc) { return toNumpy(abc.abcToCompact()); },
+                "The node of the mirror of each ABC object id, -1 for the deleted objects. Empty unless the ids are compacted")
+        .def("setLevelPartition", &PROJECT_NAMESPACE::AbcInterface::setLevelPartition,
+                "Whether the graph update also partitions the graph into topological layers", py::arg("levelPartition") = true)
+        .def("levelPartition", &PROJECT_NAMESPACE::AbcInterface::levelPartition,
+                "The topological layers built by the last graph update", py::return_value_policy::reference_internal)
+        .def("setGraphDiff", &PROJECT_NAMESPACE::AbcInterface::setGraphDiff,
+                "Whether the graph update matches the new nodes to the last mirror by structure", py::arg("graphDiff") = true)
+        .def("graphDiff", &PROJECT_NAMESPACE::AbcInterface::graphDiff,
+                "The AigGraphDiff between the mirrors of the last two graph updates", py::return_value_policy::reference_internal)
+        .def("graphGeneration", &PROJECT_NAMESPACE::AbcInterface::graphGeneration,
+                "The generation of the mirror. It moves on with each graph update and each action")
+        .def("mirrorGeneration", &PROJECT_NAMESPACE::AbcInterface::mirrorGeneration,
+                "The generation the mirror was built at by the last graph update")
+        .def("sweep", &PROJECT_NAMESPACE::AbcInterface::sweep,
+                "Evaluate the points of a ParamSweep on copies of the current network in parallel. Returns a SweepRow per point",
+                py::arg("paramSweep"), py::call_guard<py::gil_scoped_release>())
+        .def("takeSweepRow", &PROJECT_NAMESPACE::AbcInterface::takeSweepRow,
+                "Take the network a sweep point left, as its action would, without running it again. Needs ParamSweep.setKeepNetworks(True)",
+                py::arg("row"))
+        .def("memoryUsage", &PROJECT_NAMESPACE::AbcInterface::memoryUsage,
+                "The bytes held by the ABC network, the mirror, the snapshots and the caches, with the process RSS")
+        .def("actionMemoryPeaks", &PROJECT_NAMESPACE::AbcInterface::actionMemoryPeaks,
+                "The high-water mark of the total bytes held after each kind of action, by action name")
+        .def("setMemoryCap", &PROJECT_NAMESPACE::AbcInterface::setMemoryCap,
+                "Soft memory cap in bytes. Once reached, checkpoints, verify snapshots and new mapping cache entries are refused. 0 for none",
+                py::arg("memoryCap"))
+        .def("memoryCap", &PROJECT_NAMESPACE::AbcInterface::memoryCap, "The soft memory cap in bytes. 0 for none")
+        .def("checkpoint", &PROJECT_NAMESPACE::AbcInterface::checkpoint,
+                "Save the current network, the reference network of verify and the mirrored graph to a file", py::arg("filename"))
+        .def("restore", &PROJECT_NAMESPACE::AbcInterface::restore,
+                "Replace the current and the reference network with the ones in a checkpoint file", py::arg("filename"))
+        .def(py::pickle(
+                [](PROJECT_NAMESPACE::AbcInterface &abc)
+                {
+                    // The flag tells an empty environment from a design that failed to serialize
+                    bool hasDesign = abc.hasDesign();
+                    std::string bytes = hasDesign ? abc.serialize() : "";
+                    if (hasDesign && bytes.empty())
+                    {
+                        throw std::runtime_error("Cannot pickle the AbcInterface: its network cannot be checkpointed, "
+                                "e.g. it has latches or the memory cap is reached");
+                    }
+                    return py::make_tuple(hasDesign, py::bytes(bytes));
+                },
+                [](py::tuple state)
+                {
+                    if (state.size() != 2)
+                    {
+                        throw std::runtime_error("Cannot restore the AbcInterface: the pickled state is not (hasDesign, checkpoint)");
+                    }
+                    bool hasDesign = state[0].cast<bool>();
+                    std::string bytes = state[1].cast<py::bytes>();
+                    if (hasDesign == bytes.empty())
+                    {
+                        throw std::runtime_error("Cannot restore the AbcInterface: the pickled checkpoint does not match its design flag");
+                    }
+                    // The framework is per process. Loading the network here would silently replace the network of the
+                    // environments already in the process, e.g. the original of copy.deepcopy()
+                    if (PROJECT_NAMESPACE::AbcInterface::numLiveEnvs() > 0)
+                    {
+                        throw std::runtime_error("Cannot unpickle an AbcInterface in a process with a live environment, whose network it would replace. "
+                                "Unpickle it in a worker process, or restore() a checkpoint into the environment");
+                    }
+                    auto abc = new PROJECT_NAMESPACE::AbcInterface();
+                    abc->start();
+                    if (hasDesign && !abc->deserialize(bytes.data(), bytes.size()))
+                    {
+                        delete abc;
+                        throw std::runtime_error("Cannot restore the AbcInterface from the pickled checkpoint");
+                    }
+                    return abc;
+                }));
+
+    py::class_<PROJECT_NAMESPACE::MemoryUsage>(m, "MemoryUsage")
+        .def(py::init<>())
+        .def_property_readonly("network", &PROJECT_NAMESPACE::MemoryUsage::network, "The current ABC network, with its memory managers")
+        .def_property_readonly("mirror", &PROJECT_NAMESPACE::MemoryUsage::mirror, "The mirrored graph and its level partition")
+        .def_property_readonly("snapshots", &PROJECT_NAMESPACE::MemoryUsage::snapshots, "The snapshot of the design read kept by verify, with its solver")
+        .def_property_readonly("caches", &PROJECT_NAMESPACE::MemoryUsage::caches, "The mapping results and the step tracking keys")
+        .def_property_readonly("total", &PROJECT_NAMESPACE::MemoryUsage::total)
+        .def_property_readonly("resident", &PROJECT_NAMESPACE::MemoryUsage::resident, "The RSS of the process")
+        .def_property_readonly("peakResident", &PROJECT_NAMESPACE::MemoryUsage::peakResident, "The peak RSS of the process");
+
+    py::enum_<PROJECT_NAMESPACE::AbcAction>(m, "AbcAction")
+        .value("BALANCE", PROJECT_NAMESPACE::AbcAction::BALANCE)
+        .value("REWRITE", PROJECT_NAMESPACE::AbcAction::REWRITE)
+        .value("REWRITE_Z", PROJECT_NAMESPACE::AbcAction::REWRITE_Z)
+        .value("REFACTOR", PROJECT_NAMESPACE::AbcAction::REFACTOR)
+        .value("REFACTOR_Z", PROJECT_NAMESPACE::AbcAction::REFACTOR_Z)
+        .value("RESUB", PROJECT_NAMESPACE::AbcAction::RESUB)
+        .value("RESUB_Z", PROJECT_NAMESPACE::AbcAction::RESUB_Z)
+        .value("NUMBER", PROJECT_NAMESPACE::AbcAction::NUMBER);
+
+    py::enum_<PROJECT_NAMESPACE::GiaAction>(m, "GiaAction")
+        .value("BALANCE", PROJECT_NAMESPACE::GiaAction::BALANCE)
+        .value("SYN2", PROJECT_NAMESPACE::GiaAction::SYN2)
+        .value("DC2", PROJECT_NAMESPACE::GiaAction::DC2)
+        .value("DCH", PROJECT_NAMESPACE::GiaAction::DCH)
+        .value("NUMBER", PROJECT_NAMESPACE::GiaAction::NUMBER);
+
+    py::enum_<PROJECT_NAMESPACE::VerifyStatus>(m, "VerifyStatus")
+        .value("PASS", PROJECT_NAMESPACE::VerifyStatus::PASS)
+        .value("FAIL", PROJECT_NAMESPACE::VerifyStatus::FAIL)
+        .value("UNDECIDED", PROJECT_NAMESPACE::VerifyStatus::UNDECIDED);
+
+    py::class_<PROJECT_NAMESPACE::VerifyResult>(m, "VerifyResult")
+        .def(py::init<>())
+        .def_property_readonly("status", &PROJECT_NAMESPACE::VerifyResult::status)
+        .def_property_readonly("passed", &PROJECT_NAMESPACE::VerifyResult::passed)
+        .def_property_readonly("failingOutput", &PROJECT_NAMESPACE::VerifyResult::failingOutput, "The first failing PO. -1 if none")
+        .def_property_readonly("counterexample", &PROJECT_NAMESPACE::VerifyResult::counterexample, "The PI values of the counterexample. Empty if none")
+        .def_property_readonly("bySimulation", &PROJECT_NAMESPACE::VerifyResult::bySimulation, "Whether simulation alone decided the result")
+        .def_property_readonly("numSatCalls", &PROJECT_NAMESPACE::VerifyResult::numSatCalls);
+
+    py::enum_<PROJECT_NAMESPACE::MappingMode>(m, "MappingMode")
+        .value("LUT", PROJECT_NAMESPACE::MappingMode::LUT)
+        .value("CELL", PROJECT_NAMESPACE::MappingMode::CELL);
+
+    py::class_<PROJECT_NAMESPACE::MappingQoR>(m, "MappingQoR")
+        .def(py::init<>())
+        .def_property_readonly("success", &PROJECT_NAMESPACE::MappingQoR::success)
+        .def_property_readonly("area", &PROJECT_NAMESPACE::MappingQoR::area, "The number of LUTs, or the total cell area")
+        .def_property_readonly("delay", &PROJECT_NAMESPACE::MappingQoR::delay, "The LUT depth, or the arrival time of the critical path")
+        .def_property_readonly("numCells", &PROJECT_NAMESPACE::MappingQoR::numCells)
+        .def_property_readonly("runtime", &PROJECT_NAMESPACE::MappingQoR::runtime, "Wall time of the mapping in seconds");
+
+    py::class_<std::shared_future<PROJECT_NAMESPACE::MappingQoR>>(m, "MappingFuture")
+        .def("ready", [](const std::shared_future<PROJECT_NAMESPACE::MappingQoR> &future)
+                { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; },
+                "Whether the result is available")
+        .def("wait", [](const std::shared_future<PROJECT_NAMESPACE::MappingQoR> &future, double timeout)
+                { return future.wait_for(std::chrono::duration<double>(timeout)) == std::future_status::ready; },
+                "Wait up to timeout seconds. Returns whether the result is available", py::arg("timeout"), py::call_guard<py::gil_scoped_release>())
+        .def("result", [](const std::shared_future<PROJECT_NAMESPACE::MappingQoR> &future) { return future.get(); },
+                "Wait for and get the MappingQoR", py::call_guard<py::gil_scoped_release>());
+
+    py::class_<PROJECT_NAMESPACE::SweepRow>(m, "SweepRow")
+        .def_readonly("command", &PROJECT_NAMESPACE::SweepRow::command, "The ABC command of the point")
+        .def_readonly("success", &PROJECT_NAMESPACE::SweepRow::success)
+        .def_readonly("timedOut", &PROJECT_NAMESPACE::SweepRow::timedOut, "Whether the point was killed at the timeout")
+        .def_readonly("cached", &PROJECT_NAMESPACE::SweepRow::cached, "Whether the row came from the cache")
+        .def_readonly("numAnd", &PROJECT_NAMESPACE::SweepRow::numAnd)
+        .def_readonly("lev", &PROJECT_NAMESPACE::SweepRow::lev)
+        .def_readonly("runtime", &PROJECT_NAMESPACE::SweepRow::runtime, "Wall time of the command in seconds")
+        .def_property_readonly("hasNetwork", [](const PROJECT_NAMESPACE::SweepRow &row) { return !row.network.empty(); },
+                "Whether the row kept the network of its point");
+
+    py::class_<PROJECT_NAMESPACE::ParamSweep>(m, "ParamSweep")
+        .def(py::init<>())
+        .def("addResub", &PROJECT_NAMESPACE::ParamSweep::addResub, "Add a resub point per combination. -1 for no -K or -N flag",
+                py::arg("ks") = std::vector<PROJECT_NAMESPACE::IntType>{-1}, py::arg("ns") = std::vector<PROJECT_NAMESPACE::IntType>{-1},
+                py::arg("ls") = std::vector<bool>{false}, py::arg("zs") = std::vector<bool>{false})
+        .def("addRefactor", &PROJECT_NAMESPACE::ParamSweep::addRefactor, "Add a refactor point per combination. -1 for no -N flag",
+                py::arg("ns") = std::vector<PROJECT_NAMESPACE::IntType>{-1}, py::arg("ls") = std::vector<bool>{false}, py::arg("zs") = std::vector<bool>{false})
+        .def("addRewrite", &PROJECT_NAMESPACE::ParamSweep::addRewrite, "Add a rewrite point per combination",
+                py::arg("ls") = std::vector<bool>{false}, py::arg("zs") = std::vector<bool>{false})
+        .def("addBalance", &PROJECT_NAMESPACE::ParamSweep::addBalance, "Add a balance point per value of -l", py::arg("ls") = std::vector<bool>{false})
+        .def("addCommand", &PROJECT_NAMESPACE::ParamSweep::addCommand, "Add a point of any ABC command or script", py::arg("cmd"))
+        .def("clearGrid", &PROJECT_NAMESPACE::ParamSweep::clearGrid, "Drop the points")
+        .def("commands", &PROJECT_NAMESPACE::ParamSweep::commands, "The command of each point")
+        .def("setNumWorkers", &PROJECT_NAMESPACE::ParamSweep::setNumWorkers, "The largest number of points running at once")
+        .def("setTimeout", &PROJECT_NAMESPACE::ParamSweep::setTimeout, "The time budget of each point in seconds. 0 for none")
+        .def("setKeepNetworks", &PROJECT_NAMESPACE::ParamSweep::setKeepNetworks,
+                "Keep the network each successful point left in its row, for AbcInterface.takeSweepRow", py::arg("keepNetworks"))
+        .def("keepNetworks", &PROJECT_NAMESPACE::ParamSweep::keepNetworks, "Whether the rows keep the networks of their points")
+        .def("cacheSize", &PROJECT_NAMESPACE::ParamSweep::cacheSize, "The number of cached rows")
+        .def("clearCache", &PROJECT_NAMESPACE::ParamSweep::clearCache, "Drop the cached rows")
+        .def_static("paretoFront", &PROJECT_NAMESPACE::ParamSweep::paretoFront,
+                "The indices of the successful rows no other row beats in numAnd, lev and runtime at once", py::arg("rows"))
+        .def_static("table",
+                [](const std::vector<PROJECT_NAMESPACE::SweepRow> &rows)
+                {
+                    std::vector<PROJECT_NAMESPACE::RealType> table;
+                    for (const auto &row : rows)
+                    {
+                        table.insert(table.end(), { static_cast<PROJECT_NAMESPACE::RealType>(row.numAnd), static_cast<PROJECT_NAMESPACE::RealType>(row.lev), row.runtime });
+                    }
+                    return toNumpy(table, rows.size(), 3);
+                },
+                "The rows as a numRows x 3 array of (numAnd, lev, runtime). Failed rows have -1 for numAnd and lev", py::arg("rows"));
+
+    py::class_<PROJECT_NAMESPACE::StepResult>(m, "StepResult")
+        .def(py::init<>())
+        .def_property_readonly("success", &PROJECT_NAMESPACE::StepResult::success)
+        .def_property_readonly("numAndBefore", &PROJECT_NAMESPACE::StepResult::numAndBefore)
+        .def_property_readonly("numAndAfter", &PROJECT_NAMESPACE::StepResult::numAndAfter)
+        .def_property_readonly("levBefore", &PROJECT_NAMESPACE::StepResult::levBefore)
+        .def_property_readonly("levAfter", &PROJECT_NAMESPACE::StepResult::levAfter)
+        .def_property_readonly("deltaAnd", &PROJECT_NAMESPACE::StepResult::deltaAnd)
+        .def_property_readonly("deltaLev", &PROJECT_NAMESPACE::StepResult::deltaLev)
+        .def_property_readonly("runtime", &PROJECT_NAMESPACE::StepResult::runtime, "Wall time in seconds")
+        .def_property_readonly("numCreated", &PROJECT_NAMESPACE::StepResult::numCreated, "AND nodes created. -1 without step tracking")
+        .def_property_readonly("numRemoved", &PROJECT_NAMESPACE::StepResult::numRemoved, "AND nodes removed. -1 without step tracking")
+        .def_property_readonly("timedOut", &PROJECT_NAMESPACE::StepResult::timedOut, "Whether the action ran out of its time budget");
 
     py::class_<PROJECT_NAMESPACE::AigStats>(m , "AigStats")
         .def(py::init<>())
@@ -37,7 +302,18 @@ void initAbcInterfaceAPI(py::module &m)
         .def_property("numOut", &PROJECT_NAMESPACE::AigStats::numOut, &PROJECT_NAMESPACE::AigStats::setNumOut)
         .def_property("numLat", &PROJECT_NAMESPACE::AigStats::numLat, &PROJECT_NAMESPACE::AigStats::setNumLat)
         .def_property("numAnd", &PROJECT_NAMESPACE::AigStats::numAnd, &PROJECT_NAMESPACE::AigStats::setNumAnd)
-        .def_property("lev", &PROJECT_NAMESPACE::AigStats::lev, &PROJECT_NAMESPACE::AigStats::setLev);
+        .def_property("lev", &PROJECT_NAMESPACE::AigStats::lev, &PROJECT_NAMESPACE::AigStats::setLev)
+        .def(py::pickle(
+                [](const PROJECT_NAMESPACE::AigStats &stats) { return py::bytes(PROJECT_NAMESPACE::AigCheckpoint::encodeStats(stats)); },
+                [](py::bytes state)
+                {
+                    PROJECT_NAMESPACE::AigStats stats;
+                    if (!PROJECT_NAMESPACE::AigCheckpoint::decodeStats(state, stats))
+                    {
+                        throw std::runtime_error("Cannot restore the AigStats from the pickled checkpoint");
+                    }
+                    return stats;
+                }));
 
     py::class_<PROJECT_NAMESPACE::AigNode>(m, "AigNode")
         .def(py::init<>())
@@ -46,7 +322,28 @@ void initAbcInterfaceAPI(py::module &m)
         .def("hasFanin1", &PROJECT_NAMESPACE::AigNode::hasFanin1, "Whether the node has fanin1")
         .def("fanin1", &PROJECT_NAMESPACE::AigNode::fanin1, "The node index of fanin 1")
         .def("nodeType", &PROJECT_NAMESPACE::AigNode::nodeType, "The node type. 0: const 1, 1: PO, 2: PI, 3: a and b, 4: not a and b, 5: not a and not b, 6 unknown")
+        .def("isValid", &PROJECT_NAMESPACE::AigNode::isValid, "Whether the node is configured. False for the slot of a deleted object")
+        .def("level", &PROJECT_NAMESPACE::AigNode::level, "The logic level")
         .def("numFanouts", &PROJECT_NAMESPACE::AigNode::numFanouts, "The number of fanouts")
-        .def("fanout", &PROJECT_NAMESPACE::AigNode::fanout, "A fanout node");
+        .def("fanout", &PROJECT_NAMESPACE::AigNode::fanout, "A fanout node")
+        .def("fanouts",
+                [](const PROJECT_NAMESPACE::AigNode &node)
+                {
+                    PROJECT_NAMESPACE::FanoutRange range = node.fanouts();
+                    return std::vector<PROJECT_NAMESPACE::IntType>(range.begin(), range.end());
+                },
+                "All the fanout nodes. Sorted if packed")
+        .def("isFanoutPacked", &PROJECT_NAMESPACE::AigNode::isFanoutPacked, "Whether the fanouts are packed")
+        .def(py::pickle(
+                [](const PROJECT_NAMESPACE::AigNode &node) { return py::bytes(PROJECT_NAMESPACE::AigCheckpoint::encodeNode(node)); },
+                [](py::bytes state)
+                {
+                    PROJECT_NAMESPACE::AigNode node;
+                    if (!PROJECT_NAMESPACE::AigCheckpoint::decodeNode(state, node))
+                    {
+                        throw std::runtime_error("Cannot restore the AigNode from the pickled checkpoint");
+                    }
+                    return node;
+                }));
 
 }
@@ -0,0 +1,200 @@
+/**
+ * @file AsyncAPI.cpp
+ * @brief The Python interface for the asyncio executor of AbcInterface environments
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include "NumpyHelper.h"
+#include <unordered_map>
+#include <pybind11/stl.h>
+#include "interface/AbcExecutor.h"
+
+/// @class PyAsyncExecutor
+/// @brief Bridge the AbcExecutor to asyncio. Each call returns an asyncio future,
+/// resolved when the event loop sees the event fd of the executor become readable
+class PyAsyncExecutor
+{
+    public:
+        explicit PyAsyncExecutor() = default;
+        ~PyAsyncExecutor() { this->close(); }
+        /// @brief submit a call and get its future
+        py::object submit(PROJECT_NAMESPACE::IntType env, PROJECT_NAMESPACE::AsyncOp op,
+                const std::vector<PROJECT_NAMESPACE::IntType> &args = std::vector<PROJECT_NAMESPACE::IntType>(), const std::string &text = "")
+        {
+            this->watch();
+            py::object future = _loop.attr("create_future")();
+            std::uint64_t ticket = _executor.submit(env, op, args, text);
+            if (ticket == 0)
+            {
+                future.attr("set_exception")(py::module::import("builtins").attr("RuntimeError")("The environment is not open"));
+                return future;
+            }
+            _futures[ticket] = future;
+            return future;
+        }
+        /// @brief resolve the futures of the completions available
+        void dispatch()
+        {
+            for (auto &completion : _executor.drain())
+            {
+                auto iter = _futures.find(completion.ticket);
+                if (iter == _futures.end())
+                {
+                    continue;
+                }
+                py::object future = iter->second;
+                _futures.erase(iter);
+                if (future.attr("done")().cast<bool>())
+                {
+                    continue;
+                }
+                py::object result = this->decode(completion);
+                if (result.is_none())
+                {
+                    future.attr("set_exception")(py::module::import("builtins").attr("RuntimeError")("The call failed or its worker died"));
+                }
+                else
+                {
+                    future.attr("set_result")(result);
+                }
+            }
+        }
+        /// @brief stop watching the event fd. The futures not resolved are cancelled, or dropped if their loop is closed
+        void close()
+        {
+            if (_loop.is_none())
+            {
+                return;
+            }
+            // A closed loop cannot schedule the callbacks of a cancellation, and its futures can no longer be awaited
+            bool closed = _loop.attr("is_closed")().cast<bool>();
+            _loop.attr("remove_reader")(_executor.eventFd());
+            for (auto &pair : _futures)
+            {
+                if (!closed)
+                {
+                    pair.second.attr("cancel")();
+                }
+            }
+            _futures.clear();
+            _loop = py::none();
+        }
+        PROJECT_NAMESPACE::AbcExecutor & executor() { return _executor; }
+    private:
+        /// @brief watch the event fd from the current event loop. Resolved on every call, since each asyncio.run()
+        /// brings a new loop; the watch moves to it and the futures of the old loop are dropped
+        void watch()
+        {
+            py::object loop = py::module::import("asyncio").attr("get_event_loop")();
+            if (loop.is(_loop))
+            {
+                return;
+            }
+            this->close();
+            _loop = loop;
+            _loop.attr("add_reader")(_executor.eventFd(), py::cpp_function([this]() { this->dispatch(); }));
+        }
+        /// @brief the Python result of a completion. None if it failed
+        py::object decode(const PROJECT_NAMESPACE::AsyncCompletion &completion)
+        {
+            switch (completion.op)
+            {
+                case PROJECT_NAMESPACE::AsyncOp::READ:
+                    return py::cast(completion.success);
+                case PROJECT_NAMESPACE::AsyncOp::AIG_STATS:
+                    return completion.success ? py::cast(PROJECT_NAMESPACE::AbcExecutor::decodeStats(completion.payload)) : py::none();
+                case PROJECT_NAMESPACE::AsyncOp::GRAPH:
+                {
+                    std::vector<PROJECT_NAMESPACE::IntType> nodeTypes, levels, edgeSrc, edgeDst;
+                    if (!completion.success || !PROJECT_NAMESPACE::AbcExecutor::decodeGraph(completion.payload, nodeTypes, levels, edgeSrc, edgeDst))
+                    {
+                        return py::none();
+                    }
+                    py::dict graph;
+                    graph["nodeTypes"] = toNumpy(nodeTypes);
+                    graph["levels"] = toNumpy(levels);
+                    graph["edgeSrc"] = toNumpy(edgeSrc);
+                    graph["edgeDst"] = toNumpy(edgeDst);
+                    return graph;
+                }
+                case PROJECT_NAMESPACE::AsyncOp::METRICS:
+                {
+                    std::string text;
+                    if (!completion.success || !PROJECT_NAMESPACE::AbcExecutor::decodeMetrics(completion.payload, text))
+                    {
+                        return py::none();
+                    }
+                    return py::cast(text);
+                }
+                default:
+                    // A failed action still reports its step. An empty payload means the worker died
+                    if (completion.payload.empty())
+                    {
+                        return py::none();
+                    }
+                    return py::cast(PROJECT_NAMESPACE::AbcExecutor::decodeStep(completion.payload));
+            }
+        }
+    private:
+        PROJECT_NAMESPACE::AbcExecutor _executor; ///< The workers
+        py::object _loop = py::none(); ///< The event loop watching the event fd
+        std::unordered_map<std::uint64_t, py::object> _futures; ///< The futures by ticket
+};
+
+void initAsyncAPI(py::module &m)
+{
+    using PROJECT_NAMESPACE::AsyncOp;
+    using PROJECT_NAMESPACE::IntType;
+    py::class_<PyAsyncExecutor>(m, "AsyncExecutor")
+        .def(py::init<>())
+        .def("createEnv", [](PyAsyncExecutor &ex) { return ex.executor().createEnv(); },
+                "Start an environment in a new worker process. Returns its id, -1 on failure")
+        .def("closeEnv", [](PyAsyncExecutor &ex, IntType env) { ex.executor().closeEnv(env); },
+                "Close an environment once its submitted calls are done")
+        .def("isAlive", [](PyAsyncExecutor &ex, IntType env) { return ex.executor().isAlive(env); },
+                "Whether the environment is open and its worker is alive")
+        .def("read", [](PyAsyncExecutor &ex, IntType env, const std::string &filename) { return ex.submit(env, AsyncOp::READ, {}, filename); },
+                "Read a file. Resolves to whether it succeeded", py::arg("env"), py::arg("filename"))
+        .def("balance", [](PyAsyncExecutor &ex, IntType env, bool l, bool d, bool s, bool x)
+                { return ex.submit(env, AsyncOp::BALANCE, {l, d, s, x}); },
+                "balance action. Resolves to the StepResult",
+                py::arg("env"), py::arg("l") = false, py::arg("d") = false, py::arg("s") = false, py::arg("x") = false)
+        .def("resub", [](PyAsyncExecutor &ex, IntType env, IntType k, IntType n, IntType f, bool l, bool z)
+                { return ex.submit(env, AsyncOp::RESUB, {k, n, f, l, z}); },
+                "resub action. Resolves to the StepResult",
+                py::arg("env"), py::arg("k") = -1, py::arg("n") = -1, py::arg("f") = -1, py::arg("l") = false, py::arg("z") = false)
+        .def("rewrite", [](PyAsyncExecutor &ex, IntType env, bool l, bool z) { return ex.submit(env, AsyncOp::REWRITE, {l, z}); },
+                "rewrite action. Resolves to the StepResult", py::arg("env"), py::arg("l") = false, py::arg("z") = false)
+        .def("refactor", [](PyAsyncExecutor &ex, IntType env, IntType n, bool l, bool z) { return ex.submit(env, AsyncOp::REFACTOR, {n, l, z}); },
+                "refactor action. Resolves to the StepResult", py::arg("env"), py::arg("n") = -1, py::arg("l") = false, py::arg("z") = false)
+        .def("compress2rs", [](PyAsyncExecutor &ex, IntType env) { return ex.submit(env, AsyncOp::COMPRESS2RS); },
+                "compress2rs baseline. Resolves to the StepResult", py::arg("env"))
+        .def("takeAction", [](PyAsyncExecutor &ex, IntType env, IntType action) { return ex.submit(env, AsyncOp::ACTION, {action}); },
+                "Take an AbcAction. Resolves to the StepResult", py::arg("env"), py::arg("action"))
+        .def("giaBalance", [](PyAsyncExecutor &ex, IntType env, bool d) { return ex.submit(env, AsyncOp::GIA_BALANCE, {d}); },
+                "&b action. Resolves to the StepResult", py::arg("env"), py::arg("d") = false)
+        .def("giaSyn2", [](PyAsyncExecutor &ex, IntType env)
+                { return ex.submit(env, AsyncOp::GIA_ACTION, {static_cast<IntType>(PROJECT_NAMESPACE::GiaAction::SYN2)}); },
+                "&syn2 action. Resolves to the StepResult", py::arg("env"))
+        .def("giaDc2", [](PyAsyncExecutor &ex, IntType env)
+                { return ex.submit(env, AsyncOp::GIA_ACTION, {static_cast<IntType>(PROJECT_NAMESPACE::GiaAction::DC2)}); },
+                "&dc2 action. Resolves to the StepResult", py::arg("env"))
+        .def("giaDch", [](PyAsyncExecutor &ex, IntType env)
+                { return ex.submit(env, AsyncOp::GIA_ACTION, {static_cast<IntType>(PROJECT_NAMESPACE::GiaAction::DCH)}); },
+                "&dch action. Resolves to the StepResult", py::arg("env"))
+        .def("takeGiaAction", [](PyAsyncExecutor &ex, IntType env, IntType action) { return ex.submit(env, AsyncOp::GIA_ACTION, {action}); },
+                "Take a GiaAction. Resolves to the StepResult", py::arg("env"), py::arg("action"))
+        .def("aigStats", [](PyAsyncExecutor &ex, IntType env) { return ex.submit(env, AsyncOp::AIG_STATS); },
+                "Resolves to the AigStats", py::arg("env"))
+        .def("graph", [](PyAsyncExecutor &ex, IntType env) { return ex.submit(env, AsyncOp::GRAPH); },
+                "Update the graph and resolve to a dict of the arrays nodeTypes, levels, edgeSrc and edgeDst", py::arg("env"))
+        .def("metrics", [](PyAsyncExecutor &ex, IntType env, PROJECT_NAMESPACE::MetricsFormat format)
+                { return ex.submit(env, AsyncOp::METRICS, {static_cast<IntType>(format)}); },
+                "Resolves to the metrics of the worker process of the environment, labelled by its own worker", py::arg("env"),
+                py::arg("format") = PROJECT_NAMESPACE::MetricsFormat::JSON)
+        .def("eventFd", [](PyAsyncExecutor &ex) { return ex.executor().eventFd(); }, "The fd that becomes readable on completions")
+        .def("dispatch", &PyAsyncExecutor::dispatch, "Resolve the futures of the completions available. Called by the event loop")
+        .def("numPending", [](PyAsyncExecutor &ex) { return ex.executor().numPending(); }, "The number of calls not completed")
+        .def("close", &PyAsyncExecutor::close, "Stop watching the event fd and cancel the futures not resolved");
+}
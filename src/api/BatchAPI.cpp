@@ -0,0 +1,36 @@
+/**
+ * @file BatchAPI.cpp
+ * @brief The Python interface for the batched stepping of many designs
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "interface/BatchStepper.h"
+
+namespace py = pybind11;
+
+void initBatchAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::BatchCompletion>(m, "BatchCompletion")
+        .def_readonly("stepId", &PROJECT_NAMESPACE::BatchCompletion::stepId)
+        .def_readonly("slot", &PROJECT_NAMESPACE::BatchCompletion::slot)
+        .def_readonly("action", &PROJECT_NAMESPACE::BatchCompletion::action)
+        .def_readonly("success", &PROJECT_NAMESPACE::BatchCompletion::success)
+        .def_readonly("step", &PROJECT_NAMESPACE::BatchCompletion::step, "The StepResult of the action");
+
+    py::class_<PROJECT_NAMESPACE::BatchStepper>(m, "BatchStepper")
+        .def(py::init<PROJECT_NAMESPACE::IntType, const std::string &>(),
+                "Start the worker processes. Networks migrating between workers are spilled to spillDir",
+                py::arg("numWorkers") = 4, py::arg("spillDir") = "/tmp")
+        .def("addSlot", &PROJECT_NAMESPACE::BatchStepper::addSlot, "Add a design and get its slot", py::arg("design"))
+        .def("step", &PROJECT_NAMESPACE::BatchStepper::step, "Queue an AbcAction of a slot and get the step id", py::arg("slot"), py::arg("action"))
+        .def("stepBatch", &PROJECT_NAMESPACE::BatchStepper::stepBatch,
+                "Queue a list of (slot, action) pairs and get their step ids", py::arg("steps"))
+        .def("wait", &PROJECT_NAMESPACE::BatchStepper::wait, py::call_guard<py::gil_scoped_release>(),
+                "Wait for completions, as they come. Empty on timeout or when nothing is queued", py::arg("timeout") = -1.0)
+        .def("numPending", &PROJECT_NAMESPACE::BatchStepper::numPending, "The number of steps queued or running")
+        .def("slotFailed", &PROJECT_NAMESPACE::BatchStepper::slotFailed, "Whether a slot lost its network", py::arg("slot"))
+        .def("numSlots", &PROJECT_NAMESPACE::BatchStepper::numSlots);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file DatasetAPI.cpp
+ * @brief The Python interface for the dataset pipeline
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "interface/DatasetPipeline.h"
+
+namespace py = pybind11;
+
+void initDatasetAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::PipelineStats>(m, "PipelineStats")
+        .def_readonly("numDesigns", &PROJECT_NAMESPACE::PipelineStats::numDesigns)
+        .def_readonly("numDone", &PROJECT_NAMESPACE::PipelineStats::numDone, "The designs recorded in this run")
+        .def_readonly("numFailed", &PROJECT_NAMESPACE::PipelineStats::numFailed, "The designs failed in this run")
+        .def_readonly("numSkipped", &PROJECT_NAMESPACE::PipelineStats::numSkipped, "The designs already done by an earlier run")
+        .def_readonly("elapsed", &PROJECT_NAMESPACE::PipelineStats::elapsed)
+        .def_readonly("designsPerSec", &PROJECT_NAMESPACE::PipelineStats::designsPerSec);
+
+    py::class_<PROJECT_NAMESPACE::DatasetPipeline>(m, "DatasetPipeline")
+        .def(py::init([](const std::vector<std::string> &designs, const std::string &prefix, PROJECT_NAMESPACE::IntType numWorkers)
+                {
+                    auto pipeline = new PROJECT_NAMESPACE::DatasetPipeline();
+                    pipeline->setDesigns(designs);
+                    pipeline->setOutputPrefix(prefix);
+                    pipeline->setNumWorkers(numWorkers);
+                    return pipeline;
+                }),
+                "Record the trajectories of the designs into shards <prefix>-NNNNN.abctrj, with the progress in <prefix>.manifest",
+                py::arg("designs"), py::arg("prefix"), py::arg("numWorkers") = 4)
+        .def("setQueueSize", &PROJECT_NAMESPACE::DatasetPipeline::setQueueSize, "The capacity of the queues between the stages", py::arg("queueSize"))
+        .def("setNumSteps", &PROJECT_NAMESPACE::DatasetPipeline::setNumSteps, "The number of random actions of each design", py::arg("numSteps"))
+        .def("setRandomSeed", &PROJECT_NAMESPACE::DatasetPipeline::setRandomSeed, "The seed of the random actions", py::arg("seed"))
+        .def("setScript", &PROJECT_NAMESPACE::DatasetPipeline::setScript,
+                "A fixed sequence of AbcAction values run on every design instead of random actions", py::arg("script"))
+        .def("setShardBytes", &PROJECT_NAMESPACE::DatasetPipeline::setShardBytes, "The size after which a shard is closed", py::arg("shardBytes"))
+        .def("setCompressionLevel", &PROJECT_NAMESPACE::DatasetPipeline::setCompressionLevel, "The zlib level of the trajectories", py::arg("level"))
+        .def("run", &PROJECT_NAMESPACE::DatasetPipeline::run, py::call_guard<py::gil_scoped_release>(),
+                "Run until all the designs are done or stop is called. Resumes from the manifest of an earlier run")
+        .def("stop", &PROJECT_NAMESPACE::DatasetPipeline::stop, "Stop taking new designs. The running ones are finished and committed")
+        .def("stats", &PROJECT_NAMESPACE::DatasetPipeline::stats, "The progress and the throughput");
+}
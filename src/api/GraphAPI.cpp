@@ -0,0 +1,306 @@
+/**
+ * @file GraphAPI.cpp
+ * @brief The Python interface for the analyses over the mirrored AIG graph
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include "NumpyHelper.h"
+#include <pybind11/stl.h>
+#include "graph/AigLevelPartition.h"
+#include "graph/AigSampler.h"
+#include "graph/AigMffc.h"
+#include "graph/AigCutEnum.h"
+#include "graph/AigSimulator.h"
+#include "graph/AigTensors.h"
+#include "graph/AigGraphDiff.h"
+#include "interface/AbcInterface.h"
+#include "interface/FanoutBenchmark.h"
+#include "util/AccessPolicy.h"
+
+/// @class PyAigTensors
+/// @brief An AigTensors snapshot with the interface it was taken from, to tell whether it is stale. The snapshot is
+/// tagged with the generation of the mirror rather than the current one, so it is stale as soon as taken when an
+/// action has run since the last updateGraph()
+class PyAigTensors
+{
+    public:
+        explicit PyAigTensors(py::object abc) : _abc(abc)
+        {
+            const auto &interface = abc.cast<const PROJECT_NAMESPACE::AbcInterface &>();
+            _tensors.build(interface.aigNodes(), interface.mirrorGeneration());
+        }
+        /// @brief the snapshot
+        const PROJECT_NAMESPACE::AigTensors & tensors() const { return _tensors; }
+        /// @brief whether the mirror has moved on since the snapshot
+        bool isStale() const { return _abc.cast<const PROJECT_NAMESPACE::AbcInterface &>().graphGeneration() != _tensors.generation(); }
+    private:
+        py::object _abc; ///< The AbcInterface, kept alive for the generation check
+        PROJECT_NAMESPACE::AigTensors _tensors; ///< The snapshot
+};
+
+/// @class PyGraphTensor
+/// @brief One tensor of a PyAigTensors, exported through DLPack without a copy. The NumPy view over the buffer of
+/// the snapshot keeps the snapshot alive and provides the capsule; __dlpack__ refuses once the snapshot is stale
+class PyGraphTensor
+{
+    public:
+        explicit PyGraphTensor(py::array view, py::object owner) : _view(view), _owner(owner) {}
+        /// @brief whether the mirror has moved on since the snapshot
+        bool isStale() const { return _owner.cast<const PyAigTensors &>().isStale(); }
+        /// @brief the DLPack capsule of the buffer
+        py::object dlpack(py::args args, py::kwargs kwargs) const
+        {
+            if (this->isStale())
+            {
+                throw std::runtime_error("The graph tensor is stale: the mirror has been updated or an action taken since it was exported");
+            }
+            return _view.attr("__dlpack__")(*args, **kwargs);
+        }
+        /// @brief the DLPack device of the buffer
+        py::object dlpackDevice() const { return _view.attr("__dlpack_device__")(); }
+        /// @brief the NumPy view over the buffer
+        py::array numpy() const { return _view; }
+    private:
+        py::array _view; ///< The view over the buffer of the snapshot
+        py::object _owner; ///< The PyAigTensors holding the buffer
+};
+
+/// @brief a DLPack tensor over a buffer of the snapshot held by an owner
+template<typename T>
+static PyGraphTensor graphTensor(py::object owner, const std::vector<T> &buffer, std::vector<py::ssize_t> shape)
+{
+    // The owner is the base of the view, so the buffer lives as long as any view or tensor made from it
+    return PyGraphTensor(py::array_t<T>(shape, buffer.data(), owner), owner);
+}
+
+void initGraphAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::AigLevelPartition>(m, "AigLevelPartition")
+        .def(py::init<>())
+        .def("numLevels", &PROJECT_NAMESPACE::AigLevelPartition::numLevels, "The number of levels. CONST1 and PIs are in level 0, POs in the last level")
+        .def("nodeOrder", [](const PROJECT_NAMESPACE::AigLevelPartition &p) { return toNumpy(p.nodeOrder()); },
+                "Node indices sorted by level")
+        .def("levelOffsets", [](const PROJECT_NAMESPACE::AigLevelPartition &p) { return toNumpy(p.levelOffsets()); },
+                "Level l is nodeOrder[levelOffsets[l]:levelOffsets[l+1]]")
+        .def("edgeOffsets", [](const PROJECT_NAMESPACE::AigLevelPartition &p) { return toNumpy(p.edgeOffsets()); },
+                "The edges into level l are edgeSrc/edgeDst[edgeOffsets[l]:edgeOffsets[l+1]]")
+        .def("edgeSrc", [](const PROJECT_NAMESPACE::AigLevelPartition &p) { return toNumpy(p.edgeSrc()); },
+                "The fanin node of each edge")
+        .def("edgeDst", [](const PROJECT_NAMESPACE::AigLevelPartition &p) { return toNumpy(p.edgeDst()); },
+                "The sink node of each edge")
+        .def("nodeLevels", [](const PROJECT_NAMESPACE::AigLevelPartition &p) { return toNumpy(p.nodeLevels()); },
+                "The partition level of each node");
+
+    py::class_<PROJECT_NAMESPACE::AigGraphDiff>(m, "AigGraphDiff")
+        .def(py::init<>())
+        .def("oldToNew", [](const PROJECT_NAMESPACE::AigGraphDiff &d) { return toNumpy(d.oldToNew()); },
+                "The new index of each old node. -1 if removed or an empty slot")
+        .def("newToOld", [](const PROJECT_NAMESPACE::AigGraphDiff &d) { return toNumpy(d.newToOld()); },
+                "The old index of each new node. -1 if created or an empty slot")
+        .def("created", [](const PROJECT_NAMESPACE::AigGraphDiff &d) { return toNumpy(d.created()); },
+                "The new nodes without an old counterpart")
+        .def("removed", [](const PROJECT_NAMESPACE::AigGraphDiff &d) { return toNumpy(d.removed()); },
+                "The old nodes without a new counterpart")
+        .def("fromGeneration", &PROJECT_NAMESPACE::AigGraphDiff::fromGeneration, "The generation of the old mirror")
+        .def("toGeneration", &PROJECT_NAMESPACE::AigGraphDiff::toGeneration, "The generation of the new mirror");
+
+    py::enum_<PROJECT_NAMESPACE::SampleDirection>(m, "SampleDirection")
+        .value("FANIN", PROJECT_NAMESPACE::SampleDirection::FANIN)
+        .value("FANOUT", PROJECT_NAMESPACE::SampleDirection::FANOUT)
+        .value("BOTH", PROJECT_NAMESPACE::SampleDirection::BOTH);
+
+    py::class_<PROJECT_NAMESPACE::AigSampledBatch>(m, "AigSampledBatch")
+        .def_property_readonly("nodeOffsets", [](const PROJECT_NAMESPACE::AigSampledBatch &b) { return toNumpy(b.nodeOffsets); },
+                "Subgraph s has nodes[nodeOffsets[s]:nodeOffsets[s+1]]")
+        .def_property_readonly("nodes", [](const PROJECT_NAMESPACE::AigSampledBatch &b) { return toNumpy(b.nodes); },
+                "The original node indices. Local id i of subgraph s is nodes[nodeOffsets[s] + i], the seed is local id 0")
+        .def_property_readonly("nodeHops", [](const PROJECT_NAMESPACE::AigSampledBatch &b) { return toNumpy(b.nodeHops); },
+                "The hop at which each node is reached")
+        .def_property_readonly("edgeOffsets", [](const PROJECT_NAMESPACE::AigSampledBatch &b) { return toNumpy(b.edgeOffsets); },
+                "Subgraph s has edges edgeSrc/edgeDst[edgeOffsets[s]:edgeOffsets[s+1]]")
+        .def_property_readonly("edgeSrc", [](const PROJECT_NAMESPACE::AigSampledBatch &b) { return toNumpy(b.edgeSrc); },
+                "The local id of the fanin side of each edge")
+        .def_property_readonly("edgeDst", [](const PROJECT_NAMESPACE::AigSampledBatch &b) { return toNumpy(b.edgeDst); },
+                "The local id of the fanout side of each edge");
+
+    py::class_<PROJECT_NAMESPACE::AigSampler>(m, "AigSampler")
+        .def(py::init([](const PROJECT_NAMESPACE::AbcInterface &abc) { return new PROJECT_NAMESPACE::AigSampler(abc.aigNodes()); }),
+                "Sampler over the mirrored graph of an AbcInterface", py::keep_alive<1, 2>())
+        .def("setFanouts", &PROJECT_NAMESPACE::AigSampler::setFanouts, "The number of neighbours sampled per node at each hop. -1 for all")
+        .def("setDirection", &PROJECT_NAMESPACE::AigSampler::setDirection, "The direction to expand")
+        .def("setRandomSeed", &PROJECT_NAMESPACE::AigSampler::setRandomSeed, "The random seed")
+        .def("setNumThreads", &PROJECT_NAMESPACE::AigSampler::setNumThreads, "The number of threads. 0 for the OpenMP default")
+        .def("sample",
+                [](const PROJECT_NAMESPACE::AigSampler &sampler, const std::vector<PROJECT_NAMESPACE::IntType> &seeds)
+                {
+                    // The seeds come from Python, so they are checked whatever the access policy of the mirror
+                    for (PROJECT_NAMESPACE::IntType seed : seeds)
+                    {
+                        PROJECT_NAMESPACE::CheckedAccess::checkRange(seed, sampler.numNodes(), "seed");
+                    }
+                    py::gil_scoped_release release;
+                    return sampler.sample(seeds);
+                },
+                "Sample the neighbourhood of each seed node. Raises IndexError for a seed out of range", py::arg("seeds"));
+
+    py::class_<PROJECT_NAMESPACE::AigMffc>(m, "AigMffc")
+        .def(py::init<>())
+        .def("build", [](PROJECT_NAMESPACE::AigMffc &mffc, const PROJECT_NAMESPACE::AbcInterface &abc) { mffc.build(abc.aigNodes()); },
+                "Compute the MFFCs of the mirrored graph of an AbcInterface", py::call_guard<py::gil_scoped_release>())
+        .def("mffcSizes", [](const PROJECT_NAMESPACE::AigMffc &mffc) { return toNumpy(mffc.mffcSizes()); },
+                "The number of AND nodes in the MFFC of each node")
+        .def("dominators", [](const PROJECT_NAMESPACE::AigMffc &mffc) { return toNumpy(mffc.dominators()); },
+                "The immediate fanout dominator of each node, i.e. its parent in the cluster hierarchy. -1 for none")
+        .def("depths", [](const PROJECT_NAMESPACE::AigMffc &mffc) { return toNumpy(mffc.depths()); },
+                "The depth of each node in the cluster hierarchy")
+        .def("coneIds", [](const PROJECT_NAMESPACE::AigMffc &mffc) { return toNumpy(mffc.coneIds()); },
+                "The maximal cone of each AND node as a dense id. -1 for the other nodes")
+        .def("coneRoots", [](const PROJECT_NAMESPACE::AigMffc &mffc) { return toNumpy(mffc.coneRoots()); },
+                "The root node of each maximal cone")
+        .def("numCones", &PROJECT_NAMESPACE::AigMffc::numCones, "The number of maximal cones");
+
+    py::class_<PROJECT_NAMESPACE::AigCutEnum>(m, "AigCutEnum")
+        .def(py::init<>())
+        .def("setCutSize", &PROJECT_NAMESPACE::AigCutEnum::setCutSize, "The largest cut size K, 2 <= K <= 6")
+        .def("setCutLimit", &PROJECT_NAMESPACE::AigCutEnum::setCutLimit, "The number of non-trivial cuts kept per node")
+        .def("setNumThreads", &PROJECT_NAMESPACE::AigCutEnum::setNumThreads, "The number of threads. 0 for the OpenMP default")
+        .def("build", [](PROJECT_NAMESPACE::AigCutEnum &cuts, const PROJECT_NAMESPACE::AbcInterface &abc) { cuts.build(abc.aigNodes()); },
+                "Enumerate the cuts of the mirrored graph of an AbcInterface", py::call_guard<py::gil_scoped_release>())
+        .def("sizeHistogram",
+                [](const PROJECT_NAMESPACE::AigCutEnum &cuts)
+                {
+                    auto hist = cuts.sizeHistogram();
+                    py::ssize_t numCols = cuts.cutSize() + 1;
+                    return toNumpy(hist, hist.size() / numCols, numCols);
+                },
+                "The number of non-trivial cuts of each leaf count of each node, a numNodes x (K + 1) array")
+        .def("cuts",
+                [](const PROJECT_NAMESPACE::AigCutEnum &cuts)
+                {
+                    std::vector<PROJECT_NAMESPACE::IntType> offsets, leaves;
+                    std::vector<PROJECT_NAMESPACE::Truth6> truths;
+                    cuts.exportCuts(offsets, leaves, truths);
+                    return py::make_tuple(toNumpy(offsets), toNumpy(leaves, truths.size(), cuts.cutSize()), toNumpy(truths));
+                },
+                "The non-trivial cuts as (offsets, leaves, truths). The cuts of node n are rows offsets[n]:offsets[n+1]. "
+                "Leaves are padded with -1 and leaf i is variable i of the 64-bit truth table");
+
+    py::class_<PROJECT_NAMESPACE::AigSimulator>(m, "AigSimulator")
+        .def(py::init<>())
+        .def("setNumWords", &PROJECT_NAMESPACE::AigSimulator::setNumWords, "The number of 64-bit words simulated per node, from the next simulation on")
+        .def("setNumThreads", &PROJECT_NAMESPACE::AigSimulator::setNumThreads, "The number of threads. 0 for the OpenMP default")
+        .def("setRandomSeed", &PROJECT_NAMESPACE::AigSimulator::setRandomSeed, "The random seed of the random patterns")
+        .def("simulateRandom",
+                [](PROJECT_NAMESPACE::AigSimulator &sim, const PROJECT_NAMESPACE::AbcInterface &abc) { sim.simulateRandom(abc.aigNodes()); },
+                "Simulate random patterns on the mirrored graph of an AbcInterface", py::call_guard<py::gil_scoped_release>())
+        .def("simulate",
+                [](PROJECT_NAMESPACE::AigSimulator &sim, const PROJECT_NAMESPACE::AbcInterface &abc,
+                    py::array_t<std::uint64_t, py::array::c_style | py::array::forcecast> patterns)
+                {
+                    if (patterns.ndim() != 2)
+                    {
+                        throw py::value_error("patterns must be a numPIs x numWords array");
+                    }
+                    sim.setNumWords(patterns.shape(1));
+                    std::vector<std::uint64_t> words(patterns.data(), patterns.data() + patterns.size());
+                    py::gil_scoped_release release;
+                    return sim.simulate(abc.aigNodes(), words);
+                },
+                "Simulate user patterns, a numPIs x numWords uint64 array with the PIs ordered as piNodes()")
+        .def("computeClasses",
+                [](PROJECT_NAMESPACE::AigSimulator &sim, const PROJECT_NAMESPACE::AbcInterface &abc) { return sim.computeClasses(abc.aigNodes()); },
+                "Group the nodes into candidate equivalence classes, up to complement. False if the graph was not the one simulated",
+                py::call_guard<py::gil_scoped_release>())
+        .def("piNodes", [](const PROJECT_NAMESPACE::AigSimulator &sim) { return toNumpy(sim.piNodes()); },
+                "The PI node indices, in the order of the pattern rows")
+        .def("signatures",
+                [](const PROJECT_NAMESPACE::AigSimulator &sim)
+                {
+                    PROJECT_NAMESPACE::IntType sigWords = std::max(sim.sigWords(), 1);
+                    return toNumpy(sim.signatures(), sim.signatures().size() / sigWords, sim.sigWords());
+                },
+                "The simulation signature of each node, a numNodes x sigWords uint64 array")
+        .def("classIds", [](const PROJECT_NAMESPACE::AigSimulator &sim) { return toNumpy(sim.classIds()); },
+                "The candidate class of each node. -1 if not equivalent to another node")
+        .def("classPhases", [](const PROJECT_NAMESPACE::AigSimulator &sim) { return toNumpy(sim.classPhases()); },
+                "Whether each node is complemented with respect to its class")
+        .def("numClasses", &PROJECT_NAMESPACE::AigSimulator::numClasses, "The number of candidate classes");
+
+    m.def("fanoutCsr",
+            [](PROJECT_NAMESPACE::AbcInterface &abc)
+            {
+                // Plain buffers handed over to NumPy: the arena of the mirror is only reset by updateGraph(), so repeated exports would pile up in it
+                std::vector<PROJECT_NAMESPACE::IntType> offsets, fanouts;
+                PROJECT_NAMESPACE::exportFanouts(abc.aigNodes(), offsets, fanouts);
+                return py::make_tuple(moveToNumpy(std::move(offsets)), moveToNumpy(std::move(fanouts)));
+            },
+            "The fanouts of the mirrored graph in CSR form (offsets, fanouts): those of node i are fanouts[offsets[i]:offsets[i + 1]]",
+            py::arg("abc"));
+
+    py::class_<PROJECT_NAMESPACE::FanoutBenchmark>(m, "FanoutBenchmark")
+        .def_readonly("packed", &PROJECT_NAMESPACE::FanoutBenchmark::packed)
+        .def_readonly("numFanouts", &PROJECT_NAMESPACE::FanoutBenchmark::numFanouts)
+        .def_readonly("fanoutBytes", &PROJECT_NAMESPACE::FanoutBenchmark::fanoutBytes, "The bytes of the fanouts in the arena")
+        .def_readonly("mirrorBytes", &PROJECT_NAMESPACE::FanoutBenchmark::mirrorBytes, "The bytes of the nodes and the fanouts")
+        .def_readonly("buildSeconds", &PROJECT_NAMESPACE::FanoutBenchmark::buildSeconds, "One graph update")
+        .def_readonly("iterateSeconds", &PROJECT_NAMESPACE::FanoutBenchmark::iterateSeconds, "One pass over all the fanouts with the iterators")
+        .def_readonly("indexSeconds", &PROJECT_NAMESPACE::FanoutBenchmark::indexSeconds, "One pass over all the fanouts with fanout(idx)")
+        .def_readonly("exportSeconds", &PROJECT_NAMESPACE::FanoutBenchmark::exportSeconds, "One CSR export of the mirror");
+
+    m.def("benchmarkFanouts", &PROJECT_NAMESPACE::benchmarkFanouts,
+            "Time the plain and the packed fanouts of the current network, best of the rounds. Returns the plain and the packed figures",
+            py::arg("abc"), py::arg("numRounds") = 10);
+
+    py::class_<PyGraphTensor>(m, "GraphTensor")
+        .def("__dlpack__", &PyGraphTensor::dlpack, "The DLPack capsule of the buffer, for torch.from_dlpack. Raises once the tensor is stale")
+        .def("__dlpack_device__", &PyGraphTensor::dlpackDevice, "The DLPack device of the buffer, the CPU")
+        .def("numpy", &PyGraphTensor::numpy, "The NumPy view over the buffer")
+        .def("isStale", &PyGraphTensor::isStale, "Whether the mirror has moved on since the export");
+
+    py::class_<PyAigTensors>(m, "AigTensors")
+        .def_property_readonly("generation", [](const PyAigTensors &t) { return t.tensors().generation(); },
+                "The generation of the mirror the tensors were built from")
+        .def("isStale", &PyAigTensors::isStale, "Whether the mirror has been updated or an action taken since the export")
+        .def_property_readonly("numNodes", [](const PyAigTensors &t) { return t.tensors().numNodes(); })
+        .def_property_readonly("numEdges", [](const PyAigTensors &t) { return t.tensors().numEdges(); })
+        .def_property_readonly("edgeIndex",
+                [](py::object self)
+                {
+                    const auto &t = self.cast<const PyAigTensors &>().tensors();
+                    return graphTensor(self, t.edgeIndex(), {2, t.numEdges()});
+                },
+                "The int64 edge index, 2 x numEdges: the fanins in row 0, the nodes they drive in row 1")
+        .def_property_readonly("edgeCompl",
+                [](py::object self)
+                {
+                    const auto &t = self.cast<const PyAigTensors &>().tensors();
+                    return graphTensor(self, t.edgeCompl(), {t.numEdges()});
+                },
+                "Whether each edge is complemented, uint8")
+        .def_property_readonly("nodeTypes",
+                [](py::object self)
+                {
+                    const auto &t = self.cast<const PyAigTensors &>().tensors();
+                    return graphTensor(self, t.nodeTypes(), {t.numNodes()});
+                },
+                "The int64 AigNodeType of each node. AIG_NODE_NUMBER for the unused object ids")
+        .def_property_readonly("levels",
+                [](py::object self)
+                {
+                    const auto &t = self.cast<const PyAigTensors &>().tensors();
+                    return graphTensor(self, t.levels(), {t.numNodes()});
+                },
+                "The int64 level of each node")
+        .def_property_readonly("features",
+                [](py::object self)
+                {
+                    const auto &t = self.cast<const PyAigTensors &>().tensors();
+                    return graphTensor(self, t.features(), {t.numNodes(), PROJECT_NAMESPACE::AIG_TENSOR_NUM_FEATURES});
+                },
+                "The float32 node features, numNodes x 8: the one-hot node type, the level over the depth and the number of fanouts");
+
+    m.def("graphTensors", [](py::object abc) { return PyAigTensors(abc); },
+            "Copy the mirror of the last updateGraph() into tensors sharing their buffers with torch.from_dlpack. Stale right away if an action ran since",
+            py::arg("abc"));
+}
@@ -0,0 +1,33 @@
+/**
+ * @file MetricsAPI.cpp
+ * @brief The Python interface for the metrics registry
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include "util/Metrics.h"
+
+namespace py = pybind11;
+void initMetricsAPI(py::module &m)
+{
+    py::enum_<PROJECT_NAMESPACE::MetricsFormat>(m, "MetricsFormat")
+        .value("JSON", PROJECT_NAMESPACE::MetricsFormat::JSON)
+        .value("PROMETHEUS", PROJECT_NAMESPACE::MetricsFormat::PROMETHEUS);
+
+    m.def("setMetricsWorker", [](const std::string &worker) { PROJECT_NAMESPACE::MetricsRegistry::instance().setWorker(worker); },
+            "Set the worker label of the exported metrics. Defaults to the process id", py::arg("worker"));
+    m.def("metrics", [](PROJECT_NAMESPACE::MetricsFormat format) { return PROJECT_NAMESPACE::MetricsRegistry::instance().render(format); },
+            "Render the metrics of this process", py::arg("format") = PROJECT_NAMESPACE::MetricsFormat::JSON);
+    m.def("dumpMetrics", [](const std::string &path, PROJECT_NAMESPACE::MetricsFormat format) { return PROJECT_NAMESPACE::MetricsRegistry::instance().dump(path, format); },
+            "Write the metrics of this process to a file", py::arg("path"), py::arg("format") = PROJECT_NAMESPACE::MetricsFormat::JSON);
+    m.def("startMetricsDump",
+            [](const std::string &path, PROJECT_NAMESPACE::MetricsFormat format, double interval)
+            {
+                PROJECT_NAMESPACE::MetricsRegistry::instance().startPeriodicDump(path, format, interval);
+            },
+            "Dump the metrics to a file periodically from a background thread",
+            py::arg("path"), py::arg("format") = PROJECT_NAMESPACE::MetricsFormat::JSON, py::arg("interval") = 10.0);
+    m.def("stopMetricsDump", []() { PROJECT_NAMESPACE::MetricsRegistry::instance().stopPeriodicDump(); },
+            "Stop the periodic metrics dump", py::call_guard<py::gil_scoped_release>());
+}
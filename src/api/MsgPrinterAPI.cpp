@@ -0,0 +1,23 @@
+/**
+ * @file MsgPrinterAPI.cpp
+ * @brief The Python interface for the message printing level
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include "global/global.h"
+
+namespace py = pybind11;
+void initMsgPrinterAPI(py::module &m)
+{
+    py::enum_<PROJECT_NAMESPACE::MsgType>(m, "MsgType")
+        .value("ERR", PROJECT_NAMESPACE::MsgType::ERR)
+        .value("WRN", PROJECT_NAMESPACE::MsgType::WRN)
+        .value("INF", PROJECT_NAMESPACE::MsgType::INF)
+        .value("DBG", PROJECT_NAMESPACE::MsgType::DBG);
+
+    m.def("setLogLevel", &PROJECT_NAMESPACE::MsgPrinter::setLevel, "Set the runtime message level. Levels not compiled in stay disabled");
+    m.def("logLevel", &PROJECT_NAMESPACE::MsgPrinter::level, "Get the runtime message level");
+    m.def("compiledLogLevel", []() { return PROJECT_NAMESPACE::MSG_COMPILED_LEVEL; }, "The most verbose message level compiled in");
+}
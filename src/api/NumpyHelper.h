@@ -0,0 +1,41 @@
+/**
+ * @file NumpyHelper.h
+ * @brief Helpers to export the C++ arrays as NumPy arrays
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_NUMPY_HELPER_H_
+#define ABC_PY_NUMPY_HELPER_H_
+
+#include <utility>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+namespace py = pybind11;
+
+/// @brief copy a vector into a 1D NumPy array
+template<typename T, typename Alloc>
+inline py::array_t<T> toNumpy(const std::vector<T, Alloc> &vec)
+{
+    return py::array_t<T>(vec.size(), vec.data());
+}
+
+/// @brief copy a row-major buffer into a 2D NumPy array
+template<typename T, typename Alloc>
+inline py::array_t<T> toNumpy(const std::vector<T, Alloc> &vec, py::ssize_t numRows, py::ssize_t numCols)
+{
+    return py::array_t<T>({numRows, numCols}, vec.data());
+}
+
+/// @brief hand a vector over to a 1D NumPy array, which owns it from then on
+template<typename T>
+inline py::array_t<T> moveToNumpy(std::vector<T> &&vec)
+{
+    auto *owned = new std::vector<T>(std::move(vec));
+    py::capsule owner(owned, [](void *ptr) { delete static_cast<std::vector<T> *>(ptr); });
+    return py::array_t<T>(owned->size(), owned->data(), owner);
+}
+
+#endif //ABC_PY_NUMPY_HELPER_H_
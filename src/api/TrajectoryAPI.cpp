@@ -0,0 +1,87 @@
+/**
+ * @file TrajectoryAPI.cpp
+ * @brief The Python interface for the binary graph-trajectory files
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include "NumpyHelper.h"
+#include <pybind11/stl.h>
+#include "graph/AigTrajectory.h"
+#include "interface/AbcInterface.h"
+
+/// @brief a trajectory graph as a dict of NumPy arrays
+static py::dict graphDict(const PROJECT_NAMESPACE::TrajectoryGraph &graph)
+{
+    py::dict dict;
+    dict["nodeTypes"] = toNumpy(graph.nodeTypes);
+    dict["fanin0"] = toNumpy(graph.fanin0);
+    dict["fanin1"] = toNumpy(graph.fanin1);
+    dict["levels"] = toNumpy(graph.levels);
+    return dict;
+}
+
+void initTrajectoryAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::TrajectoryWriter>(m, "TrajectoryWriter")
+        .def(py::init([](const std::string &prefix, std::uint64_t shardBytes, PROJECT_NAMESPACE::IntType level)
+                {
+                    auto writer = new PROJECT_NAMESPACE::TrajectoryWriter();
+                    writer->setPrefix(prefix);
+                    writer->setShardBytes(shardBytes);
+                    writer->setCompressionLevel(level);
+                    return writer;
+                }),
+                "Write trajectories into shards <prefix>-NNNNN.abctrj of about shardBytes each, deflated at the zlib level",
+                py::arg("prefix"), py::arg("shardBytes") = 256 << 20, py::arg("level") = 6)
+        .def("begin", [](PROJECT_NAMESPACE::TrajectoryWriter &writer, PROJECT_NAMESPACE::AbcInterface &abc)
+                { abc.updateGraph(); return writer.begin(abc.aigNodes()); },
+                "Start a trajectory from the current graph of an AbcInterface", py::arg("abc"))
+        .def("step", [](PROJECT_NAMESPACE::TrajectoryWriter &writer, PROJECT_NAMESPACE::AbcInterface &abc, PROJECT_NAMESPACE::IntType action, double reward)
+                { abc.updateGraph(); return writer.addStep(action, reward, abc.aigNodes()); },
+                "Record the action, its reward and the graph after it", py::arg("abc"), py::arg("action"), py::arg("reward"))
+        .def("end", &PROJECT_NAMESPACE::TrajectoryWriter::end, "Finish the trajectory and write its block")
+        .def("close", &PROJECT_NAMESPACE::TrajectoryWriter::close, "Close the open shard, writing its index")
+        .def("shards", &PROJECT_NAMESPACE::TrajectoryWriter::shards, "The completed shard files")
+        .def("numTrajectories", &PROJECT_NAMESPACE::TrajectoryWriter::numTrajectories, "The number of trajectories written");
+
+    py::class_<PROJECT_NAMESPACE::Trajectory>(m, "Trajectory")
+        .def("numSteps", &PROJECT_NAMESPACE::Trajectory::numSteps, "The number of steps. There are numSteps() + 1 graphs")
+        .def("actions", [](const PROJECT_NAMESPACE::Trajectory &traj) { return toNumpy(traj.actions()); }, "The action of each step")
+        .def("rewards", [](const PROJECT_NAMESPACE::Trajectory &traj) { return toNumpy(traj.rewards()); }, "The reward of each step")
+        .def("graph", [](PROJECT_NAMESPACE::Trajectory &traj, PROJECT_NAMESPACE::IndexType step)
+                {
+                    PROJECT_NAMESPACE::TrajectoryGraph graph;
+                    if (!traj.graph(step, graph))
+                    {
+                        throw py::index_error("Cannot rebuild the graph of the step");
+                    }
+                    return graphDict(graph);
+                },
+                "The graph before step 0 or after step t, as a dict of the arrays nodeTypes, fanin0, fanin1 and levels", py::arg("step"));
+
+    py::class_<PROJECT_NAMESPACE::TrajectoryReader>(m, "TrajectoryReader")
+        .def(py::init([](const std::vector<std::string> &shards)
+                {
+                    auto reader = new PROJECT_NAMESPACE::TrajectoryReader();
+                    if (!reader->open(shards))
+                    {
+                        delete reader;
+                        throw std::runtime_error("Cannot open the trajectory shards");
+                    }
+                    return reader;
+                }),
+                "Memory-map the shards for random access", py::arg("shards"))
+        .def("numTrajectories", &PROJECT_NAMESPACE::TrajectoryReader::numTrajectories, "The number of trajectories over all the shards")
+        .def("__len__", &PROJECT_NAMESPACE::TrajectoryReader::numTrajectories)
+        .def("load", [](const PROJECT_NAMESPACE::TrajectoryReader &reader, PROJECT_NAMESPACE::IndexType idx)
+                {
+                    PROJECT_NAMESPACE::Trajectory traj;
+                    if (!reader.load(idx, traj))
+                    {
+                        throw py::index_error("Cannot load the trajectory");
+                    }
+                    return traj;
+                },
+                "Load one trajectory", py::arg("idx"));
+}
@@ -12,10 +12,24 @@
 namespace py = pybind11;
 
 void initAbcInterfaceAPI(py::module &);
+void initMsgPrinterAPI(py::module &);
+void initMetricsAPI(py::module &);
+void initGraphAPI(py::module &);
+void initAsyncAPI(py::module &);
+void initTrajectoryAPI(py::module &);
+void initDatasetAPI(py::module &);
+void initBatchAPI(py::module &);
 
 PYBIND11_MAKE_OPAQUE(std::vector<PROJECT_NAMESPACE::IndexType>);
 
 PYBIND11_MODULE(abc_py, m)
 {
     initAbcInterfaceAPI(m);
+    initMsgPrinterAPI(m);
+    initMetricsAPI(m);
+    initGraphAPI(m);
+    initAsyncAPI(m);
+    initTrajectoryAPI(m);
+    initDatasetAPI(m);
+    initBatchAPI(m);
 }
@@ -8,5 +8,25 @@
 #ifndef ABC_PY_DEFINE_H_
 #define ABC_PY_DEFINE_H_
 
+/// The most verbose message level compiled into the library. 0: ERR, 1: WRN, 2: INF, 3: DBG
+/// Messages above this level are removed at compile time
+#ifndef ABC_PY_LOG_LEVEL
+#define ABC_PY_LOG_LEVEL 3
+#endif
+
+/// Whether the accessors of the mirrored AIG graph check the index range. 1: checked, 0: unchecked
+#ifndef ABC_PY_CHECKED_ACCESS
+#define ABC_PY_CHECKED_ACCESS 1
+#endif
+
+/// Whether the Assert and AssertMsg conditions are checked. 1: checked, 0: compiled out, the condition not evaluated.
+/// Follows NDEBUG unless given, e.g. by -DABC_PY_ASSERT in CMake
+#ifndef ABC_PY_ASSERT
+#ifdef NDEBUG
+#define ABC_PY_ASSERT 0
+#else
+#define ABC_PY_ASSERT 1
+#endif
+#endif
 
 #endif /// ABC_PY_DEFINE_H
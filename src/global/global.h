@@ -17,14 +17,10 @@
 #include "util/Assert.h"
 #include "util/kLibBase.h"
 
-PROJECT_NAMESPACE_BEGIN
-
-// Function aliases
-static const auto &INF = MsgPrinter::inf;
-static const auto &WRN = MsgPrinter::wrn;
-static const auto &ERR = MsgPrinter::err;
-static const auto &DBG = MsgPrinter::dbg;
-
-PROJECT_NAMESPACE_END
+// Message aliases. The arguments of filtered out levels are not evaluated, and disabled levels are compiled out, see ABC_PY_LOG_LEVEL
+#define INF(...) ABC_PY_LOG(PROJECT_NAMESPACE::MsgType::INF, __VA_ARGS__)
+#define WRN(...) ABC_PY_LOG(PROJECT_NAMESPACE::MsgType::WRN, __VA_ARGS__)
+#define ERR(...) ABC_PY_LOG(PROJECT_NAMESPACE::MsgType::ERR, __VA_ARGS__)
+#define DBG(...) ABC_PY_LOG(PROJECT_NAMESPACE::MsgType::DBG, __VA_ARGS__)
 
 #endif // ABC_PY_GLOBAL_H_
@@ -0,0 +1,100 @@
+#include "AigCompactor.h"
+#include "util/MemoryStats.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief whether a node is an AND node
+static bool isAnd(const AigNode &node)
+{
+    return node.isValid() && node.nodeType() >= AIG_NODE_NONO;
+}
+
+void AigCompactor::appendCone(const std::vector<AigNode> &nodes, IntType root)
+{
+    // A node is numbered once its fanins are, which the ids of the edited network do not guarantee
+    _stack.push_back(root);
+    while (!_stack.empty())
+    {
+        IntType nodeIdx = _stack.back();
+        if (_abcToCompact[nodeIdx] >= 0)
+        {
+            _stack.pop_back();
+            continue;
+        }
+        const AigNode &node = nodes[nodeIdx];
+        bool ready = true;
+        for (IntType fanin : { node.hasFanin0() ? node.fanin0() : -1, node.hasFanin1() ? node.fanin1() : -1 })
+        {
+            if (fanin >= 0 && _abcToCompact[fanin] < 0 && isAnd(nodes[fanin]))
+            {
+                _stack.push_back(fanin);
+                ready = false;
+            }
+        }
+        if (ready)
+        {
+            _stack.pop_back();
+            _abcToCompact[nodeIdx] = _compactToAbc.size();
+            _compactToAbc.push_back(nodeIdx);
+        }
+    }
+}
+
+void AigCompactor::compact(const std::vector<AigNode> &nodes, std::vector<AigNode> &compactNodes, FanoutLayout *layout)
+{
+    IntType numNodes = nodes.size();
+    _compactToAbc.clear();
+    _compactToAbc.reserve(numNodes);
+    _abcToCompact.assign(numNodes, -1);
+    auto appendType = [&](IntType nodeType)
+    {
+        for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+        {
+            if (nodes[nodeIdx].isValid() && nodes[nodeIdx].nodeType() == nodeType)
+            {
+                _abcToCompact[nodeIdx] = _compactToAbc.size();
+                _compactToAbc.push_back(nodeIdx);
+            }
+        }
+    };
+    appendType(AIG_NODE_CONST1);
+    appendType(AIG_NODE_PI);
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        if (isAnd(nodes[nodeIdx]) && _abcToCompact[nodeIdx] < 0)
+        {
+            this->appendCone(nodes, nodeIdx);
+        }
+    }
+    appendType(AIG_NODE_PO);
+    // The fanins and fanouts point to the valid nodes only, so the remapped ones are never -1
+    IntType numCompact = _compactToAbc.size();
+    compactNodes.resize(numCompact);
+    for (IntType compactIdx = 0; compactIdx < numCompact; ++compactIdx)
+    {
+        const AigNode &node = nodes[_compactToAbc[compactIdx]];
+        _fanouts.clear();
+        for (IntType fanout : node.fanouts())
+        {
+            _fanouts.push_back(_abcToCompact[fanout]);
+        }
+        compactNodes[compactIdx].configureNode(node.nodeType(),
+                node.hasFanin0() ? _abcToCompact[node.fanin0()] : -1,
+                node.hasFanin1() ? _abcToCompact[node.fanin1()] : -1,
+                node.isFanin0Compl(), node.level(), _fanouts.data(), _fanouts.size(), layout);
+    }
+}
+
+void AigCompactor::clear()
+{
+    _compactToAbc.clear();
+    _abcToCompact.clear();
+}
+
+std::uint64_t AigCompactor::memoryBytes() const
+{
+    return MemoryStats::vectorBytes(_compactToAbc) + MemoryStats::vectorBytes(_abcToCompact)
+        + MemoryStats::vectorBytes(_stack) + MemoryStats::vectorBytes(_fanouts);
+}
+
+PROJECT_NAMESPACE_END
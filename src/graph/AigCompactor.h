@@ -0,0 +1,51 @@
+/**
+ * @file AigCompactor.h
+ * @brief Renumber the mirrored AIG graph with dense, topologically ordered node ids
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_COMPACTOR_H_
+#define ABC_PY_AIG_COMPACTOR_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::AigCompactor
+/// @brief The mirror is indexed by the ABC object id, which leaves an empty slot for each object deleted by the edits.
+/// The compactor drops the empty slots and orders the rest CONST1 first, then the PIs, then the AND nodes with each
+/// after its fanins, then the POs; the PIs and POs keep their relative order. It keeps the maps between both ids
+class AigCompactor
+{
+    public:
+        explicit AigCompactor() = default;
+        /// @brief renumber a mirror
+        /// @param first: the mirror indexed by the ABC object id
+        /// @param second: the compact mirror
+        /// @param third: where to store the fanouts of the compact mirror
+        void compact(const std::vector<AigNode> &nodes, std::vector<AigNode> &compactNodes, FanoutLayout *layout);
+        /// @brief drop the maps
+        void clear();
+        /// @brief the ABC object id of each compact id
+        const std::vector<IntType> & compactToAbc() const { return _compactToAbc; }
+        /// @brief the compact id of each ABC object id. -1 for the empty slots
+        const std::vector<IntType> & abcToCompact() const { return _abcToCompact; }
+        /// @brief the heap bytes of the maps
+        std::uint64_t memoryBytes() const;
+    private:
+        /// @brief append the AND nodes in the fanin cone of a node to the order, fanins first
+        /// @param first: the mirror
+        /// @param second: the node
+        void appendCone(const std::vector<AigNode> &nodes, IntType root);
+    private:
+        std::vector<IntType> _compactToAbc; ///< The ABC object id of each compact id
+        std::vector<IntType> _abcToCompact; ///< The compact id of each ABC object id
+        std::vector<IntType> _stack; ///< The scratch stack of the DFS
+        std::vector<IntType> _fanouts; ///< The scratch fanouts of a node
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_COMPACTOR_H_
@@ -0,0 +1,247 @@
+#include "AigCutEnum.h"
+#include <omp.h>
+#include "AigLevelPartition.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the signature of the leaves of a cut
+static std::uint64_t cutSign(const AigCut &cut)
+{
+    std::uint64_t sign = 0;
+    for (IntType idx = 0; idx < cut.size; ++idx)
+    {
+        sign |= 1ULL << (cut.leaves[idx] & 63);
+    }
+    return sign;
+}
+
+/// @brief whether the leaves of cut0 are a subset of the leaves of cut1
+static bool cutIsSubset(const AigCut &cut0, const AigCut &cut1)
+{
+    if (cut0.size > cut1.size || (cut0.sign & ~cut1.sign) != 0)
+    {
+        return false;
+    }
+    IntType pos1 = 0;
+    for (IntType pos0 = 0; pos0 < cut0.size; ++pos0)
+    {
+        while (pos1 < cut1.size && cut1.leaves[pos1] < cut0.leaves[pos0])
+        {
+            ++pos1;
+        }
+        if (pos1 == cut1.size || cut1.leaves[pos1] != cut0.leaves[pos0])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief the priority of the cuts: fewer leaves first, then by the leaves for determinism
+static bool cutLess(const AigCut &cut0, const AigCut &cut1)
+{
+    if (cut0.size != cut1.size)
+    {
+        return cut0.size < cut1.size;
+    }
+    return std::lexicographical_compare(cut0.leaves, cut0.leaves + cut0.size, cut1.leaves, cut1.leaves + cut1.size);
+}
+
+void AigCutEnum::setCutSize(IntType cutSize)
+{
+    if (cutSize < 2 || cutSize > AIG_CUT_MAX_SIZE)
+    {
+        WRN("%s: cut size %d is not in [2, %d], clamped \n", __FUNCTION__, cutSize, AIG_CUT_MAX_SIZE);
+    }
+    _cutSize = std::min(std::max(cutSize, 2), AIG_CUT_MAX_SIZE);
+}
+
+void AigCutEnum::build(const std::vector<AigNode> &nodes)
+{
+    IntType numNodes = nodes.size();
+    _cuts.assign(static_cast<std::size_t>(numNodes) * slotSize(), AigCut());
+    _numCuts.assign(numNodes, 0);
+    AigLevelPartition partition;
+    partition.build(nodes);
+    const std::vector<IntType> &order = partition.nodeOrder();
+    IntType numThreads = _numThreads > 0 ? _numThreads : omp_get_max_threads();
+    for (IntType level = 0; level < partition.numLevels(); ++level)
+    {
+        IntType begin = partition.levelOffsets()[level];
+        IntType end = partition.levelOffsets()[level + 1];
+        #pragma omp parallel num_threads(numThreads) if (end - begin > 256)
+        {
+            std::vector<AigCut> candidates;
+            #pragma omp for schedule(dynamic, 64)
+            for (IntType pos = begin; pos < end; ++pos)
+            {
+                IntType nodeIdx = order[pos];
+                IntType nodeType = nodes[nodeIdx].nodeType();
+                if (nodeType == AIG_NODE_PO)
+                {
+                    continue;
+                }
+                if (nodeType == AIG_NODE_CONST1)
+                {
+                    // The constant has only the empty cut
+                    AigCut &cut = _cuts[static_cast<std::size_t>(nodeIdx) * slotSize()];
+                    cut.truth = ~0ULL;
+                    cut.size = 0;
+                    cut.sign = 0;
+                    _numCuts[nodeIdx] = 1;
+                    continue;
+                }
+                if (nodeType != AIG_NODE_PI)
+                {
+                    enumerateNode(nodes, nodeIdx, candidates);
+                }
+                setTrivialCut(nodeIdx);
+            }
+        }
+    }
+}
+
+void AigCutEnum::setTrivialCut(IntType nodeIdx)
+{
+    AigCut &cut = _cuts[static_cast<std::size_t>(nodeIdx) * slotSize() + _numCuts[nodeIdx]];
+    cut.truth = TRUTH6_VARS[0];
+    cut.leaves[0] = nodeIdx;
+    cut.size = 1;
+    cut.sign = cutSign(cut);
+    _numCuts[nodeIdx] += 1;
+}
+
+void AigCutEnum::enumerateNode(const std::vector<AigNode> &nodes, IntType nodeIdx, std::vector<AigCut> &candidates)
+{
+    const AigNode &node = nodes[nodeIdx];
+    IntType fanin0 = node.fanin0();
+    IntType fanin1 = node.fanin1();
+    bool compl0 = node.isFanin0Compl();
+    bool compl1 = node.isFanin1Compl();
+    candidates.clear();
+    AigCut merged;
+    for (IntType idx0 = 0; idx0 < _numCuts[fanin0]; ++idx0)
+    {
+        for (IntType idx1 = 0; idx1 < _numCuts[fanin1]; ++idx1)
+        {
+            if (!mergeCuts(cut(fanin0, idx0), compl0, cut(fanin1, idx1), compl1, merged))
+            {
+                continue;
+            }
+            // Drop the merged cut if dominated, and drop the cuts it dominates
+            bool dominated = false;
+            for (const AigCut &other : candidates)
+            {
+                if (cutIsSubset(other, merged))
+                {
+                    dominated = true;
+                    break;
+                }
+            }
+            if (dominated)
+            {
+                continue;
+            }
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                        [&](const AigCut &other) { return cutIsSubset(merged, other); }), candidates.end());
+            candidates.push_back(merged);
+        }
+    }
+    IntType numKeep = std::min(static_cast<IntType>(candidates.size()), _cutLimit);
+    std::partial_sort(candidates.begin(), candidates.begin() + numKeep, candidates.end(), cutLess);
+    std::copy(candidates.begin(), candidates.begin() + numKeep, _cuts.begin() + static_cast<std::size_t>(nodeIdx) * slotSize());
+    _numCuts[nodeIdx] = numKeep;
+}
+
+bool AigCutEnum::mergeCuts(const AigCut &cut0, bool compl0, const AigCut &cut1, bool compl1, AigCut &result) const
+{
+    // Merge the sorted leaves, recording where the variables of each cut go
+    int pos0[AIG_CUT_MAX_SIZE];
+    int pos1[AIG_CUT_MAX_SIZE];
+    IntType idx0 = 0;
+    IntType idx1 = 0;
+    IntType size = 0;
+    while (idx0 < cut0.size || idx1 < cut1.size)
+    {
+        if (size == _cutSize)
+        {
+            return false;
+        }
+        if (idx1 == cut1.size || (idx0 < cut0.size && cut0.leaves[idx0] < cut1.leaves[idx1]))
+        {
+            pos0[idx0] = size;
+            result.leaves[size++] = cut0.leaves[idx0++];
+        }
+        else if (idx0 == cut0.size || cut1.leaves[idx1] < cut0.leaves[idx0])
+        {
+            pos1[idx1] = size;
+            result.leaves[size++] = cut1.leaves[idx1++];
+        }
+        else
+        {
+            pos0[idx0] = size;
+            pos1[idx1] = size;
+            result.leaves[size++] = cut0.leaves[idx0++];
+            ++idx1;
+        }
+    }
+    Truth6 truth0 = truth6Stretch(cut0.truth, cut0.size, pos0);
+    Truth6 truth1 = truth6Stretch(cut1.truth, cut1.size, pos1);
+    Truth6 truth = (compl0 ? ~truth0 : truth0) & (compl1 ? ~truth1 : truth1);
+    // Remove the leaves the function does not depend on, by moving them to the top
+    for (IntType var = size - 1; var >= 0; --var)
+    {
+        if (truth6HasVar(truth, var))
+        {
+            continue;
+        }
+        for (IntType pos = var; pos < size - 1; ++pos)
+        {
+            truth = truth6SwapAdjacent(truth, pos);
+            result.leaves[pos] = result.leaves[pos + 1];
+        }
+        --size;
+    }
+    result.truth = truth;
+    result.size = size;
+    result.sign = cutSign(result);
+    return true;
+}
+
+std::vector<IntType> AigCutEnum::sizeHistogram() const
+{
+    IntType numNodes = _numCuts.size();
+    std::vector<IntType> hist(static_cast<std::size_t>(numNodes) * (_cutSize + 1), 0);
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        for (IntType cutIdx = 0; cutIdx + 1 < _numCuts[nodeIdx]; ++cutIdx)
+        {
+            hist[static_cast<std::size_t>(nodeIdx) * (_cutSize + 1) + cut(nodeIdx, cutIdx).size] += 1;
+        }
+    }
+    return hist;
+}
+
+void AigCutEnum::exportCuts(std::vector<IntType> &offsets, std::vector<IntType> &leaves, std::vector<Truth6> &truths) const
+{
+    IntType numNodes = _numCuts.size();
+    offsets.assign(numNodes + 1, 0);
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        offsets[nodeIdx + 1] = offsets[nodeIdx] + std::max(_numCuts[nodeIdx] - 1, 0);
+    }
+    leaves.assign(static_cast<std::size_t>(offsets[numNodes]) * _cutSize, -1);
+    truths.resize(offsets[numNodes]);
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        for (IntType cutIdx = 0; cutIdx + 1 < _numCuts[nodeIdx]; ++cutIdx)
+        {
+            const AigCut &c = cut(nodeIdx, cutIdx);
+            IntType flatIdx = offsets[nodeIdx] + cutIdx;
+            std::copy(c.leaves, c.leaves + c.size, leaves.begin() + static_cast<std::size_t>(flatIdx) * _cutSize);
+            truths[flatIdx] = c.truth;
+        }
+    }
+}
+
+PROJECT_NAMESPACE_END
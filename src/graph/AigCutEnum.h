@@ -0,0 +1,82 @@
+/**
+ * @file AigCutEnum.h
+ * @brief k-feasible priority cut enumeration with truth tables over the mirrored AIG graph
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_CUT_ENUM_H_
+#define ABC_PY_AIG_CUT_ENUM_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+#include "Truth6.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The largest supported cut size. The truth table of a cut fits in one 64-bit word
+constexpr IntType AIG_CUT_MAX_SIZE = 6;
+
+/// @class ABC_PY::AigCut
+/// @brief One cut. Leaf i is variable i of the truth table
+struct AigCut
+{
+    Truth6 truth = 0; ///< The function of the root in terms of the leaves
+    std::uint64_t sign = 0; ///< Bloom signature of the leaves, for fast subset checks
+    IntType leaves[AIG_CUT_MAX_SIZE]; ///< The leaf node indices, increasing
+    IntType size = 0; ///< The number of leaves
+};
+
+/// @class ABC_PY::AigCutEnum
+/// @brief Priority cut enumeration. Every node keeps its trivial cut plus at most cutLimit cuts of up to cutSize leaves,
+/// preferring the smaller ones. Nodes of the same level are independent, so each level is processed in parallel.
+class AigCutEnum
+{
+    public:
+        explicit AigCutEnum() = default;
+        /// @brief set the largest cut size K. 2 <= K <= 6
+        void setCutSize(IntType cutSize);
+        /// @brief set the number of non-trivial cuts kept per node
+        void setCutLimit(IntType cutLimit) { _cutLimit = std::max(cutLimit, 1); }
+        /// @brief set the number of threads. 0 to use the OpenMP default
+        void setNumThreads(IntType numThreads) { _numThreads = numThreads; }
+        /// @brief enumerate the cuts of all the nodes
+        /// @param the mirrored graph
+        void build(const std::vector<AigNode> &nodes);
+        /// @brief get the number of cuts of a node, including the trivial cut. 0 for POs
+        IntType numCuts(IntType nodeIdx) const { return _numCuts[nodeIdx]; }
+        /// @brief get a cut of a node. The non-trivial cuts come first, the trivial cut is the last one
+        const AigCut & cut(IntType nodeIdx, IntType cutIdx) const { return _cuts[nodeIdx * slotSize() + cutIdx]; }
+        /// @brief the number of cuts of each leaf count of each node, as a row-major numNodes x (K + 1) array. The trivial cut is not counted
+        std::vector<IntType> sizeHistogram() const;
+        /// @brief export the non-trivial cuts of all the nodes as flat arrays
+        /// @param first: the start of the cuts of each node. numNodes + 1 entries
+        /// @param second: the leaves of each cut, padded with -1 to K entries
+        /// @param third: the truth table of each cut
+        void exportCuts(std::vector<IntType> &offsets, std::vector<IntType> &leaves, std::vector<Truth6> &truths) const;
+        /// @brief get the largest cut size
+        IntType cutSize() const { return _cutSize; }
+    private:
+        /// @brief the number of cut slots of one node
+        IntType slotSize() const { return _cutLimit + 1; }
+        /// @brief enumerate the cuts of one AND node from the cuts of its fanins
+        /// @param first: the mirrored graph
+        /// @param second: the node index
+        /// @param third: the scratch buffer of the candidate cuts
+        void enumerateNode(const std::vector<AigNode> &nodes, IntType nodeIdx, std::vector<AigCut> &candidates);
+        /// @brief merge two cuts and compute the truth table of the AND of their functions
+        /// @return false if the merged cut has more than cutSize leaves
+        bool mergeCuts(const AigCut &cut0, bool compl0, const AigCut &cut1, bool compl1, AigCut &result) const;
+        /// @brief set the trivial cut of a node
+        void setTrivialCut(IntType nodeIdx);
+    private:
+        IntType _cutSize = 4; ///< The largest number of leaves
+        IntType _cutLimit = 8; ///< The number of non-trivial cuts kept per node
+        IntType _numThreads = 0; ///< The number of threads
+        std::vector<AigCut> _cuts; ///< The cuts, slotSize() slots per node
+        std::vector<IntType> _numCuts; ///< The number of cuts of each node
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_CUT_ENUM_H_
@@ -0,0 +1,162 @@
+#include "AigGraphDiff.h"
+#include <algorithm>
+#include "interface/AigStructHash.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The seed of the keys of the POs, mixed with their order
+constexpr std::uint64_t STRUCT_KEY_PO = 0x27d4eb2f165667c5ULL;
+
+void AigGraphDiff::nodeKeys(const std::vector<AigNode> &nodes, std::vector<std::uint64_t> &keys)
+{
+    IntType numNodes = nodes.size();
+    keys.assign(numNodes, 0);
+    // The empty slots, CONST1 and the PIs are keyed up front. The PIs and POs are ordered by the node index,
+    // which follows their port order in both the network and the GIA
+    std::vector<char> done(numNodes, 0);
+    std::vector<IntType> poOrder(numNodes, -1);
+    IntType numPis = 0, numPos = 0;
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        const AigNode &node = nodes[nodeIdx];
+        if (!node.isValid())
+        {
+            done[nodeIdx] = 1;
+        }
+        else if (node.nodeType() == AIG_NODE_CONST1)
+        {
+            keys[nodeIdx] = STRUCT_KEY_CONST1;
+            done[nodeIdx] = 1;
+        }
+        else if (node.nodeType() == AIG_NODE_PI)
+        {
+            keys[nodeIdx] = klib::splitMix64(++numPis);
+            done[nodeIdx] = 1;
+        }
+        else if (node.nodeType() == AIG_NODE_PO)
+        {
+            poOrder[nodeIdx] = numPos++;
+        }
+    }
+    auto faninKey = [&](IntType fanin, bool isCompl)
+    {
+        return keys[fanin] ^ (isCompl ? STRUCT_KEY_COMPL : 0);
+    };
+    // The object ids need not be topological after the edits, so the keys follow a DFS over the fanins
+    std::vector<IntType> stack;
+    for (IntType root = 0; root < numNodes; ++root)
+    {
+        if (done[root])
+        {
+            continue;
+        }
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            IntType nodeIdx = stack.back();
+            if (done[nodeIdx])
+            {
+                stack.pop_back();
+                continue;
+            }
+            const AigNode &node = nodes[nodeIdx];
+            bool ready = true;
+            if (node.hasFanin0() && !done[node.fanin0()])
+            {
+                stack.push_back(node.fanin0());
+                ready = false;
+            }
+            if (node.hasFanin1() && !done[node.fanin1()])
+            {
+                stack.push_back(node.fanin1());
+                ready = false;
+            }
+            if (!ready)
+            {
+                continue;
+            }
+            stack.pop_back();
+            done[nodeIdx] = 1;
+            if (node.nodeType() == AIG_NODE_PO)
+            {
+                keys[nodeIdx] = klib::splitMix64(faninKey(node.fanin0(), node.isFanin0Compl()) ^ klib::splitMix64(STRUCT_KEY_PO + poOrder[nodeIdx]));
+            }
+            else
+            {
+                keys[nodeIdx] = AigStructHash::andKey(faninKey(node.fanin0(), node.isFanin0Compl()), faninKey(node.fanin1(), node.isFanin1Compl()));
+            }
+        }
+    }
+}
+
+/// @brief the (key, node index) pairs of the keyed nodes, sorted
+static std::vector<std::pair<std::uint64_t, IntType>> sortedKeys(const std::vector<std::uint64_t> &keys)
+{
+    std::vector<std::pair<std::uint64_t, IntType>> sorted;
+    sorted.reserve(keys.size());
+    for (IndexType nodeIdx = 0; nodeIdx < keys.size(); ++nodeIdx)
+    {
+        if (keys[nodeIdx] != 0)
+        {
+            sorted.emplace_back(keys[nodeIdx], nodeIdx);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+void AigGraphDiff::build(const std::vector<std::uint64_t> &oldKeys, const std::vector<std::uint64_t> &newKeys)
+{
+    _oldToNew.assign(oldKeys.size(), -1);
+    _newToOld.assign(newKeys.size(), -1);
+    _created.clear();
+    _removed.clear();
+    // Merge the sorted keys. Nodes of the same key, e.g. duplicated logic, are paired in the order of their index
+    auto oldSorted = sortedKeys(oldKeys);
+    auto newSorted = sortedKeys(newKeys);
+    IndexType oldPos = 0, newPos = 0;
+    while (oldPos < oldSorted.size() && newPos < newSorted.size())
+    {
+        if (oldSorted[oldPos].first < newSorted[newPos].first)
+        {
+            ++oldPos;
+        }
+        else if (newSorted[newPos].first < oldSorted[oldPos].first)
+        {
+            ++newPos;
+        }
+        else
+        {
+            _oldToNew[oldSorted[oldPos].second] = newSorted[newPos].second;
+            _newToOld[newSorted[newPos].second] = oldSorted[oldPos].second;
+            ++oldPos;
+            ++newPos;
+        }
+    }
+    for (IndexType nodeIdx = 0; nodeIdx < oldKeys.size(); ++nodeIdx)
+    {
+        if (oldKeys[nodeIdx] != 0 && _oldToNew[nodeIdx] < 0)
+        {
+            _removed.push_back(nodeIdx);
+        }
+    }
+    for (IndexType nodeIdx = 0; nodeIdx < newKeys.size(); ++nodeIdx)
+    {
+        if (newKeys[nodeIdx] != 0 && _newToOld[nodeIdx] < 0)
+        {
+            _created.push_back(nodeIdx);
+        }
+    }
+}
+
+void AigGraphDiff::clear()
+{
+    _oldToNew.clear();
+    _newToOld.clear();
+    _created.clear();
+    _removed.clear();
+    _fromGeneration = 0;
+    _toGeneration = 0;
+}
+
+PROJECT_NAMESPACE_END
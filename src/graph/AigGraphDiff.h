@@ -0,0 +1,64 @@
+/**
+ * @file AigGraphDiff.h
+ * @brief Match the nodes of two mirrored AIG graphs by structure, across the renumbering done by ABC
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_GRAPH_DIFF_H_
+#define ABC_PY_AIG_GRAPH_DIFF_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::AigGraphDiff
+/// @brief The node mapping between two generations of the mirror. Each node is keyed by structure as in AigStructHash:
+/// an AND node by the keys of its fanins and their complements, a PI by its order and a PO by its order and its driver.
+/// Nodes with the same key in both graphs are the same node, so an AND node keeps its identity exactly as long as
+/// its whole cone does. The rest are removed from the old graph or created in the new one
+class AigGraphDiff
+{
+    public:
+        explicit AigGraphDiff() = default;
+        /// @brief compute the structural key of each node of a mirror. 0 for the empty slots
+        /// @param first: the mirrored graph
+        /// @param second: the keys, indexed by the node index
+        static void nodeKeys(const std::vector<AigNode> &nodes, std::vector<std::uint64_t> &keys);
+        /// @brief match the nodes of two graphs by their keys
+        /// @param first: the keys of the old graph
+        /// @param second: the keys of the new graph
+        void build(const std::vector<std::uint64_t> &oldKeys, const std::vector<std::uint64_t> &newKeys);
+        /// @brief drop the mapping
+        void clear();
+        /// @brief the new index of each old node. -1 if removed or an empty slot
+        const std::vector<IntType> & oldToNew() const { return _oldToNew; }
+        /// @brief the old index of each new node. -1 if created or an empty slot
+        const std::vector<IntType> & newToOld() const { return _newToOld; }
+        /// @brief the new nodes without an old counterpart, ascending
+        const std::vector<IntType> & created() const { return _created; }
+        /// @brief the old nodes without a new counterpart, ascending
+        const std::vector<IntType> & removed() const { return _removed; }
+        /// @brief the generation of the old graph
+        std::uint64_t fromGeneration() const { return _fromGeneration; }
+        /// @brief the generation of the new graph
+        std::uint64_t toGeneration() const { return _toGeneration; }
+        /// @brief set the generations the mapping is between
+        void setGenerations(std::uint64_t fromGeneration, std::uint64_t toGeneration)
+        {
+            _fromGeneration = fromGeneration;
+            _toGeneration = toGeneration;
+        }
+    private:
+        std::vector<IntType> _oldToNew; ///< The new index of each old node
+        std::vector<IntType> _newToOld; ///< The old index of each new node
+        std::vector<IntType> _created; ///< The new nodes created
+        std::vector<IntType> _removed; ///< The old nodes removed
+        std::uint64_t _fromGeneration = 0; ///< The generation of the old graph
+        std::uint64_t _toGeneration = 0; ///< The generation of the new graph
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_GRAPH_DIFF_H_
@@ -0,0 +1,170 @@
+#include "AigLevelPartition.h"
+#include "util/MemoryStats.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+void AigLevelPartition::clear()
+{
+    _nodeLevel.clear();
+    _nodeOrder.clear();
+    _levelOffsets.clear();
+    _edgeOffsets.clear();
+    _edgeSrc.clear();
+    _edgeDst.clear();
+}
+
+void AigLevelPartition::build(const std::vector<AigNode> &nodes)
+{
+    IntType numNodes = nodes.size();
+    _nodeLevel.assign(numNodes, -1);
+    // Levels recorded by ABC. POs are placed after all the others
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        const AigNode &node = nodes[idx];
+        if (!node.isValid() || node.nodeType() == AIG_NODE_PO)
+        {
+            continue;
+        }
+        if (node.nodeType() == AIG_NODE_CONST1 || node.nodeType() == AIG_NODE_PI)
+        {
+            _nodeLevel[idx] = 0;
+        }
+        else
+        {
+            _nodeLevel[idx] = node.level();
+        }
+    }
+    if (!levelsConsistent(nodes))
+    {
+        WRN("%s: levels recorded by ABC are stale, recompute them from the graph \n", __FUNCTION__);
+        recomputeLevels(nodes);
+    }
+    IntType maxLevel = -1;
+    bool hasPo = false;
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        maxLevel = std::max(maxLevel, _nodeLevel[idx]);
+        hasPo = hasPo || (nodes[idx].isValid() && nodes[idx].nodeType() == AIG_NODE_PO);
+    }
+    IntType poLevel = maxLevel + 1;
+    IntType numLevels = hasPo ? poLevel + 1 : poLevel;
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        if (nodes[idx].isValid() && nodes[idx].nodeType() == AIG_NODE_PO)
+        {
+            _nodeLevel[idx] = poLevel;
+        }
+    }
+    // Counting sort of the nodes and their incoming edges by level
+    _levelOffsets.assign(numLevels + 1, 0);
+    _edgeOffsets.assign(numLevels + 1, 0);
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        IntType level = _nodeLevel[idx];
+        if (level < 0)
+        {
+            continue;
+        }
+        _levelOffsets[level + 1] += 1;
+        _edgeOffsets[level + 1] += (nodes[idx].hasFanin0() ? 1 : 0) + (nodes[idx].hasFanin1() ? 1 : 0);
+    }
+    for (IntType level = 0; level < numLevels; ++level)
+    {
+        _levelOffsets[level + 1] += _levelOffsets[level];
+        _edgeOffsets[level + 1] += _edgeOffsets[level];
+    }
+    _nodeOrder.resize(_levelOffsets[numLevels]);
+    _edgeSrc.resize(_edgeOffsets[numLevels]);
+    _edgeDst.resize(_edgeOffsets[numLevels]);
+    std::vector<IntType> nodePos(_levelOffsets.begin(), _levelOffsets.end() - 1);
+    std::vector<IntType> edgePos(_edgeOffsets.begin(), _edgeOffsets.end() - 1);
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        IntType level = _nodeLevel[idx];
+        if (level < 0)
+        {
+            continue;
+        }
+        _nodeOrder[nodePos[level]++] = idx;
+        const AigNode &node = nodes[idx];
+        if (node.hasFanin0())
+        {
+            _edgeSrc[edgePos[level]] = node.fanin0();
+            _edgeDst[edgePos[level]++] = idx;
+        }
+        if (node.hasFanin1())
+        {
+            _edgeSrc[edgePos[level]] = node.fanin1();
+            _edgeDst[edgePos[level]++] = idx;
+        }
+    }
+}
+
+bool AigLevelPartition::levelsConsistent(const std::vector<AigNode> &nodes) const
+{
+    IntType numNodes = nodes.size();
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        const AigNode &node = nodes[idx];
+        if (!node.isValid() || node.nodeType() == AIG_NODE_PO || !node.hasFanin0())
+        {
+            continue;
+        }
+        if (_nodeLevel[node.fanin0()] >= _nodeLevel[idx] || _nodeLevel[node.fanin1()] >= _nodeLevel[idx])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AigLevelPartition::recomputeLevels(const std::vector<AigNode> &nodes)
+{
+    IntType numNodes = nodes.size();
+    std::vector<IntType> stack;
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        if (_nodeLevel[idx] >= 0 && nodes[idx].hasFanin0())
+        {
+            _nodeLevel[idx] = -2; // AND node to be computed
+        }
+    }
+    for (IntType root = 0; root < numNodes; ++root)
+    {
+        if (_nodeLevel[root] != -2)
+        {
+            continue;
+        }
+        // Iterative DFS over the fanins. A node is finished once both of its fanins are
+        stack.push_back(root);
+        while (!stack.empty())
+        {
+            IntType idx = stack.back();
+            IntType fanin0 = nodes[idx].fanin0();
+            IntType fanin1 = nodes[idx].fanin1();
+            if (_nodeLevel[fanin0] == -2)
+            {
+                _nodeLevel[fanin0] = -3; // On the stack
+                stack.push_back(fanin0);
+                continue;
+            }
+            if (_nodeLevel[fanin1] == -2)
+            {
+                _nodeLevel[fanin1] = -3;
+                stack.push_back(fanin1);
+                continue;
+            }
+            AssertMsg(_nodeLevel[fanin0] >= 0 && _nodeLevel[fanin1] >= 0, "Combinational loop at node %d \n", idx);
+            _nodeLevel[idx] = std::max(_nodeLevel[fanin0], _nodeLevel[fanin1]) + 1;
+            stack.pop_back();
+        }
+    }
+}
+
+std::uint64_t AigLevelPartition::memoryBytes() const
+{
+    return MemoryStats::vectorBytes(_nodeLevel) + MemoryStats::vectorBytes(_nodeOrder) + MemoryStats::vectorBytes(_levelOffsets)
+        + MemoryStats::vectorBytes(_edgeOffsets) + MemoryStats::vectorBytes(_edgeSrc) + MemoryStats::vectorBytes(_edgeDst);
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,64 @@
+/**
+ * @file AigLevelPartition.h
+ * @brief Partition the mirrored AIG graph into topological layers
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_LEVEL_PARTITION_H_
+#define ABC_PY_AIG_LEVEL_PARTITION_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::AigLevelPartition
+/// @brief Nodes and fanin edges grouped by logic level, for level-synchronous passes from PIs to POs.
+/// CONST1 and PIs are in level 0, AND nodes use the level recorded by ABC, and POs are in the last level.
+/// Level l holds nodeOrder[levelOffsets[l], levelOffsets[l+1]) and the edges into those nodes,
+/// edgeSrc/edgeDst[edgeOffsets[l], edgeOffsets[l+1]), in the same order as the nodes.
+class AigLevelPartition
+{
+    public:
+        explicit AigLevelPartition() = default;
+        /// @brief build the partition from the mirrored graph
+        /// @param the mirrored nodes. Nodes of unknown type are skipped
+        void build(const std::vector<AigNode> &nodes);
+        /// @brief clear the partition
+        void clear();
+        /// @brief get the number of levels
+        IntType numLevels() const { return _levelOffsets.empty() ? 0 : _levelOffsets.size() - 1; }
+        /// @brief get the partition level of a node. -1 for skipped nodes
+        IntType nodeLevel(IntType nodeIdx) const { return _nodeLevel[nodeIdx]; }
+        /// @brief the node indices sorted by level. A topological order of the graph
+        const std::vector<IntType> & nodeOrder() const { return _nodeOrder; }
+        /// @brief the offsets of each level in nodeOrder. numLevels() + 1 entries
+        const std::vector<IntType> & levelOffsets() const { return _levelOffsets; }
+        /// @brief the offsets of each level in edgeSrc/edgeDst. numLevels() + 1 entries
+        const std::vector<IntType> & edgeOffsets() const { return _edgeOffsets; }
+        /// @brief the source (fanin) node of each edge
+        const std::vector<IntType> & edgeSrc() const { return _edgeSrc; }
+        /// @brief the sink node of each edge
+        const std::vector<IntType> & edgeDst() const { return _edgeDst; }
+        /// @brief the partition level of every node. -1 for skipped nodes
+        const std::vector<IntType> & nodeLevels() const { return _nodeLevel; }
+        /// @brief the heap bytes of the partition
+        std::uint64_t memoryBytes() const;
+    private:
+        /// @brief whether the recorded levels are consistent with the edges
+        bool levelsConsistent(const std::vector<AigNode> &nodes) const;
+        /// @brief compute the levels from the graph when the recorded ones are stale
+        void recomputeLevels(const std::vector<AigNode> &nodes);
+    private:
+        std::vector<IntType> _nodeLevel; ///< The level of each node
+        std::vector<IntType> _nodeOrder; ///< Node indices sorted by level
+        std::vector<IntType> _levelOffsets; ///< The start of each level in _nodeOrder
+        std::vector<IntType> _edgeOffsets; ///< The start of each level in the edge arrays
+        std::vector<IntType> _edgeSrc; ///< The fanin node of each edge
+        std::vector<IntType> _edgeDst; ///< The sink node of each edge
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_LEVEL_PARTITION_H_
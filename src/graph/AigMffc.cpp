@@ -0,0 +1,93 @@
+#include "AigMffc.h"
+#include "AigLevelPartition.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief whether the node is an AND node
+static bool isAnd(const AigNode &node)
+{
+    return node.isValid() && node.nodeType() != AIG_NODE_PO && node.hasFanin0();
+}
+
+void AigMffc::build(const std::vector<AigNode> &nodes)
+{
+    IntType numNodes = nodes.size();
+    // The virtual sink after all the outputs is represented by -1, with depth -1
+    _idom.assign(numNodes, -1);
+    _depth.assign(numNodes, 0);
+    _mffcSize.assign(numNodes, 0);
+    _coneId.assign(numNodes, -1);
+    _coneRoots.clear();
+    AigLevelPartition partition;
+    partition.build(nodes);
+    const std::vector<IntType> &order = partition.nodeOrder();
+    auto depthOf = [&](IntType idx) { return idx < 0 ? -1 : _depth[idx]; };
+    // Reverse topological order: the fanouts are finished before the node.
+    // The dominator is the nearest common ancestor of all the fanouts in the dominator tree
+    for (auto iter = order.rbegin(); iter != order.rend(); ++iter)
+    {
+        IntType idx = *iter;
+        const AigNode &node = nodes[idx];
+        IntType dom = -1;
+        if (node.nodeType() != AIG_NODE_PO && node.numFanouts() > 0)
+        {
+            FanoutRange fanouts = node.fanouts();
+            FanoutIterator fanoutIter = fanouts.begin();
+            dom = *fanoutIter;
+            for (++fanoutIter; fanoutIter != fanouts.end() && dom >= 0; ++fanoutIter)
+            {
+                IntType other = *fanoutIter;
+                while (dom != other)
+                {
+                    while (depthOf(dom) > depthOf(other)) { dom = _idom[dom]; }
+                    while (depthOf(other) > depthOf(dom)) { other = _idom[other]; }
+                    if (dom != other)
+                    {
+                        dom = _idom[dom];
+                        other = _idom[other];
+                    }
+                    if (dom < 0 || other < 0)
+                    {
+                        dom = -1;
+                        break;
+                    }
+                }
+            }
+        }
+        _idom[idx] = dom;
+        _depth[idx] = depthOf(dom) + 1;
+    }
+    // Subtree sizes. A node comes before its dominator in topological order
+    for (IntType idx : order)
+    {
+        if (isAnd(nodes[idx]))
+        {
+            _mffcSize[idx] += 1;
+        }
+        if (_idom[idx] >= 0)
+        {
+            _mffcSize[_idom[idx]] += _mffcSize[idx];
+        }
+    }
+    // Maximal cones: an AND node not dominated by another AND node is a root
+    for (auto iter = order.rbegin(); iter != order.rend(); ++iter)
+    {
+        IntType idx = *iter;
+        if (!isAnd(nodes[idx]))
+        {
+            continue;
+        }
+        IntType dom = _idom[idx];
+        if (dom >= 0 && isAnd(nodes[dom]))
+        {
+            _coneId[idx] = _coneId[dom];
+        }
+        else
+        {
+            _coneId[idx] = _coneRoots.size();
+            _coneRoots.push_back(idx);
+        }
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,51 @@
+/**
+ * @file AigMffc.h
+ * @brief Maximum fanout-free cones of the mirrored AIG graph
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_MFFC_H_
+#define ABC_PY_AIG_MFFC_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::AigMffc
+/// @brief Compute the MFFC of every node and cluster the AND nodes into maximal fanout-free cones.
+/// A node v is in the MFFC of r iff every path from v to the outputs passes through r, i.e. r dominates v in the fanout direction.
+/// So the MFFCs are the subtrees of the fanout dominator tree, which is built in one reverse topological pass.
+/// The dominator tree is the hierarchical clustering: each MFFC is split into the MFFCs of the children of its root.
+class AigMffc
+{
+    public:
+        explicit AigMffc() = default;
+        /// @brief compute the MFFCs
+        /// @param the mirrored graph
+        void build(const std::vector<AigNode> &nodes);
+        /// @brief the number of AND nodes in the MFFC of each node, including itself. 0 for PIs and CONST1.
+        /// For a PO it is the cone driven by that PO alone
+        const std::vector<IntType> & mffcSizes() const { return _mffcSize; }
+        /// @brief the immediate fanout dominator of each node, i.e. its parent in the cluster hierarchy. -1 if dominated by the outputs only
+        const std::vector<IntType> & dominators() const { return _idom; }
+        /// @brief the depth of each node in the cluster hierarchy. 0 for nodes dominated by the outputs only
+        const std::vector<IntType> & depths() const { return _depth; }
+        /// @brief the maximal cone of each AND node, as a dense id in [0, numCones()). -1 for the other nodes
+        const std::vector<IntType> & coneIds() const { return _coneId; }
+        /// @brief the root node of each maximal cone
+        const std::vector<IntType> & coneRoots() const { return _coneRoots; }
+        /// @brief the number of maximal cones
+        IntType numCones() const { return _coneRoots.size(); }
+    private:
+        std::vector<IntType> _mffcSize; ///< The MFFC size of each node
+        std::vector<IntType> _idom; ///< The immediate fanout dominator of each node
+        std::vector<IntType> _depth; ///< The depth in the dominator tree
+        std::vector<IntType> _coneId; ///< The maximal cone of each AND node
+        std::vector<IntType> _coneRoots; ///< The root of each maximal cone
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_MFFC_H_
@@ -0,0 +1,112 @@
+#include "AigSampler.h"
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+#include <omp.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+AigSampledBatch AigSampler::sample(const std::vector<IntType> &seeds) const
+{
+    IntType numSeeds = seeds.size();
+    for (IntType seed : seeds)
+    {
+        MirrorAccess::checkRange(seed, _nodes.size(), "seed");
+    }
+    std::vector<Subgraph> subs(numSeeds);
+    IntType numThreads = _numThreads > 0 ? _numThreads : omp_get_max_threads();
+    #pragma omp parallel for schedule(dynamic, 16) num_threads(numThreads)
+    for (IntType idx = 0; idx < numSeeds; ++idx)
+    {
+        sampleOne(seeds[idx], klib::splitMix64(_randomSeed ^ klib::splitMix64(idx)), subs[idx]);
+    }
+    // Concatenate the subgraphs
+    AigSampledBatch batch;
+    batch.nodeOffsets.assign(numSeeds + 1, 0);
+    batch.edgeOffsets.assign(numSeeds + 1, 0);
+    for (IntType idx = 0; idx < numSeeds; ++idx)
+    {
+        batch.nodeOffsets[idx + 1] = batch.nodeOffsets[idx] + subs[idx].nodes.size();
+        batch.edgeOffsets[idx + 1] = batch.edgeOffsets[idx] + subs[idx].edgeSrc.size();
+    }
+    batch.nodes.resize(batch.nodeOffsets[numSeeds]);
+    batch.nodeHops.resize(batch.nodeOffsets[numSeeds]);
+    batch.edgeSrc.resize(batch.edgeOffsets[numSeeds]);
+    batch.edgeDst.resize(batch.edgeOffsets[numSeeds]);
+    #pragma omp parallel for schedule(static) num_threads(numThreads)
+    for (IntType idx = 0; idx < numSeeds; ++idx)
+    {
+        const Subgraph &sub = subs[idx];
+        std::copy(sub.nodes.begin(), sub.nodes.end(), batch.nodes.begin() + batch.nodeOffsets[idx]);
+        std::copy(sub.hops.begin(), sub.hops.end(), batch.nodeHops.begin() + batch.nodeOffsets[idx]);
+        std::copy(sub.edgeSrc.begin(), sub.edgeSrc.end(), batch.edgeSrc.begin() + batch.edgeOffsets[idx]);
+        std::copy(sub.edgeDst.begin(), sub.edgeDst.end(), batch.edgeDst.begin() + batch.edgeOffsets[idx]);
+    }
+    return batch;
+}
+
+void AigSampler::sampleOne(IntType seed, std::uint64_t rngSeed, Subgraph &sub) const
+{
+    std::mt19937_64 rng(rngSeed);
+    std::unordered_map<IntType, IntType> localId; // original -> local
+    std::unordered_set<std::uint64_t> edgeSet; // (local fanin, local fanout)
+    // neighbour candidates of one node: (original index, whether it is a fanin of the node)
+    std::vector<std::pair<IntType, bool>> candidates;
+    localId[seed] = 0;
+    sub.nodes.push_back(seed);
+    sub.hops.push_back(0);
+    IntType frontierBegin = 0;
+    for (IntType hop = 0; hop < static_cast<IntType>(_fanouts.size()); ++hop)
+    {
+        IntType frontierEnd = sub.nodes.size();
+        for (IntType pos = frontierBegin; pos < frontierEnd; ++pos)
+        {
+            const AigNode &node = _nodes[sub.nodes[pos]];
+            candidates.clear();
+            if (_direction != SampleDirection::FANOUT)
+            {
+                if (node.hasFanin0()) { candidates.emplace_back(node.fanin0(), true); }
+                if (node.hasFanin1()) { candidates.emplace_back(node.fanin1(), true); }
+            }
+            if (_direction != SampleDirection::FANIN)
+            {
+                for (IntType fanout : node.fanouts())
+                {
+                    candidates.emplace_back(fanout, false);
+                }
+            }
+            // Partial Fisher-Yates: the first k candidates are a uniform sample without replacement
+            IntType numTake = candidates.size();
+            if (_fanouts[hop] >= 0 && _fanouts[hop] < numTake)
+            {
+                numTake = _fanouts[hop];
+                for (IntType idx = 0; idx < numTake; ++idx)
+                {
+                    std::uniform_int_distribution<IntType> dist(idx, candidates.size() - 1);
+                    std::swap(candidates[idx], candidates[dist(rng)]);
+                }
+            }
+            for (IntType idx = 0; idx < numTake; ++idx)
+            {
+                IntType neighbour = candidates[idx].first;
+                auto inserted = localId.emplace(neighbour, sub.nodes.size());
+                if (inserted.second)
+                {
+                    sub.nodes.push_back(neighbour);
+                    sub.hops.push_back(hop + 1);
+                }
+                IntType src = candidates[idx].second ? inserted.first->second : pos;
+                IntType dst = candidates[idx].second ? pos : inserted.first->second;
+                std::uint64_t key = (static_cast<std::uint64_t>(src) << 32) | static_cast<std::uint32_t>(dst);
+                if (edgeSet.insert(key).second)
+                {
+                    sub.edgeSrc.push_back(src);
+                    sub.edgeDst.push_back(dst);
+                }
+            }
+        }
+        frontierBegin = frontierEnd;
+    }
+}
+
+PROJECT_NAMESPACE_END
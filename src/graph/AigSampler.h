@@ -0,0 +1,83 @@
+/**
+ * @file AigSampler.h
+ * @brief k-hop neighbourhood sampling over the mirrored AIG graph, for mini-batch GNN training
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_SAMPLER_H_
+#define ABC_PY_AIG_SAMPLER_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The direction to expand a neighbourhood
+enum class SampleDirection
+{
+    FANIN,  ///< Towards the PIs
+    FANOUT, ///< Towards the POs
+    BOTH    ///< Both ways
+};
+
+/// @class ABC_PY::AigSampledBatch
+/// @brief The sampled subgraphs of a batch of seeds, as contiguous arrays.
+/// Subgraph s has the nodes nodes[nodeOffsets[s], nodeOffsets[s+1]) and the edges edgeSrc/edgeDst[edgeOffsets[s], edgeOffsets[s+1]).
+/// Nodes are relabelled locally: local id i of subgraph s is nodes[nodeOffsets[s] + i], and the seed is local id 0.
+/// Edges keep the fanin to fanout orientation.
+struct AigSampledBatch
+{
+    std::vector<IntType> nodeOffsets; ///< The start of each subgraph in nodes. numSeeds + 1 entries
+    std::vector<IntType> nodes; ///< The original node indices
+    std::vector<IntType> nodeHops; ///< The hop at which each node is reached. 0 for the seed
+    std::vector<IntType> edgeOffsets; ///< The start of each subgraph in the edge arrays. numSeeds + 1 entries
+    std::vector<IntType> edgeSrc; ///< The local id of the fanin side of each edge
+    std::vector<IntType> edgeDst; ///< The local id of the fanout side of each edge
+};
+
+/// @class ABC_PY::AigSampler
+/// @brief Sample k-hop neighbourhoods, multi-threaded across the seeds.
+/// Results only depend on the random seed, not on the number of threads.
+class AigSampler
+{
+    public:
+        /// @brief constructor
+        /// @param the mirrored graph. Must outlive the sampler
+        explicit AigSampler(const std::vector<AigNode> &nodes) : _nodes(nodes) {}
+        /// @brief set the number of neighbours sampled per node at each hop. -1 to take all of them
+        void setFanouts(const std::vector<IntType> &fanouts) { _fanouts = fanouts; }
+        /// @brief set the direction to expand
+        void setDirection(SampleDirection direction) { _direction = direction; }
+        /// @brief set the random seed
+        void setRandomSeed(std::uint64_t randomSeed) { _randomSeed = randomSeed; }
+        /// @brief set the number of threads. 0 to use the OpenMP default
+        void setNumThreads(IntType numThreads) { _numThreads = numThreads; }
+        /// @brief the number of nodes of the mirrored graph, the bound of the seeds
+        IndexType numNodes() const { return _nodes.size(); }
+        /// @brief sample the neighbourhood of each seed
+        /// @param the seed node indices
+        /// @return the sampled subgraphs
+        AigSampledBatch sample(const std::vector<IntType> &seeds) const;
+    private:
+        /// @brief the sampled subgraph of one seed, in local ids
+        struct Subgraph
+        {
+            std::vector<IntType> nodes;
+            std::vector<IntType> hops;
+            std::vector<IntType> edgeSrc;
+            std::vector<IntType> edgeDst;
+        };
+        /// @brief sample the subgraph of one seed
+        void sampleOne(IntType seed, std::uint64_t rngSeed, Subgraph &sub) const;
+    private:
+        const std::vector<AigNode> &_nodes; ///< The mirrored graph
+        std::vector<IntType> _fanouts = {10, 10}; ///< The number of sampled neighbours per hop
+        SampleDirection _direction = SampleDirection::BOTH; ///< The direction to expand
+        std::uint64_t _randomSeed = 0; ///< The random seed
+        IntType _numThreads = 0; ///< The number of threads
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_SAMPLER_H_
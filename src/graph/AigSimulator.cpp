@@ -0,0 +1,267 @@
+#include "AigSimulator.h"
+#include <unordered_map>
+#include <omp.h>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "AigLevelPartition.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The smallest block of words a thread simulates: one cache line of a signature, so no two threads write the same line
+constexpr IntType SIM_BLOCK_WORDS = 8;
+/// The smallest graph whose levels are split among the threads when the signatures are too narrow for the blocks
+constexpr IntType SIM_LEVEL_PARALLEL_NODES = 2048;
+
+/// @brief out[w] = (in0[w] ^ mask0) & (in1[w] ^ mask1) for w in [begin, end)
+static inline void simAnd(std::uint64_t *out, const std::uint64_t *in0, std::uint64_t mask0,
+        const std::uint64_t *in1, std::uint64_t mask1, IntType begin, IntType end)
+{
+    IntType word = begin;
+#if defined(__AVX512F__)
+    const __m512i vMask0 = _mm512_set1_epi64(static_cast<long long>(mask0));
+    const __m512i vMask1 = _mm512_set1_epi64(static_cast<long long>(mask1));
+    for (; word + 8 <= end; word += 8)
+    {
+        __m512i v0 = _mm512_xor_si512(_mm512_loadu_si512(in0 + word), vMask0);
+        __m512i v1 = _mm512_xor_si512(_mm512_loadu_si512(in1 + word), vMask1);
+        _mm512_storeu_si512(out + word, _mm512_and_si512(v0, v1));
+    }
+#elif defined(__AVX2__)
+    const __m256i vMask0 = _mm256_set1_epi64x(static_cast<long long>(mask0));
+    const __m256i vMask1 = _mm256_set1_epi64x(static_cast<long long>(mask1));
+    for (; word + 4 <= end; word += 4)
+    {
+        __m256i v0 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in0 + word)), vMask0);
+        __m256i v1 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in1 + word)), vMask1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + word), _mm256_and_si256(v0, v1));
+    }
+#endif
+    for (; word < end; ++word)
+    {
+        out[word] = (in0[word] ^ mask0) & (in1[word] ^ mask1);
+    }
+}
+
+void AigSimulator::prepare(const std::vector<AigNode> &nodes)
+{
+    IntType numNodes = nodes.size();
+    _piNodes.clear();
+    for (IntType idx = 0; idx < numNodes; ++idx)
+    {
+        if (nodes[idx].isValid() && nodes[idx].nodeType() == AIG_NODE_PI)
+        {
+            _piNodes.push_back(idx);
+        }
+    }
+    AigLevelPartition partition;
+    partition.build(nodes);
+    _order = partition.nodeOrder();
+    _levelOffsets = partition.levelOffsets();
+    _sigWords = _numWords;
+    _sigs.assign(static_cast<std::size_t>(numNodes) * _sigWords, 0);
+    _classIds.clear();
+    _classPhases.clear();
+    _numClasses = 0;
+}
+
+void AigSimulator::simulateRandom(const std::vector<AigNode> &nodes)
+{
+    prepare(nodes);
+    IntType numPis = _piNodes.size();
+    #pragma omp parallel for schedule(static) num_threads(_numThreads > 0 ? _numThreads : omp_get_max_threads())
+    for (IntType pi = 0; pi < numPis; ++pi)
+    {
+        std::uint64_t *sig = _sigs.data() + static_cast<std::size_t>(_piNodes[pi]) * _sigWords;
+        std::uint64_t state = klib::splitMix64(_randomSeed ^ klib::splitMix64(pi));
+        for (IntType word = 0; word < _sigWords; ++word)
+        {
+            state = klib::splitMix64(state);
+            sig[word] = state;
+        }
+    }
+    propagate(nodes);
+}
+
+bool AigSimulator::simulate(const std::vector<AigNode> &nodes, const std::vector<std::uint64_t> &patterns)
+{
+    prepare(nodes);
+    if (patterns.size() != _piNodes.size() * static_cast<std::size_t>(_sigWords))
+    {
+        ERR("%s: expect %d x %d pattern words, but get %lu \n", __FUNCTION__, static_cast<IntType>(_piNodes.size()), _sigWords, patterns.size());
+        return false;
+    }
+    for (IndexType pi = 0; pi < _piNodes.size(); ++pi)
+    {
+        std::copy(patterns.begin() + pi * _sigWords, patterns.begin() + (pi + 1) * _sigWords,
+                _sigs.begin() + static_cast<std::size_t>(_piNodes[pi]) * _sigWords);
+    }
+    propagate(nodes);
+    return true;
+}
+
+void AigSimulator::propagate(const std::vector<AigNode> &nodes)
+{
+    IntType numThreads = _numThreads > 0 ? _numThreads : omp_get_max_threads();
+    // Narrow signatures, such as the default 4 words, make fewer blocks than threads. The nodes of each level are then
+    // split among the threads instead, the levels one after the other
+    if (numThreads > 1 && _sigWords < 2 * SIM_BLOCK_WORDS && static_cast<IntType>(_order.size()) >= SIM_LEVEL_PARALLEL_NODES)
+    {
+        propagateLevels(nodes, numThreads);
+        return;
+    }
+    // Each thread simulates a block of words through the whole graph, so the blocks are independent.
+    // Blocks are multiples of SIM_BLOCK_WORDS words to keep the vector loop full
+    IntType blockWords = std::max((_sigWords + numThreads - 1) / numThreads, SIM_BLOCK_WORDS);
+    blockWords = (blockWords + SIM_BLOCK_WORDS - 1) / SIM_BLOCK_WORDS * SIM_BLOCK_WORDS;
+    IntType numBlocks = (_sigWords + blockWords - 1) / blockWords;
+    #pragma omp parallel for schedule(static, 1) num_threads(std::min(numThreads, numBlocks))
+    for (IntType block = 0; block < numBlocks; ++block)
+    {
+        for (IntType nodeIdx : _order)
+        {
+            simNode(nodes, nodeIdx, block * blockWords, std::min((block + 1) * blockWords, _sigWords));
+        }
+    }
+}
+
+void AigSimulator::propagateLevels(const std::vector<AigNode> &nodes, IntType numThreads)
+{
+    IntType numLevels = static_cast<IntType>(_levelOffsets.size()) - 1;
+    #pragma omp parallel num_threads(numThreads)
+    for (IntType level = 0; level < numLevels; ++level)
+    {
+        // The barrier at the end of each level makes its signatures ready for the next one
+        #pragma omp for schedule(static)
+        for (IntType pos = _levelOffsets[level]; pos < _levelOffsets[level + 1]; ++pos)
+        {
+            simNode(nodes, _order[pos], 0, _sigWords);
+        }
+    }
+}
+
+void AigSimulator::simNode(const std::vector<AigNode> &nodes, IntType nodeIdx, IntType beginWord, IntType endWord)
+{
+    std::uint64_t *sigs = _sigs.data();
+    const AigNode &node = nodes[nodeIdx];
+    std::uint64_t *out = sigs + static_cast<std::size_t>(nodeIdx) * _sigWords;
+    IntType nodeType = node.nodeType();
+    if (nodeType == AIG_NODE_PI)
+    {
+        return;
+    }
+    if (nodeType == AIG_NODE_CONST1)
+    {
+        std::fill(out + beginWord, out + endWord, ~0ULL);
+        return;
+    }
+    const std::uint64_t *in0 = sigs + static_cast<std::size_t>(node.fanin0()) * _sigWords;
+    std::uint64_t mask0 = node.isFanin0Compl() ? ~0ULL : 0ULL;
+    if (nodeType == AIG_NODE_PO)
+    {
+        // A PO is the AND of its fanin with itself
+        simAnd(out, in0, mask0, in0, mask0, beginWord, endWord);
+        return;
+    }
+    const std::uint64_t *in1 = sigs + static_cast<std::size_t>(node.fanin1()) * _sigWords;
+    std::uint64_t mask1 = node.isFanin1Compl() ? ~0ULL : 0ULL;
+    simAnd(out, in0, mask0, in1, mask1, beginWord, endWord);
+}
+
+bool AigSimulator::computeClasses(const std::vector<AigNode> &nodes)
+{
+    IntType numNodes = nodes.size();
+    _classIds.clear();
+    _classPhases.clear();
+    _numClasses = 0;
+    if (!this->hasSignatures(nodes.size()))
+    {
+        ERR("%s: the signatures are of %lu words, not of this graph of %d nodes. Simulate it first \n", __FUNCTION__, _sigs.size(), numNodes);
+        return false;
+    }
+    _classIds.assign(numNodes, -1);
+    _classPhases.assign(numNodes, 0);
+    // Normalize the phase so that the first pattern is 0, then bucket by hash and compare the words
+    std::unordered_map<std::uint64_t, std::vector<IntType>> buckets;
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        if (!nodes[nodeIdx].isValid() || nodes[nodeIdx].nodeType() == AIG_NODE_PO)
+        {
+            continue;
+        }
+        const std::uint64_t *sig = signature(nodeIdx);
+        std::uint64_t mask = (sig[0] & 1) ? ~0ULL : 0ULL;
+        _classPhases[nodeIdx] = mask ? 1 : 0;
+        std::uint64_t hash = 0;
+        for (IntType word = 0; word < _sigWords; ++word)
+        {
+            hash = klib::splitMix64(hash ^ (sig[word] ^ mask));
+        }
+        buckets[hash].push_back(nodeIdx);
+    }
+    auto sameSig = [&](IntType node0, IntType node1)
+    {
+        const std::uint64_t *sig0 = signature(node0);
+        const std::uint64_t *sig1 = signature(node1);
+        std::uint64_t mask = (_classPhases[node0] != _classPhases[node1]) ? ~0ULL : 0ULL;
+        for (IntType word = 0; word < _sigWords; ++word)
+        {
+            if (sig0[word] != (sig1[word] ^ mask))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    std::vector<IntType> reps;
+    for (auto &pair : buckets)
+    {
+        std::vector<IntType> &members = pair.second;
+        if (members.size() < 2)
+        {
+            continue;
+        }
+        // Members are in increasing index order. Split the rare hash collisions
+        reps.clear();
+        for (IntType nodeIdx : members)
+        {
+            bool found = false;
+            for (IntType rep : reps)
+            {
+                if (sameSig(rep, nodeIdx))
+                {
+                    if (_classIds[rep] < 0)
+                    {
+                        _classIds[rep] = _numClasses++;
+                    }
+                    _classIds[nodeIdx] = _classIds[rep];
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                reps.push_back(nodeIdx);
+            }
+        }
+    }
+    // Number the classes by their smallest member, so the ids do not depend on the hashing
+    std::vector<IntType> renumber(_numClasses, -1);
+    IntType numSeen = 0;
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        IntType classId = _classIds[nodeIdx];
+        if (classId < 0)
+        {
+            continue;
+        }
+        if (renumber[classId] < 0)
+        {
+            renumber[classId] = numSeen++;
+        }
+        _classIds[nodeIdx] = renumber[classId];
+    }
+    return true;
+}
+
+PROJECT_NAMESPACE_END
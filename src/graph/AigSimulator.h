@@ -0,0 +1,99 @@
+/**
+ * @file AigSimulator.h
+ * @brief Bit-parallel simulation of the mirrored AIG graph
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_SIMULATOR_H_
+#define ABC_PY_AIG_SIMULATOR_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+#include "util/AccessPolicy.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::AigSimulator
+/// @brief Simulate 64 x numWords patterns at once. Every node gets a signature of numWords 64-bit words.
+/// The words are split into blocks of at least 8 words simulated by different threads. Signatures too narrow for a block per
+/// thread are instead simulated level by level, the nodes of a level split among the threads, on graphs of 2048 nodes or more.
+/// The inner loop uses AVX-512 or AVX2 when compiled for them.
+/// PIs are ordered by node index, see piNodes().
+class AigSimulator
+{
+    public:
+        explicit AigSimulator() = default;
+        /// @brief set the number of 64-bit words simulated per node. Takes effect at the next simulation
+        void setNumWords(IntType numWords) { _numWords = std::max(numWords, 1); }
+        /// @brief set the number of threads. 0 to use the OpenMP default
+        void setNumThreads(IntType numThreads) { _numThreads = numThreads; }
+        /// @brief set the random seed of the random patterns
+        void setRandomSeed(std::uint64_t randomSeed) { _randomSeed = randomSeed; }
+        /// @brief simulate random patterns
+        /// @param the mirrored graph
+        void simulateRandom(const std::vector<AigNode> &nodes);
+        /// @brief simulate user patterns
+        /// @param first: the mirrored graph
+        /// @param second: the patterns, a row-major numPIs x numWords array. Bit b of word w of row i is the value of PI i in pattern 64w+b
+        /// @return false if the patterns do not match the number of PIs
+        bool simulate(const std::vector<AigNode> &nodes, const std::vector<std::uint64_t> &patterns);
+        /// @brief compute the candidate equivalence classes from the signatures, up to complement.
+        /// Nodes equal to a constant under all the patterns are in the class of CONST1
+        /// @param the mirrored graph that was simulated
+        /// @return false if the signatures are not of a graph of this size, e.g. nothing was simulated yet
+        bool computeClasses(const std::vector<AigNode> &nodes);
+        /// @brief get the number of words per node of the next simulation
+        IntType numWords() const { return _numWords; }
+        /// @brief get the number of words per node of the signatures. 0 before the first simulation
+        IntType sigWords() const { return _sigWords; }
+        /// @brief whether the signatures are of a graph of this many nodes
+        bool hasSignatures(std::size_t numNodes) const { return _sigWords > 0 && _sigs.size() == numNodes * _sigWords; }
+        /// @brief the PI node indices, in the order of the pattern rows
+        const std::vector<IntType> & piNodes() const { return _piNodes; }
+        /// @brief the signatures, a row-major numNodes x sigWords() array
+        const std::vector<std::uint64_t> & signatures() const { return _sigs; }
+        /// @brief the signature of one node, sigWords() words
+        const std::uint64_t * signature(IntType nodeIdx) const
+        {
+            MirrorAccess::checkRange(nodeIdx, _sigWords > 0 ? _sigs.size() / _sigWords : 0, "signature");
+            return _sigs.data() + static_cast<std::size_t>(nodeIdx) * _sigWords;
+        }
+        /// @brief the candidate class of each node. -1 if the node is not equivalent to any other. POs are not classified
+        const std::vector<IntType> & classIds() const { return _classIds; }
+        /// @brief whether each node is complemented with respect to its class
+        const std::vector<IntType> & classPhases() const { return _classPhases; }
+        /// @brief the number of candidate classes
+        IntType numClasses() const { return _numClasses; }
+    private:
+        /// @brief collect the PIs and the topological order of the graph
+        void prepare(const std::vector<AigNode> &nodes);
+        /// @brief simulate all the nodes once the PI words are set
+        void propagate(const std::vector<AigNode> &nodes);
+        /// @brief simulate all the nodes level by level, the nodes of each level split among the threads
+        /// @param first: the mirrored graph
+        /// @param second: the number of threads
+        void propagateLevels(const std::vector<AigNode> &nodes, IntType numThreads);
+        /// @brief simulate the words [beginWord, endWord) of one node, whose fanins are done
+        /// @param first: the mirrored graph
+        /// @param second: the node
+        /// @param third: the first word
+        /// @param fourth: the end of the words
+        void simNode(const std::vector<AigNode> &nodes, IntType nodeIdx, IntType beginWord, IntType endWord);
+    private:
+        IntType _numWords = 4; ///< The number of words per node of the next simulation
+        IntType _sigWords = 0; ///< The number of words per node of the signatures
+        IntType _numThreads = 0; ///< The number of threads
+        std::uint64_t _randomSeed = 0; ///< The random seed
+        std::vector<IntType> _piNodes; ///< The PI node indices
+        std::vector<IntType> _order; ///< A topological order of the nodes, sorted by level
+        std::vector<IntType> _levelOffsets; ///< The start of each level in _order
+        std::vector<std::uint64_t> _sigs; ///< The signatures
+        std::vector<IntType> _classIds; ///< The candidate class of each node
+        std::vector<IntType> _classPhases; ///< The phase of each node in its class
+        IntType _numClasses = 0; ///< The number of classes
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_SIMULATOR_H_
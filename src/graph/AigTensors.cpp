@@ -0,0 +1,57 @@
+#include "AigTensors.h"
+#include <algorithm>
+
+PROJECT_NAMESPACE_BEGIN
+
+void AigTensors::build(const std::vector<AigNode> &nodes, std::uint64_t generation)
+{
+    _generation = generation;
+    IntType numNodes = nodes.size();
+    IntType numEdges = 0;
+    IntType depth = 0;
+    for (const AigNode &node : nodes)
+    {
+        if (node.isValid())
+        {
+            numEdges += node.hasFanin0() + node.hasFanin1();
+            depth = std::max(depth, node.level());
+        }
+    }
+    _nodeTypes.assign(numNodes, AIG_NODE_NUMBER);
+    _levels.assign(numNodes, 0);
+    _features.assign(static_cast<std::size_t>(numNodes) * AIG_TENSOR_NUM_FEATURES, 0.0f);
+    // Both rows are filled at once, so the edge index is sized up front
+    _edgeIndex.resize(2 * static_cast<std::size_t>(numEdges));
+    _edgeCompl.resize(numEdges);
+    std::int64_t *edgeSrc = _edgeIndex.data();
+    std::int64_t *edgeDst = _edgeIndex.data() + numEdges;
+    IntType edgeIdx = 0;
+    for (IntType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        const AigNode &node = nodes[nodeIdx];
+        if (!node.isValid())
+        {
+            continue;
+        }
+        _nodeTypes[nodeIdx] = node.nodeType();
+        _levels[nodeIdx] = node.level();
+        float *row = _features.data() + static_cast<std::size_t>(nodeIdx) * AIG_TENSOR_NUM_FEATURES;
+        row[node.nodeType()] = 1.0f;
+        row[AIG_NODE_NUMBER] = depth > 0 ? static_cast<float>(node.level()) / depth : 0.0f;
+        row[AIG_NODE_NUMBER + 1] = static_cast<float>(node.numFanouts());
+        if (node.hasFanin0())
+        {
+            edgeSrc[edgeIdx] = node.fanin0();
+            edgeDst[edgeIdx] = nodeIdx;
+            _edgeCompl[edgeIdx++] = node.isFanin0Compl();
+        }
+        if (node.hasFanin1())
+        {
+            edgeSrc[edgeIdx] = node.fanin1();
+            edgeDst[edgeIdx] = nodeIdx;
+            _edgeCompl[edgeIdx++] = node.isFanin1Compl();
+        }
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,60 @@
+/**
+ * @file AigTensors.h
+ * @brief The mirrored AIG graph laid out as the tensors of a graph neural network
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_TENSORS_H_
+#define ABC_PY_AIG_TENSORS_H_
+
+#include <vector>
+#include "interface/AigNode.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The columns of the node features: the one-hot node type, then the level over the depth and the number of fanouts
+constexpr IntType AIG_TENSOR_NUM_FEATURES = AIG_NODE_NUMBER + 2;
+
+/// @class ABC_PY::AigTensors
+/// @brief A snapshot of the mirror in the layout PyTorch Geometric expects: an int64 edge index of shape 2 x numEdges,
+/// the fanin in row 0 and the node in row 1, and a float32 feature matrix of shape numNodes x AIG_TENSOR_NUM_FEATURES.
+/// The snapshot is a copy: the mirror holds AigNodes rather than these arrays, so the buffers belong to the snapshot
+/// and views of them stay valid after the mirror moves on. The snapshot is tagged with the generation of the mirror
+/// it was copied from, AbcInterface::mirrorGeneration(), to tell whether it is stale
+class AigTensors
+{
+    public:
+        explicit AigTensors() = default;
+        /// @brief build the tensors
+        /// @param first: the mirrored graph
+        /// @param second: the generation of the mirror
+        void build(const std::vector<AigNode> &nodes, std::uint64_t generation);
+        /// @brief the generation of the mirror the tensors were built from
+        std::uint64_t generation() const { return _generation; }
+        /// @brief the number of nodes, including the invalid slots
+        IntType numNodes() const { return _nodeTypes.size(); }
+        /// @brief the number of edges
+        IntType numEdges() const { return _edgeIndex.size() / 2; }
+        /// @brief the edge index, row-major 2 x numEdges: the fanins, then the nodes they drive
+        const std::vector<std::int64_t> & edgeIndex() const { return _edgeIndex; }
+        /// @brief whether each edge is complemented
+        const std::vector<std::uint8_t> & edgeCompl() const { return _edgeCompl; }
+        /// @brief the type of each node, as the AigNodeType. AIG_NODE_NUMBER for the invalid slots
+        const std::vector<std::int64_t> & nodeTypes() const { return _nodeTypes; }
+        /// @brief the level of each node
+        const std::vector<std::int64_t> & levels() const { return _levels; }
+        /// @brief the node features, row-major numNodes x AIG_TENSOR_NUM_FEATURES. All zero for the invalid slots
+        const std::vector<float> & features() const { return _features; }
+    private:
+        std::uint64_t _generation = 0; ///< The generation of the mirror
+        std::vector<std::int64_t> _edgeIndex; ///< The edge index
+        std::vector<std::uint8_t> _edgeCompl; ///< Whether each edge is complemented
+        std::vector<std::int64_t> _nodeTypes; ///< The type of each node
+        std::vector<std::int64_t> _levels; ///< The level of each node
+        std::vector<float> _features; ///< The node features
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_TENSORS_H_
@@ -0,0 +1,487 @@
+#include "AigTrajectory.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <abc_src/misc/zlib/zlib.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The magic bytes at the start and the end of a shard
+constexpr char TRAJECTORY_MAGIC[8] = { 'A', 'B', 'C', 'P', 'Y', 'T', 'R', 'J' };
+/// The version written. Readers reject newer versions
+constexpr std::uint32_t TRAJECTORY_VERSION = 1;
+/// The bytes of the shard header: the magic, the version and a reserved word
+constexpr std::size_t TRAJECTORY_HEADER_SIZE = sizeof(TRAJECTORY_MAGIC) + 2 * sizeof(std::uint32_t);
+/// The bytes of the shard trailer: the offset of the index, the number of entries and the magic
+constexpr std::size_t TRAJECTORY_TRAILER_SIZE = 2 * sizeof(std::uint64_t) + sizeof(TRAJECTORY_MAGIC);
+
+void TrajectoryGraph::assign(const std::vector<AigNode> &nodes)
+{
+    this->resize(nodes.size());
+    for (IndexType nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+    {
+        const AigNode &node = nodes[nodeIdx];
+        nodeTypes[nodeIdx] = node.isValid() ? node.nodeType() : AIG_NODE_NUMBER;
+        fanin0[nodeIdx] = node.hasFanin0() ? node.fanin0() : -1;
+        fanin1[nodeIdx] = node.hasFanin1() ? node.fanin1() : -1;
+        levels[nodeIdx] = node.level();
+    }
+}
+
+void TrajectoryGraph::resize(IndexType numNodes)
+{
+    nodeTypes.resize(numNodes, AIG_NODE_NUMBER);
+    fanin0.resize(numNodes, -1);
+    fanin1.resize(numNodes, -1);
+    levels.resize(numNodes, 0);
+}
+
+/// @brief encode a fanin relative to its node. 0 for none
+static std::uint64_t encodeFanin(IndexType nodeIdx, IntType fanin)
+{
+    if (fanin < 0)
+    {
+        return 0;
+    }
+    std::int64_t diff = static_cast<std::int64_t>(nodeIdx) - fanin;
+    return ((static_cast<std::uint64_t>(diff) << 1) ^ static_cast<std::uint64_t>(diff >> 63)) + 1;
+}
+
+/// @brief decode a fanin encoded by encodeFanin()
+static IntType decodeFanin(IndexType nodeIdx, std::uint64_t code)
+{
+    if (code == 0)
+    {
+        return -1;
+    }
+    std::uint64_t zigzag = code - 1;
+    std::int64_t diff = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+    return static_cast<IntType>(static_cast<std::int64_t>(nodeIdx) - diff);
+}
+
+/// @brief append the record of one node
+static void writeRecord(ByteWriter &out, const TrajectoryGraph &graph, IndexType nodeIdx)
+{
+    out.writeVarint(graph.nodeTypes[nodeIdx]);
+    out.writeVarint(encodeFanin(nodeIdx, graph.fanin0[nodeIdx]));
+    out.writeVarint(encodeFanin(nodeIdx, graph.fanin1[nodeIdx]));
+    out.writeVarint(graph.levels[nodeIdx]);
+}
+
+/// @brief read the record of one node into the graph
+/// @return if successful
+static bool readRecord(ByteReader &in, TrajectoryGraph &graph, IndexType nodeIdx)
+{
+    std::uint64_t nodeType = 0, code0 = 0, code1 = 0, level = 0;
+    if (!in.readVarint(nodeType) || !in.readVarint(code0) || !in.readVarint(code1) || !in.readVarint(level))
+    {
+        return false;
+    }
+    graph.nodeTypes[nodeIdx] = static_cast<IntType>(nodeType);
+    graph.fanin0[nodeIdx] = decodeFanin(nodeIdx, code0);
+    graph.fanin1[nodeIdx] = decodeFanin(nodeIdx, code1);
+    graph.levels[nodeIdx] = static_cast<IntType>(level);
+    return true;
+}
+
+/// @brief whether a node differs between two graphs. Nodes past the end of the old graph always differ
+static bool nodeChanged(const TrajectoryGraph &before, const TrajectoryGraph &after, IndexType nodeIdx)
+{
+    return nodeIdx >= before.numNodes()
+        || before.nodeTypes[nodeIdx] != after.nodeTypes[nodeIdx]
+        || before.fanin0[nodeIdx] != after.fanin0[nodeIdx]
+        || before.fanin1[nodeIdx] != after.fanin1[nodeIdx]
+        || before.levels[nodeIdx] != after.levels[nodeIdx];
+}
+
+/// @brief read the header of a step and skip or apply its delta
+/// @param first: the reader at the start of the step
+/// @param second: the action
+/// @param third: the reward
+/// @param fourth: the graph to apply the delta to. nullptr to skip it
+/// @return if successful
+static bool readStep(ByteReader &in, IntType &action, RealType &reward, TrajectoryGraph *graph)
+{
+    std::int64_t signedAction = 0;
+    std::uint64_t numNodes = 0, numChanged = 0;
+    if (!in.readSignedVarint(signedAction) || !in.read(reward) || !in.readVarint(numNodes) || !in.readVarint(numChanged)
+            || numChanged > numNodes || numNodes > static_cast<std::uint64_t>(std::numeric_limits<IntType>::max()))
+    {
+        return false;
+    }
+    action = static_cast<IntType>(signedAction);
+    TrajectoryGraph scratch;
+    if (graph == nullptr)
+    {
+        // The records are varints, so skipping them still reads them
+        scratch.resize(1);
+    }
+    else
+    {
+        graph->resize(numNodes);
+    }
+    std::uint64_t nodeIdx = 0;
+    for (std::uint64_t idx = 0; idx < numChanged; ++idx)
+    {
+        std::uint64_t gap = 0;
+        if (!in.readVarint(gap))
+        {
+            return false;
+        }
+        nodeIdx = idx == 0 ? gap : nodeIdx + 1 + gap;
+        if (nodeIdx >= numNodes)
+        {
+            return false;
+        }
+        bool ok = graph == nullptr ? readRecord(in, scratch, 0) : readRecord(in, *graph, nodeIdx);
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief read the base graph
+/// @param first: the reader at the start of the block
+/// @param second: the graph. nullptr to skip it
+/// @return if successful
+static bool readBase(ByteReader &in, TrajectoryGraph *graph)
+{
+    std::uint64_t numNodes = 0;
+    if (!in.readVarint(numNodes) || numNodes > in.remaining())
+    {
+        return false;
+    }
+    TrajectoryGraph scratch;
+    scratch.resize(1);
+    if (graph != nullptr)
+    {
+        graph->resize(0);
+        graph->resize(numNodes);
+    }
+    for (std::uint64_t nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        bool ok = graph == nullptr ? readRecord(in, scratch, 0) : readRecord(in, *graph, nodeIdx);
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*------------------------------*/
+/* Writer                       */
+/*------------------------------*/
+
+bool TrajectoryWriter::openShard()
+{
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "-%05d.abctrj", _shardIdx++);
+    _shardPath = _prefix + suffix;
+    std::string tmpPath = _shardPath + ".tmp";
+    _fp = fopen(tmpPath.c_str(), "wb");
+    if (_fp == nullptr)
+    {
+        ERR("%s: cannot open %s \n", __FUNCTION__, tmpPath.c_str());
+        return false;
+    }
+    std::uint32_t reserved = 0;
+    bool ok = fwrite(TRAJECTORY_MAGIC, 1, sizeof(TRAJECTORY_MAGIC), _fp) == sizeof(TRAJECTORY_MAGIC);
+    ok = ok && fwrite(&TRAJECTORY_VERSION, sizeof(TRAJECTORY_VERSION), 1, _fp) == 1;
+    ok = ok && fwrite(&reserved, sizeof(reserved), 1, _fp) == 1;
+    _shardOffset = TRAJECTORY_HEADER_SIZE;
+    _index.clear();
+    if (!ok)
+    {
+        ERR("%s: cannot write %s \n", __FUNCTION__, tmpPath.c_str());
+    }
+    return ok;
+}
+
+void TrajectoryEncoder::begin(const std::vector<AigNode> &nodes)
+{
+    _prev.assign(nodes);
+    _block.release();
+    _block.writeVarint(_prev.numNodes());
+    for (IndexType nodeIdx = 0; nodeIdx < _prev.numNodes(); ++nodeIdx)
+    {
+        writeRecord(_block, _prev, nodeIdx);
+    }
+    _numSteps = 0;
+}
+
+void TrajectoryEncoder::addStep(IntType action, RealType reward, const std::vector<AigNode> &nodes)
+{
+    _cur.assign(nodes);
+    std::vector<IndexType> changed;
+    for (IndexType nodeIdx = 0; nodeIdx < _cur.numNodes(); ++nodeIdx)
+    {
+        if (nodeChanged(_prev, _cur, nodeIdx))
+        {
+            changed.push_back(nodeIdx);
+        }
+    }
+    _block.writeSignedVarint(action);
+    _block.write(reward);
+    _block.writeVarint(_cur.numNodes());
+    _block.writeVarint(changed.size());
+    for (IndexType idx = 0; idx < changed.size(); ++idx)
+    {
+        _block.writeVarint(idx == 0 ? changed[idx] : changed[idx] - changed[idx - 1] - 1);
+        writeRecord(_block, _cur, changed[idx]);
+    }
+    std::swap(_prev, _cur);
+    ++_numSteps;
+}
+
+bool TrajectoryWriter::begin(const std::vector<AigNode> &nodes)
+{
+    if (_inTrajectory)
+    {
+        ERR("%s: a trajectory is already open \n", __FUNCTION__);
+        return false;
+    }
+    _encoder.begin(nodes);
+    _inTrajectory = true;
+    return true;
+}
+
+bool TrajectoryWriter::addStep(IntType action, RealType reward, const std::vector<AigNode> &nodes)
+{
+    if (!_inTrajectory)
+    {
+        ERR("%s: no trajectory is open \n", __FUNCTION__);
+        return false;
+    }
+    _encoder.addStep(action, reward, nodes);
+    return true;
+}
+
+bool TrajectoryWriter::end()
+{
+    if (!_inTrajectory)
+    {
+        ERR("%s: no trajectory is open \n", __FUNCTION__);
+        return false;
+    }
+    _inTrajectory = false;
+    IndexType numSteps = _encoder.numSteps();
+    return this->appendBlock(_encoder.release(), numSteps);
+}
+
+bool TrajectoryWriter::appendBlock(const std::string &raw, IndexType numSteps)
+{
+    if (_fp == nullptr && !this->openShard())
+    {
+        return false;
+    }
+    TrajectoryIndexEntry entry;
+    entry.offset = _shardOffset;
+    entry.rawSize = raw.size();
+    entry.numSteps = numSteps;
+    entry.compressed = 0;
+    std::string stored;
+    if (_level > 0)
+    {
+        uLongf storedSize = compressBound(raw.size());
+        stored.resize(storedSize);
+        if (compress2(reinterpret_cast<Bytef *>(&stored[0]), &storedSize, reinterpret_cast<const Bytef *>(raw.data()), raw.size(), _level) == Z_OK
+                && storedSize < raw.size())
+        {
+            stored.resize(storedSize);
+            entry.compressed = 1;
+        }
+    }
+    const std::string &bytes = entry.compressed ? stored : raw;
+    entry.storedSize = bytes.size();
+    if (fwrite(bytes.data(), 1, bytes.size(), _fp) != bytes.size())
+    {
+        ERR("%s: cannot write %s \n", __FUNCTION__, _shardPath.c_str());
+        return false;
+    }
+    _shardOffset += bytes.size();
+    _index.push_back(entry);
+    ++_numTrajectories;
+    if (_shardOffset >= _shardBytes)
+    {
+        return this->close();
+    }
+    return true;
+}
+
+bool TrajectoryWriter::close()
+{
+    if (_fp == nullptr)
+    {
+        return true;
+    }
+    // The index is aligned so readers can use it in place
+    std::uint64_t indexOffset = (_shardOffset + 7) / 8 * 8;
+    std::uint64_t numEntries = _index.size();
+    const char padding[8] = { 0 };
+    bool ok = fwrite(padding, 1, indexOffset - _shardOffset, _fp) == indexOffset - _shardOffset;
+    ok = ok && fwrite(_index.data(), sizeof(TrajectoryIndexEntry), _index.size(), _fp) == _index.size();
+    ok = ok && fwrite(&indexOffset, sizeof(indexOffset), 1, _fp) == 1;
+    ok = ok && fwrite(&numEntries, sizeof(numEntries), 1, _fp) == 1;
+    ok = ok && fwrite(TRAJECTORY_MAGIC, 1, sizeof(TRAJECTORY_MAGIC), _fp) == sizeof(TRAJECTORY_MAGIC);
+    ok = (fclose(_fp) == 0) && ok;
+    _fp = nullptr;
+    std::string tmpPath = _shardPath + ".tmp";
+    if (!ok || std::rename(tmpPath.c_str(), _shardPath.c_str()) != 0)
+    {
+        ERR("%s: cannot write %s \n", __FUNCTION__, _shardPath.c_str());
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    _shards.push_back(_shardPath);
+    return true;
+}
+
+/*------------------------------*/
+/* Reader                       */
+/*------------------------------*/
+
+bool Trajectory::index(IndexType numSteps)
+{
+    ByteReader in(this->data(), _size);
+    if (!readBase(in, nullptr))
+    {
+        return false;
+    }
+    _stepOffsets.resize(numSteps);
+    _actions.resize(numSteps);
+    _rewards.resize(numSteps);
+    for (IndexType step = 0; step < numSteps; ++step)
+    {
+        _stepOffsets[step] = _size - in.remaining();
+        if (!readStep(in, _actions[step], _rewards[step], nullptr))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Trajectory::graph(IndexType step, TrajectoryGraph &graph)
+{
+    if (step > this->numSteps())
+    {
+        ERR("%s: step %u is past the %u steps \n", __FUNCTION__, step, this->numSteps());
+        return false;
+    }
+    if (_cacheStep < 0 || step < static_cast<IndexType>(_cacheStep))
+    {
+        ByteReader in(this->data(), _size);
+        if (!readBase(in, &_cache))
+        {
+            _cacheStep = -1;
+            return false;
+        }
+        _cacheStep = 0;
+    }
+    for (IndexType next = _cacheStep; next < step; ++next)
+    {
+        ByteReader in(this->data() + _stepOffsets[next], _size - _stepOffsets[next]);
+        IntType action = 0;
+        RealType reward = 0;
+        if (!readStep(in, action, reward, &_cache))
+        {
+            _cacheStep = -1;
+            return false;
+        }
+    }
+    _cacheStep = step;
+    graph = _cache;
+    return true;
+}
+
+bool TrajectoryReader::open(const std::vector<std::string> &shards)
+{
+    _shards.clear();
+    _firstIdx.assign(1, 0);
+    for (const std::string &path : shards)
+    {
+        Shard shard;
+        shard.file = std::make_shared<MappedFile>();
+        if (!shard.file->open(path))
+        {
+            return false;
+        }
+        const char *data = shard.file->data();
+        std::size_t size = shard.file->size();
+        std::uint32_t version = 0;
+        std::uint64_t indexOffset = 0, numEntries = 0;
+        bool ok = size >= TRAJECTORY_HEADER_SIZE + TRAJECTORY_TRAILER_SIZE
+            && std::memcmp(data, TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) == 0
+            && std::memcmp(data + size - sizeof(TRAJECTORY_MAGIC), TRAJECTORY_MAGIC, sizeof(TRAJECTORY_MAGIC)) == 0;
+        if (ok)
+        {
+            std::memcpy(&version, data + sizeof(TRAJECTORY_MAGIC), sizeof(version));
+            std::memcpy(&indexOffset, data + size - TRAJECTORY_TRAILER_SIZE, sizeof(indexOffset));
+            std::memcpy(&numEntries, data + size - TRAJECTORY_TRAILER_SIZE + sizeof(indexOffset), sizeof(numEntries));
+            std::size_t indexEnd = size - TRAJECTORY_TRAILER_SIZE;
+            ok = version >= 1 && version <= TRAJECTORY_VERSION && indexOffset % 8 == 0 && indexOffset <= indexEnd
+                && numEntries == (indexEnd - indexOffset) / sizeof(TrajectoryIndexEntry);
+        }
+        if (ok)
+        {
+            shard.index = reinterpret_cast<const TrajectoryIndexEntry *>(data + indexOffset);
+            shard.numEntries = numEntries;
+            for (std::size_t idx = 0; idx < numEntries && ok; ++idx)
+            {
+                const TrajectoryIndexEntry &entry = shard.index[idx];
+                ok = entry.offset >= TRAJECTORY_HEADER_SIZE && entry.offset <= indexOffset && entry.storedSize <= indexOffset - entry.offset
+                    && (entry.compressed || entry.rawSize == entry.storedSize);
+            }
+        }
+        if (!ok)
+        {
+            ERR("%s: %s is not a complete trajectory shard of a supported version \n", __FUNCTION__, path.c_str());
+            return false;
+        }
+        _firstIdx.push_back(_firstIdx.back() + numEntries);
+        _shards.push_back(std::move(shard));
+    }
+    return true;
+}
+
+bool TrajectoryReader::load(IndexType idx, Trajectory &traj) const
+{
+    if (idx >= this->numTrajectories())
+    {
+        ERR("%s: trajectory %u out of %u \n", __FUNCTION__, idx, this->numTrajectories());
+        return false;
+    }
+    IndexType shardIdx = std::upper_bound(_firstIdx.begin(), _firstIdx.end(), idx) - _firstIdx.begin() - 1;
+    const Shard &shard = _shards[shardIdx];
+    const TrajectoryIndexEntry &entry = shard.index[idx - _firstIdx[shardIdx]];
+    const char *stored = shard.file->data() + entry.offset;
+    traj = Trajectory();
+    traj._size = entry.rawSize;
+    if (entry.compressed)
+    {
+        traj._owned.resize(entry.rawSize);
+        uLongf rawSize = entry.rawSize;
+        if (uncompress(reinterpret_cast<Bytef *>(&traj._owned[0]), &rawSize, reinterpret_cast<const Bytef *>(stored), entry.storedSize) != Z_OK
+                || rawSize != entry.rawSize)
+        {
+            ERR("%s: cannot inflate trajectory %u \n", __FUNCTION__, idx);
+            return false;
+        }
+    }
+    else
+    {
+        traj._file = shard.file;
+        traj._raw = stored;
+    }
+    if (!traj.index(entry.numSteps))
+    {
+        ERR("%s: trajectory %u is corrupted \n", __FUNCTION__, idx);
+        return false;
+    }
+    return true;
+}
+
+PROJECT_NAMESPACE_END
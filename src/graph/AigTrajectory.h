@@ -0,0 +1,208 @@
+/**
+ * @file AigTrajectory.h
+ * @brief Sharded binary files of graph trajectories: a base graph and per-step deltas, block compressed
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_TRAJECTORY_H_
+#define ABC_PY_AIG_TRAJECTORY_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "interface/AigNode.h"
+#include "util/ByteStream.h"
+#include "util/CheckpointFile.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::TrajectoryGraph
+/// @brief One graph of a trajectory in columns, indexed by the node index of the mirror
+struct TrajectoryGraph
+{
+    std::vector<IntType> nodeTypes; ///< The AigNodeType of each node. AIG_NODE_NUMBER for an empty slot
+    std::vector<IntType> fanin0; ///< The fanin 0 of each node. -1 if none
+    std::vector<IntType> fanin1; ///< The fanin 1 of each node. -1 if none
+    std::vector<IntType> levels; ///< The logic level of each node
+    /// @brief the number of nodes
+    IndexType numNodes() const { return nodeTypes.size(); }
+    /// @brief take the columns of a mirrored graph
+    void assign(const std::vector<AigNode> &nodes);
+    /// @brief resize all the columns
+    void resize(IndexType numNodes);
+};
+
+/// @class ABC_PY::TrajectoryIndexEntry
+/// @brief An entry of the index footer of a shard, read in place from the mapping
+struct TrajectoryIndexEntry
+{
+    std::uint64_t offset; ///< The offset of the block in the shard
+    std::uint64_t storedSize; ///< The number of bytes stored
+    std::uint64_t rawSize; ///< The number of bytes after decompression
+    std::uint32_t numSteps; ///< The number of steps
+    std::uint32_t compressed; ///< Whether the block is deflated. Blocks that do not shrink are stored raw
+};
+
+/// @class ABC_PY::TrajectoryEncoder
+/// @brief Build the uncompressed block of one trajectory: the base graph, then for each step the action,
+/// the reward and the delta to the previous graph, which lists the changed nodes with gap-coded indices.
+/// Integers are varints and fanins are stored relative to their node, so the typical record takes a few bytes
+class TrajectoryEncoder
+{
+    public:
+        explicit TrajectoryEncoder() = default;
+        /// @brief start a trajectory, dropping the open one
+        /// @param the mirrored base graph
+        void begin(const std::vector<AigNode> &nodes);
+        /// @brief record a step
+        /// @param first: the action
+        /// @param second: the reward
+        /// @param third: the mirrored graph after the action
+        void addStep(IntType action, RealType reward, const std::vector<AigNode> &nodes);
+        /// @brief the number of steps recorded
+        IndexType numSteps() const { return _numSteps; }
+        /// @brief take the block, leaving the encoder empty
+        std::string release() { _numSteps = 0; return _block.release(); }
+    private:
+        ByteWriter _block; ///< The block
+        TrajectoryGraph _prev; ///< The last graph
+        TrajectoryGraph _cur; ///< The scratch graph
+        IndexType _numSteps = 0; ///< The number of steps
+};
+
+/// @class ABC_PY::TrajectoryWriter
+/// @brief Write trajectories into shards named <prefix>-NNNNN.abctrj. Each trajectory is one TrajectoryEncoder block, deflated.
+/// A shard is closed once it reaches the shard size, writing the index footer; it only appears under its
+/// final name when complete.
+class TrajectoryWriter
+{
+    public:
+        explicit TrajectoryWriter() = default;
+        /// @brief close the open shard
+        ~TrajectoryWriter() { this->close(); }
+        TrajectoryWriter(const TrajectoryWriter &) = delete;
+        TrajectoryWriter & operator=(const TrajectoryWriter &) = delete;
+        /// @brief set the path prefix of the shards
+        void setPrefix(const std::string &prefix) { _prefix = prefix; }
+        /// @brief set the size after which a shard is closed and the next one started
+        void setShardBytes(std::uint64_t shardBytes) { _shardBytes = shardBytes; }
+        /// @brief set the zlib level of the blocks. 0 stores them raw
+        void setCompressionLevel(IntType level) { _level = level; }
+        /// @brief start a trajectory
+        /// @param the mirrored base graph
+        /// @return false if a trajectory is already open
+        bool begin(const std::vector<AigNode> &nodes);
+        /// @brief record a step
+        /// @param first: the action
+        /// @param second: the reward
+        /// @param third: the mirrored graph after the action
+        /// @return false if no trajectory is open
+        bool addStep(IntType action, RealType reward, const std::vector<AigNode> &nodes);
+        /// @brief finish the trajectory and write its block
+        /// @return if successful
+        bool end();
+        /// @brief write a block built elsewhere by a TrajectoryEncoder
+        /// @param first: the uncompressed block
+        /// @param second: the number of steps in the block
+        /// @return if successful
+        bool appendBlock(const std::string &raw, IndexType numSteps);
+        /// @brief close the open shard, writing its index footer
+        /// @return if successful
+        bool close();
+        /// @brief the shards completed so far
+        const std::vector<std::string> & shards() const { return _shards; }
+        /// @brief the number of trajectories written
+        IndexType numTrajectories() const { return _numTrajectories; }
+        /// @brief set the number of the next shard, to continue a set of shards
+        void setShardIndex(IntType shardIdx) { _shardIdx = shardIdx; }
+    private:
+        /// @brief open the next shard
+        bool openShard();
+    private:
+        std::string _prefix = "trajectory"; ///< The path prefix of the shards
+        std::uint64_t _shardBytes = 256 << 20; ///< The size after which a shard is closed
+        IntType _level = 6; ///< The zlib level
+        FILE *_fp = nullptr; ///< The open shard
+        std::string _shardPath; ///< The final name of the open shard
+        std::uint64_t _shardOffset = 0; ///< The bytes written to the open shard
+        IntType _shardIdx = 0; ///< The index of the next shard
+        std::vector<TrajectoryIndexEntry> _index; ///< The index of the open shard
+        std::vector<std::string> _shards; ///< The completed shards
+        TrajectoryEncoder _encoder; ///< The block of the open trajectory
+        bool _inTrajectory = false; ///< Whether a trajectory is open
+        IndexType _numTrajectories = 0; ///< The number of trajectories written
+};
+
+/// @class ABC_PY::Trajectory
+/// @brief One trajectory loaded from a shard. Raw blocks are read in place from the mapping.
+/// The graphs are rebuilt by applying the deltas; stepping forward from the last graph asked for only applies the new ones
+class Trajectory
+{
+    friend class TrajectoryReader;
+    public:
+        explicit Trajectory() = default;
+        /// @brief the number of steps. There are numSteps() + 1 graphs
+        IndexType numSteps() const { return _actions.size(); }
+        /// @brief the action of each step
+        const std::vector<IntType> & actions() const { return _actions; }
+        /// @brief the reward of each step
+        const std::vector<RealType> & rewards() const { return _rewards; }
+        /// @brief get a graph
+        /// @param first: 0 for the base graph, t for the graph after step t
+        /// @param second: the graph
+        /// @return if successful
+        bool graph(IndexType step, TrajectoryGraph &graph);
+    private:
+        /// @brief parse the actions and rewards and locate the steps
+        /// @param the number of steps in the block
+        /// @return if the block is well formed
+        bool index(IndexType numSteps);
+        /// @brief the block, either decompressed or in the mapping
+        const char * data() const { return _owned.empty() ? _raw : _owned.data(); }
+    private:
+        std::shared_ptr<MappedFile> _file; ///< Keeps the mapping of a raw block alive
+        std::string _owned; ///< The decompressed block
+        const char *_raw = nullptr; ///< The raw block in the mapping
+        std::size_t _size = 0; ///< The bytes of the block
+        std::vector<std::size_t> _stepOffsets; ///< The offset of each step in the block
+        std::vector<IntType> _actions; ///< The actions
+        std::vector<RealType> _rewards; ///< The rewards
+        TrajectoryGraph _cache; ///< The last graph rebuilt
+        IntType _cacheStep = -1; ///< The step of the cached graph. -1 if none
+};
+
+/// @class ABC_PY::TrajectoryReader
+/// @brief Random access to the trajectories of a set of shards. The shards are memory-mapped and their index footers used in place
+class TrajectoryReader
+{
+    public:
+        explicit TrajectoryReader() = default;
+        /// @brief map the shards
+        /// @param the shard files
+        /// @return if all of them are valid
+        bool open(const std::vector<std::string> &shards);
+        /// @brief the number of trajectories over all the shards
+        IndexType numTrajectories() const { return _firstIdx.empty() ? 0 : _firstIdx.back(); }
+        /// @brief load one trajectory
+        /// @param first: the index over all the shards
+        /// @param second: the trajectory
+        /// @return if successful
+        bool load(IndexType idx, Trajectory &traj) const;
+    private:
+        /// @class ABC_PY::TrajectoryReader::Shard
+        /// @brief A mapped shard
+        struct Shard
+        {
+            std::shared_ptr<MappedFile> file; ///< The mapping
+            const TrajectoryIndexEntry *index = nullptr; ///< The index footer in the mapping
+            std::size_t numEntries = 0; ///< The number of trajectories
+        };
+        std::vector<Shard> _shards; ///< The shards
+        std::vector<IndexType> _firstIdx; ///< The index of the first trajectory of each shard, then the total
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_TRAJECTORY_H_
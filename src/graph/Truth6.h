@@ -0,0 +1,65 @@
+/**
+ * @file Truth6.h
+ * @brief Truth tables of up to 6 variables packed in one 64-bit word
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_TRUTH6_H_
+#define ABC_PY_TRUTH6_H_
+
+#include <cstdint>
+#include "global/namespace.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+using Truth6 = std::uint64_t;
+
+/// @brief the truth tables of the elementary variables
+constexpr Truth6 TRUTH6_VARS[6] = {
+    0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL };
+
+/// @brief the masks to swap two adjacent variables: kept bits, bits moving up, bits moving down
+constexpr Truth6 TRUTH6_SWAP_MASKS[5][3] = {
+    { 0x9999999999999999ULL, 0x2222222222222222ULL, 0x4444444444444444ULL },
+    { 0xC3C3C3C3C3C3C3C3ULL, 0x0C0C0C0C0C0C0C0CULL, 0x3030303030303030ULL },
+    { 0xF00FF00FF00FF00FULL, 0x00F000F000F000F0ULL, 0x0F000F000F000F00ULL },
+    { 0xFF0000FFFF0000FFULL, 0x0000FF000000FF00ULL, 0x00FF000000FF0000ULL },
+    { 0xFFFF00000000FFFFULL, 0x00000000FFFF0000ULL, 0x0000FFFF00000000ULL } };
+
+/// @brief swap the variables var and var + 1
+inline Truth6 truth6SwapAdjacent(Truth6 truth, int var)
+{
+    return (truth & TRUTH6_SWAP_MASKS[var][0])
+        | ((truth & TRUTH6_SWAP_MASKS[var][1]) << (1 << var))
+        | ((truth & TRUTH6_SWAP_MASKS[var][2]) >> (1 << var));
+}
+
+/// @brief move the variables of a truth table to new positions.
+/// Variable i moves to positions[i]. The positions must be increasing, and the truth table must not depend on the variables >= numVars
+/// @param first: the truth table
+/// @param second: the number of variables
+/// @param third: the new position of each variable
+inline Truth6 truth6Stretch(Truth6 truth, int numVars, const int *positions)
+{
+    for (int var = numVars - 1; var >= 0; --var)
+    {
+        for (int pos = var; pos < positions[var]; ++pos)
+        {
+            truth = truth6SwapAdjacent(truth, pos);
+        }
+    }
+    return truth;
+}
+
+/// @brief whether the truth table depends on a variable
+inline bool truth6HasVar(Truth6 truth, int var)
+{
+    int shift = 1 << var;
+    return ((truth >> shift) & ~TRUTH6_VARS[var]) != (truth & ~TRUTH6_VARS[var]);
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_TRUTH6_H_
@@ -0,0 +1,40 @@
+/**
+ * @file AbcCommand.h
+ * @brief The ABC procedures to start the framework and execute commands in it
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_ABC_COMMAND_H_
+#define ABC_PY_ABC_COMMAND_H_
+
+#include <abc_src/base/main/mainInt.h>
+
+#if defined(ABC_NAMESPACE)
+namespace ABC_NAMESPACE
+{
+#elif defined(__cplusplus)
+extern "C"
+{
+#endif
+
+// procedures to start and stop the ABC framework
+// (should be called before and after the ABC procedures are called)
+void   Abc_Start();
+void   Abc_Stop();
+
+// procedures to get the ABC framework and execute commands in it
+//typedef struct Abc_Frame_t_ Abc_Frame_t;
+
+Abc_Frame_t_ * Abc_FrameGetGlobalFrame();
+int    Cmd_CommandExecute( Abc_Frame_t_ * pAbc, const char * sCommand );
+
+
+#if defined(ABC_NAMESPACE)
+}
+using namespace ABC_NAMESPACE;
+#elif defined(__cplusplus)
+}
+#endif
+
+#endif //ABC_PY_ABC_COMMAND_H_
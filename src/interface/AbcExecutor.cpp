@@ -0,0 +1,769 @@
+#include "AbcExecutor.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "util/ByteStream.h"
+#include "util/Metrics.h"
+#include "graph/AigTrajectory.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::AsyncFrameHeader
+/// @brief The header of the messages between the executor and a worker.
+/// The code is the AsyncOp of a request, and 1 or 0 for whether the call of a response succeeded
+struct AsyncFrameHeader
+{
+    std::uint64_t ticket; ///< The ticket of the call
+    std::int32_t code; ///< The call or the success
+    std::uint32_t size; ///< The number of bytes that follow
+};
+
+/// @brief read exactly size bytes
+/// @return false on the end of the stream or an error
+static bool readAll(int fd, void *data, std::size_t size)
+{
+    char *ptr = static_cast<char *>(data);
+    while (size > 0)
+    {
+        ssize_t n = ::read(fd, ptr, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        ptr += n;
+        size -= n;
+    }
+    return true;
+}
+
+/// @brief send exactly size bytes. A closed peer is an error, not a SIGPIPE
+static bool sendAll(int fd, const void *data, std::size_t size)
+{
+    const char *ptr = static_cast<const char *>(data);
+    while (size > 0)
+    {
+        ssize_t n = ::send(fd, ptr, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        ptr += n;
+        size -= n;
+    }
+    return true;
+}
+
+/// @brief send the pid of a new worker, with its socket attached unless the worker could not be started
+/// @return if sent
+static bool sendWorker(int fd, pid_t pid, int workerFd)
+{
+    struct msghdr msg = {};
+    struct iovec iov = { &pid, sizeof(pid) };
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    if (workerFd >= 0)
+    {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &workerFd, sizeof(int));
+    }
+    ssize_t n;
+    while ((n = ::sendmsg(fd, &msg, MSG_NOSIGNAL)) < 0 && errno == EINTR) {}
+    return n == static_cast<ssize_t>(sizeof(pid));
+}
+
+/// @brief receive a worker sent by sendWorker()
+/// @param first: the socket to the spawner
+/// @param second: the pid of the worker. -1 if it could not be started
+/// @return the socket of the worker. -1 if none
+static int receiveWorker(int fd, pid_t &pid)
+{
+    pid = -1;
+    struct msghdr msg = {};
+    struct iovec iov = { &pid, sizeof(pid) };
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    char control[CMSG_SPACE(sizeof(int))] = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    ssize_t n;
+    while ((n = ::recvmsg(fd, &msg, MSG_CMSG_CLOEXEC)) < 0 && errno == EINTR) {}
+    if (n != static_cast<ssize_t>(sizeof(pid)))
+    {
+        pid = -1;
+        return -1;
+    }
+    int workerFd = -1;
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+    {
+        std::memcpy(&workerFd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    return workerFd;
+}
+
+/// @brief encode the step result of the last action
+static void encodeStep(ByteWriter &out, const StepResult &step)
+{
+    out.write<std::int32_t>(step.success());
+    out.write(step.numAndBefore());
+    out.write(step.numAndAfter());
+    out.write(step.levBefore());
+    out.write(step.levAfter());
+    out.write(step.runtime());
+    out.write(step.numCreated());
+    out.write(step.numRemoved());
+    out.write<std::int32_t>(step.timedOut());
+}
+
+/// @brief run one call on the environment of the worker
+/// @param first: the environment
+/// @param second: the call
+/// @param third: the integer arguments
+/// @param fourth: the file name of read
+/// @param fifth: whether the call succeeded
+/// @return the encoded result
+static std::string runCall(AbcInterface &abc, AsyncOp op, const std::vector<IntType> &args, const std::string &text, bool &success)
+{
+    ByteWriter out;
+    success = false;
+    switch (op)
+    {
+        case AsyncOp::READ:
+            success = abc.read(text);
+            break;
+        case AsyncOp::BALANCE:
+            if (args.size() == 4)
+            {
+                success = abc.balance(args[0], args[1], args[2], args[3]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::RESUB:
+            if (args.size() == 5)
+            {
+                success = abc.resub(args[0], args[1], args[2], args[3], args[4]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::REWRITE:
+            if (args.size() == 2)
+            {
+                success = abc.rewrite(args[0], args[1]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::REFACTOR:
+            if (args.size() == 3)
+            {
+                success = abc.refactor(args[0], args[1], args[2]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::COMPRESS2RS:
+            success = abc.compress2rs();
+            encodeStep(out, abc.lastStep());
+            break;
+        case AsyncOp::AIG_STATS:
+        {
+            AigStats stats = abc.aigStats();
+            out.write(stats.numIn());
+            out.write(stats.numOut());
+            out.write(stats.numLat());
+            out.write(stats.numAnd());
+            out.write(stats.lev());
+            success = true;
+            break;
+        }
+        case AsyncOp::GRAPH:
+        {
+            abc.updateGraph();
+            const std::vector<AigNode> &nodes = abc.aigNodes();
+            // The buffers live until the next updateGraph(), so they are drawn from the arena of the mirror
+            ArenaAllocator<IntType> alloc(abc.graphArena());
+            ArenaVector<IntType> nodeTypes(nodes.size(), AIG_NODE_NUMBER, alloc);
+            ArenaVector<IntType> levels(nodes.size(), 0, alloc);
+            ArenaVector<IntType> edgeSrc(alloc), edgeDst(alloc);
+            edgeSrc.reserve(2 * nodes.size());
+            edgeDst.reserve(2 * nodes.size());
+            for (IndexType nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+            {
+                const AigNode &node = nodes[nodeIdx];
+                if (!node.isValid())
+                {
+                    continue;
+                }
+                nodeTypes[nodeIdx] = node.nodeType();
+                levels[nodeIdx] = node.level();
+                if (node.hasFanin0())
+                {
+                    edgeSrc.push_back(node.fanin0());
+                    edgeDst.push_back(nodeIdx);
+                }
+                if (node.hasFanin1())
+                {
+                    edgeSrc.push_back(node.fanin1());
+                    edgeDst.push_back(nodeIdx);
+                }
+            }
+            out.writeVector(nodeTypes);
+            out.writeVector(levels);
+            out.writeVector(edgeSrc);
+            out.writeVector(edgeDst);
+            success = true;
+            break;
+        }
+        case AsyncOp::EPISODE:
+        {
+            if (!abc.read(text))
+            {
+                break;
+            }
+            // The reward of a step is the number of AND nodes it removed
+            TrajectoryEncoder encoder;
+            abc.updateGraph();
+            encoder.begin(abc.aigNodes());
+            success = true;
+            for (IntType action : args)
+            {
+                if (!abc.takeAction(action))
+                {
+                    success = false;
+                    break;
+                }
+                abc.updateGraph();
+                const StepResult &step = abc.lastStep();
+                encoder.addStep(action, step.numAndBefore() - step.numAndAfter(), abc.aigNodes());
+            }
+            if (success)
+            {
+                out.write<std::uint32_t>(encoder.numSteps());
+                out.writeString(encoder.release());
+            }
+            break;
+        }
+        case AsyncOp::SWITCH:
+        {
+            std::size_t newline = text.find('\n');
+            if (args.size() != 1 || newline == std::string::npos)
+            {
+                break;
+            }
+            // The stage that failed tells the caller whether the network switched out was saved
+            std::string savePath = text.substr(0, newline);
+            std::string loadPath = text.substr(newline + 1);
+            if (!savePath.empty() && !abc.checkpoint(savePath))
+            {
+                out.write<std::int32_t>(0);
+                break;
+            }
+            success = args[0] == 0 ? abc.read(loadPath) : abc.restore(loadPath);
+            out.write<std::int32_t>(1);
+            break;
+        }
+        case AsyncOp::ACTION:
+            if (args.size() == 1)
+            {
+                success = abc.takeAction(args[0]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::GIA_BALANCE:
+            if (args.size() == 1)
+            {
+                success = abc.giaBalance(args[0]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::GIA_ACTION:
+            if (args.size() == 1)
+            {
+                success = abc.takeGiaAction(args[0]);
+                encodeStep(out, abc.lastStep());
+            }
+            break;
+        case AsyncOp::METRICS:
+            if (args.size() == 1)
+            {
+                out.writeString(MetricsRegistry::instance().render(static_cast<MetricsFormat>(args[0])));
+                success = true;
+            }
+            break;
+        default:
+            break;
+    }
+    return out.release();
+}
+
+/// @brief serve the calls of one environment until the executor closes the socket. Runs in the worker process
+static void workerLoop(int fd)
+{
+    AbcInterface abc;
+    abc.start();
+    bool hasNetwork = false;
+    while (true)
+    {
+        AsyncFrameHeader header;
+        if (!readAll(fd, &header, sizeof(header)))
+        {
+            break;
+        }
+        std::string body(header.size, '\0');
+        if (!readAll(fd, &body[0], header.size))
+        {
+            break;
+        }
+        ByteReader reader(body);
+        std::vector<IntType> args;
+        std::string text;
+        AsyncOp op = static_cast<AsyncOp>(header.code);
+        bool success = false;
+        std::string payload;
+        // Only the calls loading their own network, and the metrics, work before a network is loaded
+        bool loads = op == AsyncOp::READ || op == AsyncOp::EPISODE || op == AsyncOp::SWITCH;
+        if (reader.readVector(args) && reader.readString(text) && (loads || hasNetwork || op == AsyncOp::METRICS))
+        {
+            payload = runCall(abc, op, args, text, success);
+        }
+        hasNetwork = hasNetwork || (loads && success);
+        // A failed switch leaves no network, so the calls queued behind it fail instead of acting on the wrong one
+        hasNetwork = hasNetwork && (op != AsyncOp::SWITCH || success);
+        AsyncFrameHeader response = { header.ticket, success ? 1 : 0, static_cast<std::uint32_t>(payload.size()) };
+        if (!sendAll(fd, &response, sizeof(response)) || !sendAll(fd, payload.data(), payload.size()))
+        {
+            break;
+        }
+    }
+}
+
+/// @brief fork a worker for each byte received, and send it back with sendWorker(), until the executor closes the socket.
+/// Runs in the spawner process, which has a single thread, so no worker is forked while another thread holds a lock
+static void spawnerLoop(int fd)
+{
+    // The workers are children of the spawner, which reaps them as they exit
+    ::signal(SIGCHLD, SIG_IGN);
+    char request = 0;
+    while (readAll(fd, &request, 1))
+    {
+        int fds[2];
+        pid_t pid = -1;
+        bool paired = ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+        if (paired)
+        {
+            pid = ::fork();
+            if (pid == 0)
+            {
+                // Worker. Its actions fork and wait for children of their own
+                ::signal(SIGCHLD, SIG_DFL);
+                ::close(fd);
+                ::close(fds[0]);
+                workerLoop(fds[1]);
+                ::_exit(0);
+            }
+            ::close(fds[1]);
+        }
+        // The socket is duplicated into the executor by the message, so the spawner keeps no worker socket
+        bool sent = sendWorker(fd, pid, pid > 0 ? fds[0] : -1);
+        if (paired)
+        {
+            ::close(fds[0]);
+        }
+        if (!sent)
+        {
+            break;
+        }
+    }
+}
+
+AbcExecutor::AbcExecutor()
+{
+    _eventFd = ::eventfd(0, EFD_NONBLOCK);
+    _wakeFd = ::eventfd(0, EFD_NONBLOCK);
+    AssertMsg(_eventFd >= 0 && _wakeFd >= 0, "Cannot create the event fds of the executor \n");
+    // Fork the spawner before the completion thread starts. The workers are forked from it rather than from here,
+    // where the threads of the callers, e.g. the stages of a pipeline, may hold locks the workers would inherit
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0)
+    {
+        _spawnerPid = ::fork();
+        if (_spawnerPid == 0)
+        {
+            ::close(fds[0]);
+            ::close(_eventFd);
+            ::close(_wakeFd);
+            spawnerLoop(fds[1]);
+            ::_exit(0);
+        }
+        ::close(fds[1]);
+        if (_spawnerPid > 0)
+        {
+            _spawnerFd = fds[0];
+        }
+        else
+        {
+            ::close(fds[0]);
+        }
+    }
+    if (_spawnerFd < 0)
+    {
+        ERR("%s: cannot start the spawner of the workers \n", __FUNCTION__);
+    }
+    _thread = std::thread([this]() { this->completionLoop(); });
+}
+
+AbcExecutor::~AbcExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    std::uint64_t one = 1;
+    ssize_t rc = ::write(_wakeFd, &one, sizeof(one));
+    (void)rc;
+    _thread.join();
+    for (auto &worker : _workers)
+    {
+        if (worker->fd >= 0)
+        {
+            // The spawner reaps the workers
+            ::close(worker->fd);
+            ::kill(worker->pid, SIGKILL);
+        }
+    }
+    if (_spawnerFd >= 0)
+    {
+        // The spawner exits at the end of its stream
+        ::close(_spawnerFd);
+        ::waitpid(_spawnerPid, nullptr, 0);
+    }
+    ::close(_eventFd);
+    ::close(_wakeFd);
+}
+
+IntType AbcExecutor::createEnv()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const char request = 1;
+    pid_t pid = -1;
+    int fd = -1;
+    if (_spawnerFd >= 0 && sendAll(_spawnerFd, &request, 1))
+    {
+        fd = receiveWorker(_spawnerFd, pid);
+    }
+    if (fd < 0)
+    {
+        ERR("%s: cannot start a worker \n", __FUNCTION__);
+        return -1;
+    }
+    std::unique_ptr<Worker> worker(new Worker());
+    worker->pid = pid;
+    worker->fd = fd;
+    _workers.push_back(std::move(worker));
+    std::uint64_t one = 1;
+    ssize_t rc = ::write(_wakeFd, &one, sizeof(one));
+    (void)rc;
+    return _workers.size() - 1;
+}
+
+void AbcExecutor::closeEnv(IntType env)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (env < 0 || env >= static_cast<IntType>(_workers.size()) || _workers[env]->fd < 0)
+    {
+        return;
+    }
+    // The worker finishes the calls already sent, then sees the end of the stream and exits
+    _workers[env]->closing = true;
+    ::shutdown(_workers[env]->fd, SHUT_WR);
+}
+
+bool AbcExecutor::isAlive(IntType env)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return env >= 0 && env < static_cast<IntType>(_workers.size()) && _workers[env]->fd >= 0 && !_workers[env]->closing;
+}
+
+std::uint64_t AbcExecutor::submit(IntType env, AsyncOp op, const std::vector<IntType> &args, const std::string &text)
+{
+    Worker *worker = nullptr;
+    std::uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (env < 0 || env >= static_cast<IntType>(_workers.size()) || _workers[env]->fd < 0 || _workers[env]->closing)
+        {
+            ERR("%s: environment %d is not open \n", __FUNCTION__, env);
+            return 0;
+        }
+        worker = _workers[env].get();
+        ticket = _nextTicket++;
+        worker->pending.emplace_back(ticket, op);
+    }
+    ByteWriter body;
+    body.writeVector(args);
+    body.writeString(text);
+    AsyncFrameHeader header = { ticket, static_cast<std::int32_t>(op), static_cast<std::uint32_t>(body.data().size()) };
+    // A failed send means the worker died. The completion thread then fails the call
+    std::lock_guard<std::mutex> writeLock(worker->writeMutex);
+    if (worker->fd >= 0 && sendAll(worker->fd, &header, sizeof(header)))
+    {
+        sendAll(worker->fd, body.data().data(), body.data().size());
+    }
+    return ticket;
+}
+
+std::vector<AsyncCompletion> AbcExecutor::drain()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::uint64_t count = 0;
+    ssize_t rc = ::read(_eventFd, &count, sizeof(count));
+    (void)rc;
+    std::vector<AsyncCompletion> completions(std::make_move_iterator(_completions.begin()), std::make_move_iterator(_completions.end()));
+    _completions.clear();
+    return completions;
+}
+
+IntType AbcExecutor::numPending()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    IntType numPending = 0;
+    for (auto &worker : _workers)
+    {
+        numPending += worker->pending.size();
+    }
+    return numPending;
+}
+
+void AbcExecutor::notify()
+{
+    std::uint64_t one = 1;
+    ssize_t rc = ::write(_eventFd, &one, sizeof(one));
+    (void)rc;
+}
+
+void AbcExecutor::completionLoop()
+{
+    std::vector<struct pollfd> pollFds;
+    std::vector<IntType> pollEnvs;
+    std::vector<char> buffer(1 << 16);
+    while (true)
+    {
+        pollFds.clear();
+        pollEnvs.clear();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stop)
+            {
+                break;
+            }
+            pollFds.push_back({ _wakeFd, POLLIN, 0 });
+            for (IndexType env = 0; env < _workers.size(); ++env)
+            {
+                if (_workers[env]->fd >= 0)
+                {
+                    pollFds.push_back({ _workers[env]->fd, POLLIN, 0 });
+                    pollEnvs.push_back(env);
+                }
+            }
+        }
+        if (::poll(pollFds.data(), pollFds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            ERR("%s: poll failed \n", __FUNCTION__);
+            break;
+        }
+        if (pollFds[0].revents != 0)
+        {
+            std::uint64_t count = 0;
+            ssize_t rc = ::read(_wakeFd, &count, sizeof(count));
+            (void)rc;
+        }
+        IntType numAdded = 0;
+        for (IndexType idx = 1; idx < pollFds.size(); ++idx)
+        {
+            if (pollFds[idx].revents == 0)
+            {
+                continue;
+            }
+            // Only this thread closes the worker sockets, so the descriptor is still the worker's
+            ssize_t n = ::read(pollFds[idx].fd, buffer.data(), buffer.size());
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            IntType env = pollEnvs[idx - 1];
+            std::lock_guard<std::mutex> lock(_mutex);
+            Worker &worker = *_workers[env];
+            if (n <= 0)
+            {
+                numAdded += worker.pending.size();
+                this->retireWorker(env, worker);
+                continue;
+            }
+            worker.inbox.append(buffer.data(), n);
+            numAdded += this->parseResponses(env, worker);
+        }
+        if (numAdded > 0)
+        {
+            this->notify();
+        }
+    }
+}
+
+IntType AbcExecutor::parseResponses(IntType env, Worker &worker)
+{
+    IntType numAdded = 0;
+    std::size_t pos = 0;
+    while (worker.inbox.size() - pos >= sizeof(AsyncFrameHeader))
+    {
+        AsyncFrameHeader header;
+        std::memcpy(&header, worker.inbox.data() + pos, sizeof(header));
+        if (worker.inbox.size() - pos - sizeof(header) < header.size)
+        {
+            break;
+        }
+        AsyncCompletion completion;
+        completion.ticket = header.ticket;
+        completion.env = env;
+        completion.success = header.code != 0;
+        completion.payload = worker.inbox.substr(pos + sizeof(header), header.size);
+        // The worker answers in order, so the call is at the front
+        for (auto iter = worker.pending.begin(); iter != worker.pending.end(); ++iter)
+        {
+            if (iter->first == header.ticket)
+            {
+                completion.op = iter->second;
+                worker.pending.erase(iter);
+                break;
+            }
+        }
+        _completions.push_back(std::move(completion));
+        pos += sizeof(header) + header.size;
+        ++numAdded;
+    }
+    worker.inbox.erase(0, pos);
+    return numAdded;
+}
+
+void AbcExecutor::retireWorker(IntType env, Worker &worker)
+{
+    if (!worker.closing)
+    {
+        ERR("%s: the worker of environment %d died \n", __FUNCTION__, env);
+    }
+    for (const auto &call : worker.pending)
+    {
+        AsyncCompletion completion;
+        completion.ticket = call.first;
+        completion.env = env;
+        completion.op = call.second;
+        _completions.push_back(std::move(completion));
+    }
+    worker.pending.clear();
+    worker.inbox.clear();
+    std::lock_guard<std::mutex> writeLock(worker.writeMutex);
+    // The worker is a child of the spawner, which reaps it
+    ::close(worker.fd);
+    worker.fd = -1;
+    worker.pid = -1;
+}
+
+StepResult AbcExecutor::decodeStep(const std::string &payload)
+{
+    ByteReader reader(payload);
+    StepResult step;
+    std::int32_t success = 0;
+    IntType numAndBefore = 0, numAndAfter = 0, levBefore = 0, levAfter = 0, numCreated = -1, numRemoved = -1;
+    RealType runtime = 0;
+    reader.read(success);
+    reader.read(numAndBefore);
+    reader.read(numAndAfter);
+    reader.read(levBefore);
+    reader.read(levAfter);
+    reader.read(runtime);
+    reader.read(numCreated);
+    reader.read(numRemoved);
+    std::int32_t timedOut = 0;
+    reader.read(timedOut);
+    if (!reader.good())
+    {
+        return step;
+    }
+    step.setSuccess(success != 0);
+    step.setNumAndBefore(numAndBefore);
+    step.setNumAndAfter(numAndAfter);
+    step.setLevBefore(levBefore);
+    step.setLevAfter(levAfter);
+    step.setRuntime(runtime);
+    step.setNumCreated(numCreated);
+    step.setNumRemoved(numRemoved);
+    step.setTimedOut(timedOut != 0);
+    return step;
+}
+
+AigStats AbcExecutor::decodeStats(const std::string &payload)
+{
+    ByteReader reader(payload);
+    AigStats stats;
+    IndexType numIn = 0, numOut = 0, numLat = 0, numAnd = 0, lev = 0;
+    reader.read(numIn);
+    reader.read(numOut);
+    reader.read(numLat);
+    reader.read(numAnd);
+    reader.read(lev);
+    if (reader.good())
+    {
+        stats.setNumIn(numIn);
+        stats.setNumOut(numOut);
+        stats.setNumLat(numLat);
+        stats.setNumAnd(numAnd);
+        stats.setLev(lev);
+    }
+    return stats;
+}
+
+bool AbcExecutor::decodeGraph(const std::string &payload, std::vector<IntType> &nodeTypes, std::vector<IntType> &levels,
+        std::vector<IntType> &edgeSrc, std::vector<IntType> &edgeDst)
+{
+    ByteReader reader(payload);
+    return reader.readVector(nodeTypes) && reader.readVector(levels) && reader.readVector(edgeSrc) && reader.readVector(edgeDst);
+}
+
+bool AbcExecutor::decodeEpisode(const std::string &payload, std::string &block, IndexType &numSteps)
+{
+    ByteReader reader(payload);
+    std::uint32_t steps = 0;
+    reader.read(steps);
+    reader.readString(block);
+    numSteps = steps;
+    return reader.good();
+}
+
+bool AbcExecutor::decodeMetrics(const std::string &payload, std::string &text)
+{
+    ByteReader reader(payload);
+    reader.readString(text);
+    return reader.good();
+}
+
+PROJECT_NAMESPACE_END
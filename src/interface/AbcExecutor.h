@@ -0,0 +1,145 @@
+/**
+ * @file AbcExecutor.h
+ * @brief Run the AbcInterface calls of many environments asynchronously in isolated worker processes
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_ABC_EXECUTOR_H_
+#define ABC_PY_ABC_EXECUTOR_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <sys/types.h>
+#include "interface/AbcInterface.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The calls that can be submitted to an environment
+enum class AsyncOp : std::int32_t
+{
+    READ = 0, ///< read(text)
+    BALANCE = 1, ///< balance(l, d, s, x)
+    RESUB = 2, ///< resub(k, n, f, l, z)
+    REWRITE = 3, ///< rewrite(l, z)
+    REFACTOR = 4, ///< refactor(n, l, z)
+    COMPRESS2RS = 5, ///< compress2rs()
+    AIG_STATS = 6, ///< aigStats()
+    GRAPH = 7, ///< updateGraph() and export the node types, levels and fanin edges
+    EPISODE = 8, ///< read(text), then takeAction() for each argument, recording the trajectory
+    SWITCH = 9, ///< checkpoint() the current network to the first line of text if not empty, then load the second line: read() if the argument is 0, restore() if 1
+    ACTION = 10, ///< takeAction(action)
+    GIA_BALANCE = 11, ///< giaBalance(d)
+    GIA_ACTION = 12, ///< takeGiaAction(action)
+    METRICS = 13 ///< render the metrics registry of the worker process in the MetricsFormat of the argument
+};
+
+/// @class ABC_PY::AsyncCompletion
+/// @brief A finished call
+struct AsyncCompletion
+{
+    std::uint64_t ticket = 0; ///< The ticket returned by submit()
+    IntType env = -1; ///< The environment
+    AsyncOp op = AsyncOp::READ; ///< The call
+    bool success = false; ///< Whether the call succeeded. False if the worker died
+    std::string payload; ///< The encoded result, see the decode functions
+};
+
+/// @class ABC_PY::AbcExecutor
+/// @brief Every environment is an AbcInterface living in its own forked worker process, since the ABC framework is global.
+/// Calls are sent to the worker through a socket and run in order. A completion thread collects the results
+/// and signals an eventfd, so an event loop can watch eventFd() and drain() the completions when it is readable.
+/// The workers are forked by a single-threaded spawner process, itself forked by the constructor, so createEnv() is
+/// safe from any thread: no worker inherits a lock held by another thread of the caller.
+class AbcExecutor
+{
+    public:
+        explicit AbcExecutor();
+        /// @brief stop all the workers. Calls not completed are dropped
+        ~AbcExecutor();
+        AbcExecutor(const AbcExecutor &) = delete;
+        AbcExecutor & operator=(const AbcExecutor &) = delete;
+        /// @brief start a worker process for a new environment. The spawner forks it
+        /// @return the environment id. -1 if the worker cannot be started
+        IntType createEnv();
+        /// @brief close an environment once its submitted calls are done
+        /// @param the environment
+        void closeEnv(IntType env);
+        /// @brief whether an environment is open and its worker is alive
+        bool isAlive(IntType env);
+        /// @brief submit a call
+        /// @param first: the environment
+        /// @param second: the call
+        /// @param third: the integer arguments, in the order of the AbcInterface method. Booleans are 0 or 1
+        /// @param fourth: the file name of read
+        /// @return the ticket of the call. 0 if the environment is not open
+        std::uint64_t submit(IntType env, AsyncOp op, const std::vector<IntType> &args = std::vector<IntType>(), const std::string &text = "");
+        /// @brief the file descriptor that becomes readable when completions are available
+        int eventFd() const { return _eventFd; }
+        /// @brief take the completions available, without blocking
+        std::vector<AsyncCompletion> drain();
+        /// @brief get the number of calls submitted and not completed
+        IntType numPending();
+        /// @brief decode the result of an action
+        static StepResult decodeStep(const std::string &payload);
+        /// @brief decode the result of aigStats
+        static AigStats decodeStats(const std::string &payload);
+        /// @brief decode the result of a graph export
+        /// @param first: the payload
+        /// @param second: the type of each node, see AigNodeType
+        /// @param third: the level of each node
+        /// @param fourth: the fanin of each edge
+        /// @param fifth: the fanout of each edge
+        /// @return if successful
+        static bool decodeGraph(const std::string &payload, std::vector<IntType> &nodeTypes, std::vector<IntType> &levels,
+                std::vector<IntType> &edgeSrc, std::vector<IntType> &edgeDst);
+        /// @brief decode the result of an episode
+        /// @param first: the payload
+        /// @param second: the uncompressed trajectory block, see TrajectoryEncoder
+        /// @param third: the number of steps
+        /// @return if successful
+        static bool decodeEpisode(const std::string &payload, std::string &block, IndexType &numSteps);
+        /// @brief decode the metrics of a worker
+        /// @param first: the payload
+        /// @param second: the rendered metrics
+        /// @return if successful
+        static bool decodeMetrics(const std::string &payload, std::string &text);
+    private:
+        /// @class ABC_PY::AbcExecutor::Worker
+        /// @brief The parent side of a worker process
+        struct Worker
+        {
+            pid_t pid = -1; ///< The worker process
+            int fd = -1; ///< The socket to the worker
+            bool closing = false; ///< Whether closeEnv() was called
+            std::string inbox; ///< The bytes received and not parsed yet
+            std::deque<std::pair<std::uint64_t, AsyncOp>> pending; ///< The calls submitted and not completed, in order
+            std::mutex writeMutex; ///< Serializes the writes to the socket
+        };
+        /// @brief the loop of the completion thread
+        void completionLoop();
+        /// @brief parse the complete responses in the inbox of a worker. The caller holds the mutex
+        /// @return the number of completions added
+        IntType parseResponses(IntType env, Worker &worker);
+        /// @brief fail the pending calls of a dead worker and reap it. The caller holds the mutex
+        void retireWorker(IntType env, Worker &worker);
+        /// @brief signal the event fd
+        void notify();
+    private:
+        std::mutex _mutex; ///< Guards the workers and the completions
+        std::vector<std::unique_ptr<Worker>> _workers; ///< The workers, indexed by environment
+        std::deque<AsyncCompletion> _completions; ///< The completions not drained yet
+        std::uint64_t _nextTicket = 1; ///< The next ticket
+        pid_t _spawnerPid = -1; ///< The process forking the workers
+        int _spawnerFd = -1; ///< The socket to the spawner, through which the worker sockets come back
+        int _eventFd = -1; ///< Signalled on completions
+        int _wakeFd = -1; ///< Wakes the completion thread when the workers change
+        bool _stop = false; ///< Whether the completion thread should stop
+        std::thread _thread; ///< The completion thread
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_ABC_EXECUTOR_H_
@@ -1,33 +1,11 @@
 #include "AbcInterface.h"
+#include "AbcCommand.h"
+#include "AigCheckpoint.h"
+#include "util/ForkTask.h"
+#include <unistd.h>
+#include <abc_src/base/io/ioAbc.h>
 
 
-#if defined(ABC_NAMESPACE)
-namespace ABC_NAMESPACE
-{
-#elif defined(__cplusplus)
-extern "C"
-{
-#endif
-
-// procedures to start and stop the ABC framework
-// (should be called before and after the ABC procedures are called)
-void   Abc_Start();
-void   Abc_Stop();
-
-// procedures to get the ABC framework and execute commands in it
-//typedef struct Abc_Frame_t_ Abc_Frame_t;
-
-Abc_Frame_t_ * Abc_FrameGetGlobalFrame();
-int    Cmd_CommandExecute( Abc_Frame_t_ * pAbc, const char * sCommand );
-
-
-#if defined(ABC_NAMESPACE)
-}
-using namespace ABC_NAMESPACE;
-#elif defined(__cplusplus)
-}
-#endif
-
 PROJECT_NAMESPACE_BEGIN
 
 
@@ -55,10 +33,52 @@ IntType stripEqual(std::string word)
     return ::atoi(word.c_str());
 }
 
+/// @brief the gauge of the AND nodes of the current design, looked up once
+static MetricGauge & designAndNodesGauge()
+{
+    static MetricGauge &gauge = MetricsRegistry::instance().gauge("abc_py_design_and_nodes", "Number of AND nodes of the current design");
+    return gauge;
+}
+
+/// Whether the process-wide ABC framework is started. A forked worker inherits the framework of its parent
+static bool abcStarted = false;
+
+/// The environments started by this process, tagged with its id so that a forked child starts from zero
+static pid_t liveEnvsPid = -1;
+static IntType numLiveEnvsInPid = 0;
+
+AbcInterface::~AbcInterface()
+{
+    if (_startPid >= 0 && _startPid == liveEnvsPid && _startPid == ::getpid())
+    {
+        --numLiveEnvsInPid;
+    }
+}
+
+IntType AbcInterface::numLiveEnvs()
+{
+    return liveEnvsPid == ::getpid() ? numLiveEnvsInPid : 0;
+}
+
 void AbcInterface::start()
 {
     // start the ABC framework
-    Abc_Start();
+    if (!abcStarted)
+    {
+        Abc_Start();
+        abcStarted = true;
+    }
+    pid_t pid = ::getpid();
+    if (_startPid != pid)
+    {
+        if (liveEnvsPid != pid)
+        {
+            liveEnvsPid = pid;
+            numLiveEnvsInPid = 0;
+        }
+        ++numLiveEnvsInPid;
+        _startPid = pid;
+    }
     _pAbc = Abc_FrameGetGlobalFrame();
     // Std streams capture
     //_stdCap.Init();
@@ -66,33 +86,374 @@ void AbcInterface::start()
 
 void AbcInterface::end()
 {
+    this->finishDesignMetrics();
     // stop t;he ABC framework
-    Abc_Stop();
+    if (abcStarted)
+    {
+        Abc_Stop();
+        abcStarted = false;
+    }
 }
 
 bool AbcInterface::read(const std::string &filename)
 {
+    auto &metrics = MetricsRegistry::instance();
+    this->finishDesignMetrics();
+    MetricsTimer timer;
     auto beginClk = clock();
-    char Command[1000];
-    // read the file
-    sprintf( Command, "read %s", filename.c_str() );
-    if ( Cmd_CommandExecute( _pAbc, Command ) )
+    // Straight to the reader rather than through the command line, which would split a name with spaces or a ';'
+    std::vector<char> name(filename.begin(), filename.end());
+    name.push_back('\0');
+    Abc_Ntk_t *pNtk = Io_Read(name.data(), Io_ReadFileType(name.data()), 1, 0);
+    if (pNtk == nullptr)
     {
-        ERR("Cannot execute command \"%s\".\n", Command );
+        ERR("%s: cannot read %s \n", __FUNCTION__, filename.c_str());
+        metrics.counter("abc_py_read_failures_total", "Number of failed reads").inc();
         return false;
     }
     // Default do a strash
-    sprintf( Command, "strash" );
-    if ( Cmd_CommandExecute( _pAbc, Command ) )
+    Abc_Ntk_t *pAig = Abc_NtkStrash(pNtk, 0, 1, 0);
+    Abc_NtkDelete(pNtk);
+    if (pAig == nullptr)
     {
-        ERR("Cannot execute command \"%s\".\n", Command );
+        ERR("%s: cannot strash %s \n", __FUNCTION__, filename.c_str());
+        metrics.counter("abc_py_read_failures_total", "Number of failed reads").inc();
         return false;
     }
+    Abc_FrameReplaceCurrentNetwork(_pAbc, pAig);
     auto endClk = clock();
     _lastClk = beginClk - endClk;
+    // The GIA left in the frame is of an older design
+    _giaCurrent = false;
     this->updateGraph();
+    std::vector<IntType> piNodes, poNodes;
+    this->interfaceNodes(piNodes, poNodes);
+    if (this->admitMemory("snapshot"))
+    {
+        _equivChecker.setReference(_aigNodes, piNodes, poNodes);
+    }
+    else
+    {
+        _equivChecker.clear();
+    }
+    _stepTracker.invalidate();
+    if (_giaMode && !this->ensureGia())
+    {
+        metrics.counter("abc_py_read_failures_total", "Number of failed reads").inc();
+        return false;
+    }
+    metrics.counter("abc_py_reads_total", "Number of designs read").inc();
+    metrics.histogram("abc_py_read_seconds", "Wall time of reading and strashing a design").observe(timer.elapsed());
+    designAndNodesGauge().set(_numAigAnds);
+    _designTimer.reset();
+    _hasDesign = true;
+    return true;
+
+}
+
+bool AbcInterface::write(const std::string &filename)
+{
+    if (_pAbc == nullptr || !this->ensureNetwork())
+    {
+        ERR("%s: no network to write \n", __FUNCTION__);
+        return false;
+    }
+    // Straight to the writer rather than through the command line, which would split a name with spaces or a ';'
+    std::vector<char> name(filename.begin(), filename.end());
+    name.push_back('\0');
+    Io_FileType_t fileType = Io_ReadFileType(name.data());
+    if (fileType == IO_FILE_NONE || fileType == IO_FILE_UNKNOWN)
+    {
+        ERR("%s: cannot tell the format of %s from its extension \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    Io_Write(_pAbc->pNtkCur, name.data(), fileType);
     return true;
+}
+
+void AbcInterface::finishDesignMetrics()
+{
+    if (!_hasDesign)
+    {
+        return;
+    }
+    MetricsRegistry::instance().histogram("abc_py_design_seconds", "Wall time spent on one design, from read to the next read or end")
+        .observe(_designTimer.elapsed());
+    _hasDesign = false;
+}
 
+AbcInterface::ActionMetrics & AbcInterface::actionMetrics(const char *action)
+{
+    auto iter = _actionMetrics.find(action);
+    if (iter != _actionMetrics.end())
+    {
+        return iter->second;
+    }
+    // The same name from another translation unit may have another address. It gets an entry of its own
+    // pointing at the same metrics
+    auto &metrics = MetricsRegistry::instance();
+    std::string labels = std::string("action=\"") + action + "\"";
+    ActionMetrics &entry = _actionMetrics[action];
+    entry.actions = &metrics.counter("abc_py_actions_total", "Number of executed actions", labels);
+    entry.failures = &metrics.counter("abc_py_action_failures_total", "Number of failed actions", labels);
+    entry.timeouts = &metrics.counter("abc_py_action_timeouts_total", "Number of actions stopped at their deadline", labels);
+    entry.nodesRemoved = &metrics.counter("abc_py_nodes_removed_total", "Net number of AND nodes removed by actions", labels);
+    entry.nodesAdded = &metrics.counter("abc_py_nodes_added_total", "Net number of AND nodes added by actions", labels);
+    entry.seconds = &metrics.histogram("abc_py_action_seconds", "Wall time of one action", labels);
+    entry.memoryPeak = &_actionMemoryPeaks[action];
+    return entry;
+}
+
+bool AbcInterface::executeAction(const char *action, const std::string &cmd)
+{
+    ActionMetrics &actionMetrics = this->actionMetrics(action);
+    bool onGia = !cmd.empty() && cmd[0] == '&';
+    if (!(onGia ? this->ensureGia() : this->ensureNetwork()))
+    {
+        actionMetrics.failures->inc();
+        return false;
+    }
+    IntType numAndBefore = this->currentNumAnd();
+    this->beginStep();
+    MetricsTimer timer;
+    auto beginClk = clock();
+    bool executed = _actionTimeout > 0 ? this->executeWithDeadline(cmd, onGia) : Cmd_CommandExecute( _pAbc, cmd.c_str() ) == 0;
+    if (!executed)
+    {
+        if (_stepTimedOut)
+        {
+            WRN("%s: \"%s\" ran out of its time budget of %g seconds \n", __FUNCTION__, cmd.c_str(), _actionTimeout);
+            actionMetrics.timeouts->inc();
+        }
+        else
+        {
+            ERR("Cannot execute command \"%s\".\n", cmd.c_str() );
+            actionMetrics.failures->inc();
+        }
+        this->endStep(false);
+        return false;
+    }
+    auto endClk = clock();
+    _lastClk = endClk - beginClk;
+    // The network may have been replaced by the command
+    IntType numAndAfter = this->currentNumAnd();
+    actionMetrics.actions->inc();
+    actionMetrics.seconds->observe(timer.elapsed());
+    if (numAndAfter < numAndBefore)
+    {
+        actionMetrics.nodesRemoved->inc(numAndBefore - numAndAfter);
+    }
+    else
+    {
+        actionMetrics.nodesAdded->inc(numAndAfter - numAndBefore);
+    }
+    designAndNodesGauge().set(numAndAfter);
+    this->recordActionMemory(actionMetrics);
+    this->endStep(true);
+    return true;
+}
+
+void AbcInterface::beginStep()
+{
+    if (_stepNesting++ == 0)
+    {
+        _stepTimer.reset();
+        _stepTimedOut = false;
+        if (_giaCurrent)
+        {
+            _stepTracker.begin(_pAbc->pGia);
+        }
+        else
+        {
+            _stepTracker.begin(_pAbc->pNtkCur);
+        }
+    }
+}
+
+void AbcInterface::endStep(bool success)
+{
+    if (--_stepNesting == 0)
+    {
+        // The design has changed under the mirror, even if the command failed halfway
+        ++_graphGeneration;
+        if (_giaCurrent)
+        {
+            _stepTracker.end(_pAbc->pGia, success);
+        }
+        else
+        {
+            _stepTracker.end(_pAbc->pNtkCur, success);
+        }
+        _stepTracker.setTimedOut(_stepTimedOut);
+    }
+}
+
+bool AbcInterface::executeWithDeadline(const std::string &cmd, bool onGia)
+{
+    // The result comes back as checkpoint sections, which hold the PIs, the POs and the AND nodes only
+    IntType numLatches = onGia ? Gia_ManRegNum(_pAbc->pGia) : Abc_NtkLatchNum(_pAbc->pNtkCur);
+    if (numLatches > 0)
+    {
+        ERR("%s: \"%s\" cannot run with a time budget: the design has %d latches, which would be lost \n", __FUNCTION__,
+                cmd.c_str(), numLatches);
+        return false;
+    }
+    RealType remaining = _actionTimeout - _stepTimer.elapsed();
+    if (remaining <= 0)
+    {
+        _stepTimedOut = true;
+        return false;
+    }
+    // ABC cannot be interrupted, so the command runs on the copy-on-write copy of a child, which is killed at the
+    // deadline. The design here is untouched until the child hands its result back
+    ForkTask task;
+    if (!task.start([this, &cmd, onGia]() { return this->executeInChild(cmd, onGia); }))
+    {
+        return false;
+    }
+    std::string bytes;
+    ForkStatus status = task.finish(bytes, remaining);
+    if (status == ForkStatus::TIMEOUT)
+    {
+        _stepTimedOut = true;
+        return false;
+    }
+    if (status != ForkStatus::OK || bytes.empty())
+    {
+        return false;
+    }
+    // The sections are read in place. The bytes are on the heap, aligned past what the writer laid them out for
+    CheckpointReader reader;
+    Abc_Ntk_t *pNtk = reader.open(bytes.data(), bytes.size()) ? AigCheckpoint::buildNetwork(reader) : nullptr;
+    if (pNtk == nullptr)
+    {
+        ERR("%s: cannot take the network of \"%s\" \n", __FUNCTION__, cmd.c_str());
+        return false;
+    }
+    Abc_FrameReplaceCurrentNetwork(_pAbc, pNtk);
+    _giaCurrent = false;
+    // The GIA of an &-command comes back through the network
+    return !onGia || this->ensureGia();
+}
+
+std::string AbcInterface::executeInChild(const std::string &cmd, bool onGia)
+{
+    if ( Cmd_CommandExecute( _pAbc, cmd.c_str() ) )
+    {
+        return "";
+    }
+    if (onGia)
+    {
+        // Only the network is encoded. The conversion is not counted, as the metrics of the child are its own
+        if ( Cmd_CommandExecute( _pAbc, "&put" ) )
+        {
+            return "";
+        }
+        _giaCurrent = false;
+    }
+    return this->encodeNetworkInChild();
+}
+
+std::string AbcInterface::encodeNetworkInChild()
+{
+    if (Abc_NtkLatchNum(_pAbc->pNtkCur) > 0)
+    {
+        return "";
+    }
+    // This is the copy of the child. Mirror the network by its object ids, without touching the metrics
+    _compactIds = false;
+    _graphArena.reset();
+    _fanoutLayout.arena = &_graphArena;
+    this->updateGraphFromNetwork();
+    std::vector<IntType> piNodes, poNodes;
+    this->interfaceNodes(piNodes, poNodes);
+    CheckpointWriter writer;
+    AigCheckpoint::addGraph(writer, CheckpointSection::NETWORK_NODES, _aigNodes, piNodes, poNodes);
+    AigCheckpoint::addNames(writer, _pAbc->pNtkCur);
+    return writer.finish();
+}
+
+std::vector<SweepRow> AbcInterface::sweep(ParamSweep &paramSweep)
+{
+    if (!this->ensureNetwork())
+    {
+        return paramSweep.run(nullptr);
+    }
+    return paramSweep.run(_pAbc, [this]() { return this->encodeNetworkInChild(); });
+}
+
+bool AbcInterface::takeSweepRow(const SweepRow &row)
+{
+    if (!row.success || row.network.empty())
+    {
+        ERR("%s: \"%s\" left no network to take. Sweep with setKeepNetworks(true) \n", __FUNCTION__, row.command.c_str());
+        return false;
+    }
+    if (!this->ensureNetwork())
+    {
+        return false;
+    }
+    // The sections are read in place. The bytes are on the heap, aligned past what the writer laid them out for
+    CheckpointReader reader;
+    Abc_Ntk_t *pNtk = reader.open(row.network.data(), row.network.size()) ? AigCheckpoint::buildNetwork(reader) : nullptr;
+    if (pNtk == nullptr)
+    {
+        ERR("%s: cannot take the network of \"%s\" \n", __FUNCTION__, row.command.c_str());
+        return false;
+    }
+    this->beginStep();
+    Abc_FrameReplaceCurrentNetwork(_pAbc, pNtk);
+    this->endStep(true);
+    return true;
+}
+
+bool AbcInterface::ensureGia()
+{
+    if (_giaCurrent)
+    {
+        return true;
+    }
+    // Keep the CI and CO names, so they come back with the network
+    if ( Cmd_CommandExecute( _pAbc, "&get -n" ) )
+    {
+        ERR("%s: cannot move the network to the GIA \n", __FUNCTION__);
+        return false;
+    }
+    _giaCurrent = true;
+    MetricsRegistry::instance().counter("abc_py_gia_conversions_total", "Conversions of the design between the network and the GIA",
+            "to=\"gia\"").inc();
+    return true;
+}
+
+bool AbcInterface::ensureNetwork()
+{
+    if (!_giaCurrent)
+    {
+        return true;
+    }
+    if ( Cmd_CommandExecute( _pAbc, "&put" ) )
+    {
+        ERR("%s: cannot move the GIA to the network \n", __FUNCTION__);
+        return false;
+    }
+    _giaCurrent = false;
+    MetricsRegistry::instance().counter("abc_py_gia_conversions_total", "Conversions of the design between the network and the GIA",
+            "to=\"network\"").inc();
+    return true;
+}
+
+bool AbcInterface::hasDesign() const
+{
+    if (_pAbc == nullptr)
+    {
+        return false;
+    }
+    return _giaCurrent ? _pAbc->pGia != nullptr : _pAbc->pNtkCur != nullptr;
+}
+
+IntType AbcInterface::currentNumAnd() const
+{
+    return _giaCurrent ? Gia_ManAndNum(_pAbc->pGia) : Abc_NtkNodeNum(_pAbc->pNtkCur);
 }
 
 bool AbcInterface::balance(bool l, bool d, bool s, bool x)
@@ -114,15 +475,7 @@ bool AbcInterface::balance(bool l, bool d, bool s, bool x)
     {
         cmd += " -x ";
     }
-    auto beginClk = clock();
-    if ( Cmd_CommandExecute( _pAbc, cmd.c_str() ) )
-    {
-        ERR("Cannot execute command \"%s\".\n", cmd.c_str() );
-        return false;
-    }
-    auto endClk = clock();
-    _lastClk = beginClk - endClk;
-    return true;
+    return this->executeAction("balance", cmd);
 }
 
 bool AbcInterface::resub(IntType k, IntType n, IntType f, bool l, bool z)
@@ -151,15 +504,7 @@ bool AbcInterface::resub(IntType k, IntType n, IntType f, bool l, bool z)
     {
         cmd += " -z ";
     }
-    auto beginClk = clock();
-    if ( Cmd_CommandExecute( _pAbc, cmd.c_str() ) )
-    {
-        ERR("Cannot execute command \"%s\".\n", cmd.c_str() );
-        return false;
-    }
-    auto endClk = clock();
-    _lastClk = beginClk - endClk;
-    return true;
+    return this->executeAction("resub", cmd);
 }
 
 bool AbcInterface::rewrite(bool l, bool z)
@@ -173,15 +518,7 @@ bool AbcInterface::rewrite(bool l, bool z)
     {
         cmd += " -z ";
     }
-    auto beginClk = clock();
-    if ( Cmd_CommandExecute( _pAbc, cmd.c_str() ) )
-    {
-        ERR("Cannot execute command \"%s\".\n", cmd.c_str() );
-        return false;
-    }
-    auto endClk = clock();
-    _lastClk = beginClk - endClk;
-    return true;
+    return this->executeAction("rewrite", cmd);
 }
 
 bool AbcInterface::refactor(IntType n, bool l, bool z)
@@ -200,44 +537,281 @@ bool AbcInterface::refactor(IntType n, bool l, bool z)
     {
         cmd += " -z ";
     }
-    auto beginClk = clock();
+    return this->executeAction("refactor", cmd);
+}
+
+bool AbcInterface::compress2rs()
+{
+    auto actions = [this]()
+    {
+        // "b -l; rs -K 6 -l; rw -l; rs -K 6 -N 2 -l; rf -l; rs -K 8 -l; b -l; rs -K 8 -N 2 -l; rw -l; rs -K 10 -l; rwz -l; rs -K 10 -N 2 -l; b -l; rs -K 12 -l; rfz -l; rs -K 12 -N 2 -l; rwz -l; b -l
+        if (!this->balance(true)) { return false; }
+        if (!this->resub(6, -1, -1, true, false)) { return false; }
+        if (!this->rewrite(true, false)) { return false; }
+        if (!this->resub(6, 2, -1, true, false)) { return false; }
+        if (!this->refactor(-1, true, false)) { return false; }
+        if (!this->resub(8, -1, -1, true, false)) { return false; }
+        if (!this->balance(true, false, false,false)) { return false; }
+        if (!this->resub(8, 2, -1, true, false)) { return false; }
+        if (!this->rewrite(true, false)) { return false; }
+        if (!this->resub(10, -1, -1, true, false)) { return false; }
+        if (!this->rewrite(true, true)) { return false; }
+        if (!this->resub(10, 2, -1, true, false)) { return false; }
+        if (!this->balance(true, false, false, false)) { return false; }
+        if (!this->resub(12, -1, -1, true, false)) { return false; }
+        if (!this->refactor(-1, true, true)) { return false; }
+        if (!this->resub(12, 2, -1, true, false)) { return false; }
+        if (!this->rewrite(true, true)) { return false; }
+        if (!this->balance(true, false, false, false)) { return false; }
+        return true;
+    };
+    // The sub-actions are recorded as one step, on the network they run on
+    if (!this->ensureNetwork())
+    {
+        return false;
+    }
+    this->beginStep();
+    bool success = actions();
+    this->endStep(success);
+    return success;
+}
+
+bool AbcInterface::takeAction(IntType action)
+{
+    switch (static_cast<AbcAction>(action))
+    {
+        case AbcAction::BALANCE: return this->balance();
+        case AbcAction::REWRITE: return this->rewrite();
+        case AbcAction::REWRITE_Z: return this->rewrite(false, true);
+        case AbcAction::REFACTOR: return this->refactor();
+        case AbcAction::REFACTOR_Z: return this->refactor(-1, false, true);
+        case AbcAction::RESUB: return this->resub();
+        case AbcAction::RESUB_Z: return this->resub(-1, -1, -1, false, true);
+        default:
+            ERR("%s: unknown action %d \n", __FUNCTION__, action);
+            return false;
+    }
+}
+
+bool AbcInterface::giaBalance(bool d)
+{
+    std::string cmd = "&b";
+    if (d)
+    {
+        cmd += " -d ";
+    }
+    return this->executeAction("gia_balance", cmd);
+}
+
+bool AbcInterface::giaSyn2()
+{
+    return this->executeAction("gia_syn2", "&syn2");
+}
+
+bool AbcInterface::giaDc2()
+{
+    return this->executeAction("gia_dc2", "&dc2");
+}
+
+bool AbcInterface::giaDch()
+{
+    return this->executeAction("gia_dch", "&dch");
+}
+
+bool AbcInterface::takeGiaAction(IntType action)
+{
+    switch (static_cast<GiaAction>(action))
+    {
+        case GiaAction::BALANCE: return this->giaBalance();
+        case GiaAction::SYN2: return this->giaSyn2();
+        case GiaAction::DC2: return this->giaDc2();
+        case GiaAction::DCH: return this->giaDch();
+        default:
+            ERR("%s: unknown action %d \n", __FUNCTION__, action);
+            return false;
+    }
+}
+
+bool AbcInterface::readLibrary(const std::string &filename)
+{
+    bool isGenlib = filename.size() >= 7 && filename.compare(filename.size() - 7, 7, ".genlib") == 0;
+    std::string cmd = (isGenlib ? "read_genlib " : "read_lib ") + filename;
     if ( Cmd_CommandExecute( _pAbc, cmd.c_str() ) )
     {
         ERR("Cannot execute command \"%s\".\n", cmd.c_str() );
         return false;
     }
-    auto endClk = clock();
-    _lastClk = beginClk - endClk;
+    _mappingEvaluator.setLibraryRead();
     return true;
 }
 
-bool AbcInterface::compress2rs()
+std::shared_future<MappingQoR> AbcInterface::mappingQoR(MappingMode mode, IntType lutSize)
+{
+    if (!this->ensureNetwork())
+    {
+        return MappingEvaluator::readyFuture(MappingQoR());
+    }
+    return _mappingEvaluator.evaluate(_pAbc, mode, lutSize, this->admitMemory("cache"));
+}
+
+void AbcInterface::interfaceNodes(std::vector<IntType> &piNodes, std::vector<IntType> &poNodes) const
+{
+    Abc_Ntk_t *pNtk = _pAbc->pNtkCur;
+    piNodes.resize(Abc_NtkPiNum(pNtk));
+    for (IntType pi = 0; pi < Abc_NtkPiNum(pNtk); ++pi)
+    {
+        piNodes[pi] = Abc_ObjId(Abc_NtkPi(pNtk, pi));
+    }
+    poNodes.resize(Abc_NtkPoNum(pNtk));
+    for (IntType po = 0; po < Abc_NtkPoNum(pNtk); ++po)
+    {
+        poNodes[po] = Abc_ObjId(Abc_NtkPo(pNtk, po));
+    }
+    // The mirror may be indexed by the compact ids
+    if (_compactIds)
+    {
+        for (IntType &node : piNodes)
+        {
+            node = _compactor.abcToCompact()[node];
+        }
+        for (IntType &node : poNodes)
+        {
+            node = _compactor.abcToCompact()[node];
+        }
+    }
+}
+
+VerifyResult AbcInterface::verify()
 {
+    auto &metrics = MetricsRegistry::instance();
+    MetricsTimer timer;
+    // The reference is a mirror of the network, which the mirror of a GIA does not compare to
+    this->ensureNetwork();
+    this->updateGraph();
+    std::vector<IntType> piNodes, poNodes;
+    this->interfaceNodes(piNodes, poNodes);
+    VerifyResult result = _equivChecker.check(_aigNodes, piNodes, poNodes);
+    const char *status = result.status() == VerifyStatus::PASS ? "pass" : result.status() == VerifyStatus::FAIL ? "fail" : "undecided";
+    metrics.counter("abc_py_verify_total", "Number of equivalence checks", std::string("result=\"") + status + "\"").inc();
+    metrics.histogram("abc_py_verify_seconds", "Wall time of one equivalence check").observe(timer.elapsed());
+    if (result.status() == VerifyStatus::FAIL)
+    {
+        WRN("%s: the network is not equivalent to the design read. Failing PO %d \n", __FUNCTION__, result.failingOutput());
+    }
+    return result;
+}
 
-    // "b -l; rs -K 6 -l; rw -l; rs -K 6 -N 2 -l; rf -l; rs -K 8 -l; b -l; rs -K 8 -N 2 -l; rw -l; rs -K 10 -l; rwz -l; rs -K 10 -N 2 -l; b -l; rs -K 12 -l; rfz -l; rs -K 12 -N 2 -l; rwz -l; b -l
-    if (!this->balance(true)) { return false; }
-    if (!this->resub(6, -1, -1, true, false)) { return false; }
-    if (!this->rewrite(true, false)) { return false; }
-    if (!this->resub(6, 2, -1, true, false)) { return false; }
-    if (!this->refactor(-1, true, false)) { return false; }
-    if (!this->resub(8, -1, -1, true, false)) { return false; }
-    if (!this->balance(true, false, false,false)) { return false; }
-    if (!this->resub(8, 2, -1, true, false)) { return false; }
-    if (!this->rewrite(true, false)) { return false; }
-    if (!this->resub(10, -1, -1, true, false)) { return false; }
-    if (!this->rewrite(true, true)) { return false; }
-    if (!this->resub(10, 2, -1, true, false)) { return false; }
-    if (!this->balance(true, false, false, false)) { return false; }
-    if (!this->resub(12, -1, -1, true, false)) { return false; }
-    if (!this->refactor(-1, true, true)) { return false; }
-    if (!this->resub(12, 2, -1, true, false)) { return false; }
-    if (!this->rewrite(true, true)) { return false; }
-    if (!this->balance(true, false, false, false)) { return false; }
+bool AbcInterface::addCheckpointSections(CheckpointWriter &writer)
+{
+    if (_pAbc == nullptr || _pAbc->pNtkCur == nullptr || !this->ensureNetwork())
+    {
+        ERR("%s: no network is loaded \n", __FUNCTION__);
+        return false;
+    }
+    // The sections hold a combinational AIG. Refuse rather than write a file restore() would reject
+    if (Abc_NtkLatchNum(_pAbc->pNtkCur) > 0)
+    {
+        ERR("%s: the network has %d latches. Checkpoints only hold combinational networks \n", __FUNCTION__, Abc_NtkLatchNum(_pAbc->pNtkCur));
+        return false;
+    }
+    this->updateGraph();
+    std::vector<IntType> piNodes, poNodes;
+    this->interfaceNodes(piNodes, poNodes);
+    AigCheckpoint::addGraph(writer, CheckpointSection::NETWORK_NODES, _aigNodes, piNodes, poNodes);
+    AigCheckpoint::addNames(writer, _pAbc->pNtkCur);
+    if (_equivChecker.hasReference())
+    {
+        AigCheckpoint::addGraph(writer, CheckpointSection::REFERENCE_NODES, _equivChecker.refNodes(), _equivChecker.refPis(), _equivChecker.refPos());
+    }
+    return true;
+}
+
+std::string AbcInterface::serialize()
+{
+    CheckpointWriter writer;
+    if (!this->admitMemory("snapshot") || !this->addCheckpointSections(writer))
+    {
+        return "";
+    }
+    return writer.finish();
+}
+
+bool AbcInterface::deserialize(const char *data, std::size_t size)
+{
+    // The arrays are read in place, so they need the alignment the writer laid them out with
+    std::string aligned;
+    if (reinterpret_cast<std::uintptr_t>(data) % CHECKPOINT_ALIGN != 0)
+    {
+        aligned.assign(data, size);
+        data = aligned.data();
+    }
+    CheckpointReader reader;
+    if (!reader.open(data, size))
+    {
+        return false;
+    }
+    std::vector<AigNode> refNodes;
+    std::vector<IntType> refPis, refPos;
+    bool hasReference = reader.has(static_cast<std::uint32_t>(CheckpointSection::REFERENCE_NODES));
+    if (hasReference && !AigCheckpoint::readGraph(reader, CheckpointSection::REFERENCE_NODES, refNodes, refPis, refPos))
+    {
+        ERR("%s: the reference network in the checkpoint is inconsistent \n", __FUNCTION__);
+        return false;
+    }
+    Abc_Ntk_t *pNtk = AigCheckpoint::buildNetwork(reader);
+    if (pNtk == nullptr)
+    {
+        return false;
+    }
+    this->finishDesignMetrics();
+    Abc_FrameReplaceCurrentNetwork(_pAbc, pNtk);
+    _giaCurrent = false;
+    this->updateGraph();
+    if (hasReference)
+    {
+        _equivChecker.setReference(refNodes, refPis, refPos);
+    }
+    else
+    {
+        _equivChecker.clear();
+    }
+    _stepTracker.invalidate();
+    _designTimer.reset();
+    _hasDesign = true;
+    return true;
+}
+
+bool AbcInterface::checkpoint(const std::string &filename)
+{
+    MetricsTimer timer;
+    CheckpointWriter writer;
+    if (!this->admitMemory("snapshot") || !this->addCheckpointSections(writer) || !writer.writeFile(filename))
+    {
+        return false;
+    }
+    MetricsRegistry::instance().histogram("abc_py_checkpoint_seconds", "Wall time of writing one checkpoint").observe(timer.elapsed());
+    return true;
+}
+
+bool AbcInterface::restore(const std::string &filename)
+{
+    MetricsTimer timer;
+    MappedFile file;
+    if (!file.open(filename) || !this->deserialize(file.data(), file.size()))
+    {
+        ERR("%s: cannot restore from %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    MetricsRegistry::instance().histogram("abc_py_restore_seconds", "Wall time of restoring one checkpoint").observe(timer.elapsed());
     return true;
 }
 
 IntType AbcInterface::numNodes()
 {
+    if (_giaCurrent)
+    {
+        return Gia_ManObjNum(_pAbc->pGia);
+    }
     IntType nObj = _pAbc->pNtkCur->nObjs;
     return nObj;
 }
@@ -250,12 +824,84 @@ void AbcInterface::updateGraph()
     _numPI = 0;
     _numConst = 0;
 
-    _aigNodes.resize(this->numNodes());
-    //DBG("update graph: num of nodes %d \n", this->numNodes());
+    // The fanouts of the last mirror and the buffers exported from it go all at once
+    _graphArena.reset();
+    _mirrorGeneration = ++_graphGeneration;
+    _fanoutLayout.arena = &_graphArena;
+    if (_giaCurrent)
+    {
+        this->updateGraphFromGia();
+    }
+    else
+    {
+        this->updateGraphFromNetwork();
+    }
+    if (_compactIds)
+    {
+        std::vector<AigNode> compactNodes;
+        _compactor.compact(_aigNodes, compactNodes, &_fanoutLayout);
+        _aigNodes.swap(compactNodes);
+    }
+    else
+    {
+        _compactor.clear();
+    }
+    if (_buildLevelPartition)
+    {
+        _levelPartition.build(_aigNodes);
+    }
+    else
+    {
+        _levelPartition.clear();
+    }
+    if (_buildGraphDiff)
+    {
+        std::vector<std::uint64_t> keys;
+        AigGraphDiff::nodeKeys(_aigNodes, keys);
+        if (!_graphKeys.empty())
+        {
+            _graphDiff.build(_graphKeys, keys);
+            _graphDiff.setGenerations(_graphKeysGeneration, _graphGeneration);
+        }
+        _graphKeys.swap(keys);
+        _graphKeysGeneration = _graphGeneration;
+    }
+    _mirrorBytes = MemoryStats::vectorBytes(_aigNodes) + _graphArena.bytesReserved() + MemoryStats::vectorBytes(_fanoutLayout.scratch);
+    _mirrorBytes += _compactor.memoryBytes();
+    _mirrorBytes += MemoryStats::vectorBytes(_graphKeys) + MemoryStats::vectorBytes(_graphDiff.oldToNew()) + MemoryStats::vectorBytes(_graphDiff.newToOld())
+        + MemoryStats::vectorBytes(_graphDiff.created()) + MemoryStats::vectorBytes(_graphDiff.removed());
+    for (const AigNode &node : _aigNodes)
+    {
+        _mirrorBytes += node.fanoutBytes();
+    }
+}
 
-    for (IntType idx = 0; idx < this->numNodes(); ++idx)
+void AbcInterface::setGraphDiff(bool graphDiff)
+{
+    _buildGraphDiff = graphDiff;
+    if (!graphDiff)
+    {
+        _graphKeys.clear();
+        _graphKeys.shrink_to_fit();
+        _graphDiff.clear();
+    }
+}
+
+void AbcInterface::updateGraphFromNetwork()
+{
+    // The objects are indexed by id up to the largest one. The ids of deleted objects are left as empty slots,
+    // so there can be fewer objects than slots
+    Abc_Ntk_t *pNtk = _pAbc->pNtkCur;
+    IntType numSlots = Abc_NtkObjNumMax(pNtk);
+    _aigNodes.resize(numSlots);
+    for (IntType idx = 0; idx < numSlots; ++idx)
     {
-        auto pObj = (Abc_Obj_t*)_pAbc->pNtkCur->vObjs->pArray[idx];
+        auto pObj = Abc_NtkObj(pNtk, idx);
+        if (pObj == nullptr)
+        {
+            _aigNodes[idx] = AigNode();
+            continue;
+        }
         if (pObj->Level > _depth)
         {
             _depth = pObj->Level;
@@ -281,16 +927,196 @@ void AbcInterface::updateGraph()
             AssertMsg(false, "Unexpected node type %d \n", pObj->Type);
         }
         // Configure the AIG node maintained
-        _aigNodes[idx].configureNodeFromAbc(pObj);
+        _aigNodes[idx].configureNodeFromAbc(pObj, &_fanoutLayout);
     }
 }
 
+void AbcInterface::updateGraphFromGia()
+{
+    Gia_Man_t *pGia = _pAbc->pGia;
+    IntType numObjs = Gia_ManObjNum(pGia);
+    Gia_ManLevelNum(pGia);
+    // A GIA keeps no fanouts. Count them, then lay them out in the arena in the order of the fanout ids
+    IntType *offsets = _graphArena.allocateArray<IntType>(numObjs + 1);
+    std::fill(offsets, offsets + numObjs + 1, 0);
+    for (IntType id = 1; id < numObjs; ++id)
+    {
+        Gia_Obj_t *pObj = Gia_ManObj(pGia, id);
+        if (Gia_ObjIsAnd(pObj))
+        {
+            ++offsets[Gia_ObjFaninId0(pObj, id) + 1];
+            ++offsets[Gia_ObjFaninId1(pObj, id) + 1];
+        }
+        else if (Gia_ObjIsCo(pObj))
+        {
+            ++offsets[Gia_ObjFaninId0(pObj, id) + 1];
+        }
+    }
+    for (IntType id = 0; id < numObjs; ++id)
+    {
+        offsets[id + 1] += offsets[id];
+    }
+    IntType *fanouts = _graphArena.allocateArray<IntType>(offsets[numObjs]);
+    IntType *fill = _graphArena.allocateArray<IntType>(numObjs);
+    std::copy(offsets, offsets + numObjs, fill);
+    for (IntType id = 1; id < numObjs; ++id)
+    {
+        Gia_Obj_t *pObj = Gia_ManObj(pGia, id);
+        if (Gia_ObjIsAnd(pObj))
+        {
+            fanouts[fill[Gia_ObjFaninId0(pObj, id)]++] = id;
+            fanouts[fill[Gia_ObjFaninId1(pObj, id)]++] = id;
+        }
+        else if (Gia_ObjIsCo(pObj))
+        {
+            fanouts[fill[Gia_ObjFaninId0(pObj, id)]++] = id;
+        }
+    }
+    _aigNodes.resize(numObjs);
+    for (IntType id = 0; id < numObjs; ++id)
+    {
+        Gia_Obj_t *pObj = Gia_ManObj(pGia, id);
+        IntType level = Gia_ObjLevelId(pGia, id);
+        _depth = std::max(_depth, level);
+        IntType nodeType = AIG_NODE_CONST1;
+        IntType fanin0 = -1, fanin1 = -1;
+        bool poCompl = false;
+        if (Gia_ObjIsCi(pObj))
+        {
+            nodeType = AIG_NODE_PI;
+            _numPI++;
+        }
+        else if (Gia_ObjIsCo(pObj))
+        {
+            nodeType = AIG_NODE_PO;
+            fanin0 = Gia_ObjFaninId0(pObj, id);
+            // Object 0 is constant 0 in a GIA and constant 1 in the mirror
+            poCompl = Gia_ObjFaninC0(pObj) != (fanin0 == 0);
+            _numPO++;
+        }
+        else if (Gia_ObjIsAnd(pObj))
+        {
+            fanin0 = Gia_ObjFaninId0(pObj, id);
+            fanin1 = Gia_ObjFaninId1(pObj, id);
+            bool compl0 = Gia_ObjFaninC0(pObj) != (fanin0 == 0);
+            bool compl1 = Gia_ObjFaninC1(pObj) != (fanin1 == 0);
+            nodeType = compl0 && compl1 ? AIG_NODE_INVINV : compl0 || compl1 ? AIG_NODE_INVNO : AIG_NODE_NONO;
+            // The complemented fanin goes first, as in the mirror of a network
+            if (!compl0 && compl1)
+            {
+                std::swap(fanin0, fanin1);
+            }
+            _numAigAnds++;
+        }
+        else
+        {
+            _numConst++;
+        }
+        _aigNodes[id].configureNode(nodeType, fanin0, fanin1, poCompl, level, fanouts + offsets[id], offsets[id + 1] - offsets[id], &_fanoutLayout);
+    }
+}
+
+/// @brief the bytes held by a network. With memory managers, as the strashed networks have, they hold the objects
+/// and the fanin and fanout arrays. The structural hash table and the name manager are private to ABC and
+/// estimated at one pointer per object each
+static std::uint64_t networkBytes(Abc_Ntk_t *pNtk)
+{
+    if (pNtk == nullptr)
+    {
+        return 0;
+    }
+    std::uint64_t bytes = sizeof(Abc_Ntk_t);
+    for (Vec_Ptr_t *vec : { pNtk->vObjs, pNtk->vPis, pNtk->vPos, pNtk->vCis, pNtk->vCos })
+    {
+        bytes += vec != nullptr ? vec->nCap * sizeof(void *) : 0;
+    }
+    IntType numObjs = pNtk->vObjs != nullptr ? pNtk->vObjs->nSize : 0;
+    bytes += 2 * numObjs * sizeof(void *);
+    bytes += pNtk->pMmObj != nullptr ? Mem_FixedReadMemUsage(pNtk->pMmObj) : 0;
+    bytes += pNtk->pMmStep != nullptr ? Mem_StepReadMemUsage(pNtk->pMmStep) : 0;
+    if (pNtk->pMmObj != nullptr && pNtk->pMmStep != nullptr)
+    {
+        return bytes;
+    }
+    for (IntType idx = 0; idx < numObjs; ++idx)
+    {
+        auto pObj = static_cast<Abc_Obj_t *>(pNtk->vObjs->pArray[idx]);
+        if (pObj == nullptr)
+        {
+            continue;
+        }
+        bytes += pNtk->pMmObj == nullptr ? sizeof(Abc_Obj_t) : 0;
+        bytes += pNtk->pMmStep == nullptr ? (pObj->vFanins.nCap + pObj->vFanouts.nCap) * sizeof(int) : 0;
+    }
+    return bytes;
+}
+
+MemoryUsage AbcInterface::heldMemory()
+{
+    MemoryUsage usage;
+    // The network stays in the frame while the GIA is current, and the other way round
+    usage.setNetwork(_pAbc != nullptr ? networkBytes(_pAbc->pNtkCur) + (_pAbc->pGia != nullptr ? Gia_ManMemory(_pAbc->pGia) : 0) : 0);
+    usage.setMirror(_mirrorBytes + _levelPartition.memoryBytes());
+    usage.setSnapshots(_equivChecker.memoryBytes());
+    usage.setCaches(_mappingEvaluator.cacheBytes() + _stepTracker.memoryBytes());
+    return usage;
+}
+
+MemoryUsage AbcInterface::memoryUsage()
+{
+    MemoryUsage usage = this->heldMemory();
+    usage.setResident(MemoryStats::residentBytes());
+    usage.setPeakResident(MemoryStats::peakResidentBytes());
+    return usage;
+}
+
+bool AbcInterface::admitMemory(const char *kind)
+{
+    if (_memoryCap == 0)
+    {
+        return true;
+    }
+    std::uint64_t total = this->heldMemory().total();
+    if (total < _memoryCap)
+    {
+        return true;
+    }
+    WRN("%s: %llu bytes held reach the soft cap of %llu bytes. No new %s \n", __FUNCTION__,
+            static_cast<unsigned long long>(total), static_cast<unsigned long long>(_memoryCap), kind);
+    MetricsRegistry::instance().counter("abc_py_memory_rejections_total", "Snapshots and cache entries refused by the soft memory cap",
+            std::string("kind=\"") + kind + "\"").inc();
+    return false;
+}
+
+void AbcInterface::recordActionMemory(ActionMetrics &actionMetrics)
+{
+    static MetricGauge &memoryGauge = MetricsRegistry::instance().gauge("abc_py_memory_bytes", "Bytes held by the network, the mirror, the snapshots and the caches");
+    // The mirror is not updated by the actions, so it counts as of the last updateGraph()
+    std::uint64_t total = this->heldMemory().total();
+    *actionMetrics.memoryPeak = std::max(*actionMetrics.memoryPeak, total);
+    memoryGauge.set(total);
+}
+
 AigStats AbcInterface::aigStats()
 {
-    this->updateGraph();
     AigStats stats;
-    stats.setNumIn(_numPI);
-    stats.setNumOut(_numPO);
+    this->updateGraph();
+    // The mirror of a GIA counts all the combinational inputs and outputs, latches included, so the ports
+    // are read from the design: the primary ones alone in both modes
+    if (_giaCurrent)
+    {
+        Gia_Man_t *pGia = _pAbc->pGia;
+        stats.setNumIn(Gia_ManPiNum(pGia));
+        stats.setNumOut(Gia_ManPoNum(pGia));
+        stats.setNumLat(Gia_ManRegNum(pGia));
+    }
+    else
+    {
+        Abc_Ntk_t *pNtk = _pAbc->pNtkCur;
+        stats.setNumIn(Abc_NtkPiNum(pNtk));
+        stats.setNumOut(Abc_NtkPoNum(pNtk));
+        stats.setNumLat(Abc_NtkLatchNum(pNtk));
+    }
     stats.setNumAnd(_numAigAnds);
     stats.setLev(_depth);
     return stats;
@@ -8,9 +8,23 @@
 #ifndef ABC_PY_ABC_INTERFACE_H_
 #define ABC_PY_ABC_INTERFACE_H_
 
+#include <sys/types.h>
+#include <unordered_map>
 #include "global/global.h"
+#include "util/Metrics.h"
+#include "util/CheckpointFile.h"
+#include "util/MemoryStats.h"
+#include "interface/AigNode.h"
+#include "interface/AigEquivChecker.h"
+#include "interface/AigStepTracker.h"
+#include "interface/MappingEvaluator.h"
+#include "interface/ParamSweep.h"
+#include "graph/AigLevelPartition.h"
+#include "graph/AigGraphDiff.h"
+#include "graph/AigCompactor.h"
 #include <abc_src/base/main/mainInt.h>
 #include <abc_src/base/abc/abc.h>
+#include <abc_src/aig/gia/gia.h>
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -32,165 +46,105 @@ class AigStats
         void setNumAnd(IndexType numAnd) { _numAnd = numAnd; }
         void setLev(IndexType lev) { _lev = lev; }
     private:
-        IndexType  _numIn = 0; ///< Input port
-        IndexType  _numOut = 0; ///< Output port
+        IndexType  _numIn = 0; ///< Primary inputs, without the latch outputs
+        IndexType  _numOut = 0; ///< Primary outputs, without the latch inputs
         IndexType  _numLat = 0; ///< Number of latches
         IndexType  _numAnd = 0; ///< Number of AND
         IndexType  _lev = 0; ///< The deepest logic level
 };
 
 
-// object types
-typedef enum { 
-    AIG_NODE_CONST1= 0, //  0:  constant 1 node
-    AIG_NODE_PO,        //  1:  primary output terminal
-    AIG_NODE_PI,        //  2:  primary input terminal
-    AIG_NODE_NONO,      //  3:  fanin 0: no inverter fanin 1: no inv
-    AIG_NODE_INVNO,     //  4:  fanin 0: has inverter fanin 1: no inverter
-    AIG_NODE_INVINV,    //  5:  fanin 0: has inverter fanin 1: has inverter
-    AIG_NODE_NUMBER     //  6:  unused
-} AigNodeType;
-
-/// @class ABC_PY::AigNode
-/// @brief Single AigNode of the graph. Basically a entry in adjacent list representation
-class AigNode
+/// @class ABC_PY::MemoryUsage
+/// @brief The heap bytes held by an AbcInterface, by component. The ABC network is measured from its memory
+/// managers; the other components are estimated from the capacities of their containers
+class MemoryUsage
 {
     public:
-        /// @brief default constructor
-        explicit AigNode() = default;
-        /// @brief whether has fanin 0
-        /// @return if has fanin 0
-        bool hasFanin0() { return _fanin0 != -1; }
-        /// @brief get the index of fanin 0 node
-        /// @return the index of fanin 0 node
-        IntType fanin0() { AssertMsg(hasFanin0(), "The node does not has fanin 0!\n"); return _fanin0; }
-        /// @brief whether has fanin 1
-        /// @return if has fanin 1
-        bool hasFanin1() { return _fanin1 != -1; }
-        /// @brief get the index of fanin 1 node
-        /// @return the index of fanin 1 node
-        IntType fanin1() { AssertMsg(hasFanin1(), "The node does not has fanin 1!\n"); return _fanin1; }
-        /// @brief Get number of fanouts
-        /// @reutn number of fanouts
-        IntType numFanouts() { return _fanouts.size(); }
-        /// @brief Get the fanout node
-        /// @param the index of nodes saved in this node
-        /// @return the fanout node index in the network
-        IntType fanout(IntType idx) 
-        { 
-            AssertMsg(idx < numFanouts(), "The node only has %d fanouts, but ask for %d-th \n", numFanouts(), idx);
-            return _fanouts[idx];
-        }
-        /// @brief Add one fanout node
-        /// @param The index of the fanout node in the network
-        void addFanout(IntType nodeIdx) { _fanouts.emplace_back(nodeIdx); }
-        /// @brief Set the type of the node
-        /// @param The type of the node. The type of defined in AigNodeType enum
-        void setNodeType(IntType nodeType) { _nodeType = nodeType; }
-        /// @brief Get the type of the node
-        /// @param The type of the node.
-        IntType nodeType()
-        {
-            AssertMsg(_nodeType != AIG_NODE_NUMBER, "Node type is unknown! \n");
-            return _nodeType;
-        }
-        /// @brief Configure the node with Abc_Obj_t
-        /// @param Pointer to Abc_Obj_t
-        void configureNodeFromAbc(Abc_Obj_t *pObj);
+        explicit MemoryUsage() = default;
+        /// @brief the current Abc_Ntk_t: objects, fanin and fanout arrays, port vectors and memory managers
+        std::uint64_t network() const { return _network; }
+        /// @brief the mirrored graph and its level partition
+        std::uint64_t mirror() const { return _mirror; }
+        /// @brief the snapshot of the design read kept by verify(), with the solver and its hash tables
+        std::uint64_t snapshots() const { return _snapshots; }
+        /// @brief the cached mapping results and the structural keys of the step tracking
+        std::uint64_t caches() const { return _caches; }
+        /// @brief the sum of the components
+        std::uint64_t total() const { return _network + _mirror + _snapshots + _caches; }
+        /// @brief the resident set size of the whole process
+        std::uint64_t resident() const { return _resident; }
+        /// @brief the peak resident set size of the whole process
+        std::uint64_t peakResident() const { return _peakResident; }
+
+        void setNetwork(std::uint64_t network) { _network = network; }
+        void setMirror(std::uint64_t mirror) { _mirror = mirror; }
+        void setSnapshots(std::uint64_t snapshots) { _snapshots = snapshots; }
+        void setCaches(std::uint64_t caches) { _caches = caches; }
+        void setResident(std::uint64_t resident) { _resident = resident; }
+        void setPeakResident(std::uint64_t peakResident) { _peakResident = peakResident; }
     private:
-        IntType _fanin0 = -1; ///< The fanin 0. -1 if no fanin 0
-        IntType _fanin1 = -1; ///< The fanin 1. -1 if no fanin 1
-        std::vector<IntType> _fanouts; ///< Indices to fanout nodes
-        IntType _nodeType = 6; ///< The type of this node
+        std::uint64_t _network = 0; ///< The ABC network
+        std::uint64_t _mirror = 0; ///< The mirror
+        std::uint64_t _snapshots = 0; ///< The reference of verify()
+        std::uint64_t _caches = 0; ///< The caches
+        std::uint64_t _resident = 0; ///< The process RSS
+        std::uint64_t _peakResident = 0; ///< The process peak RSS
 };
 
-inline void AigNode::configureNodeFromAbc(Abc_Obj_t *pObj)
+/// @brief The discrete action space over the AbcInterface actions, with the default options
+enum class AbcAction : IntType
 {
-    if (pObj->Type == ABC_OBJ_CONST1)
-    {
-        _nodeType = AIG_NODE_CONST1;
-    }
-    else if (pObj->Type == ABC_OBJ_PI)
-    {
-        _nodeType = AIG_NODE_PI;
-        IntType numFanouts = pObj->vFanouts.nSize;
-        _fanouts.resize(numFanouts);
-        for (IntType fanout = 0; fanout < numFanouts; ++fanout)
-        {
-            IntType idx = pObj->vFanouts.pArray[fanout];
-            _fanouts[fanout] = idx;
-        }
-    }
-    else if (pObj->Type == ABC_OBJ_PO)
-    {
-        _nodeType = AIG_NODE_PO;
-        IntType numFanin = pObj->vFanins.nSize;
-        AssertMsg(numFanin == 1, "PO node has %d fanin \n", numFanin);
-        _fanin0 = pObj->vFanins.pArray[0];
-    }
-    else if (pObj->Type == ABC_OBJ_NODE)
-    {
-        // Determine the type based on whether has inverters, and set fanin
-        if (pObj->fCompl0 == 0 && pObj->fCompl1 == 0)
-        {
-            _nodeType = AIG_NODE_NONO;
-            _fanin0 = pObj->vFanins.pArray[0];
-            _fanin1 = pObj->vFanins.pArray[1];
-        }
-        else if (pObj->fCompl0 == 1 && pObj->fCompl1 == 0)
-        {
-            _nodeType = AIG_NODE_INVNO;
-            _fanin0 = pObj->vFanins.pArray[0];
-            _fanin1 = pObj->vFanins.pArray[1];
-        }
-        else if (pObj->fCompl0 == 0 && pObj->fCompl1 == 1)
-        {
-            _nodeType = AIG_NODE_INVNO;
-            _fanin0 = pObj->vFanins.pArray[1];
-            _fanin1 = pObj->vFanins.pArray[0];
-        }
-        else if (pObj->fCompl0 == 1 && pObj->fCompl1 == 1)
-        {
-            _nodeType = AIG_NODE_INVINV;
-            _fanin0 = pObj->vFanins.pArray[0];
-            _fanin1 = pObj->vFanins.pArray[1];
-        }
-        else
-        {
-            AssertMsg(false, "Unknown fanin complement type \n");
-        }
-        // Fanout can be anything...
-        IntType numFanouts = pObj->vFanouts.nSize;
-        _fanouts.resize(numFanouts);
-        for (IntType fanout = 0; fanout < numFanouts; ++fanout)
-        {
-            IntType idx = pObj->vFanouts.pArray[fanout];
-            _fanouts[fanout] = idx;
-        }
-    }
-    else
-    {
-        AssertMsg(false, "Unexpected node type %d \n", pObj->Type);
-    }
-}
+    BALANCE = 0, ///< b
+    REWRITE = 1, ///< rw
+    REWRITE_Z = 2, ///< rwz
+    REFACTOR = 3, ///< rf
+    REFACTOR_Z = 4, ///< rfz
+    RESUB = 5, ///< rs
+    RESUB_Z = 6, ///< rsz
+    NUMBER = 7 ///< The number of actions
+};
+
+/// @brief The actions on the GIA (&-space) of ABC, with the default options
+enum class GiaAction : IntType
+{
+    BALANCE = 0, ///< &b
+    SYN2 = 1, ///< &syn2
+    DC2 = 2, ///< &dc2
+    DCH = 3, ///< &dch
+    NUMBER = 4 ///< The number of actions
+};
 
 /// @class ABC_PY::AbcInterface
-/// @brief the interface to ABC
+/// @brief the interface to ABC.
+/// The design is either an Abc_Ntk_t, on which the classic actions work, or a Gia_Man_t, on which the &-actions
+/// work, much faster on large designs. Each action moves the design to its own representation when it is not there
+/// yet, so a run of &-actions converts once. The stats and the mirror are read from whichever is current
 class AbcInterface
 {
     public:
         explicit AbcInterface() = default;
+        /// @brief stop counting the environment as live. The framework is left running for the other environments
+        ~AbcInterface();
+        AbcInterface(const AbcInterface &) = delete;
+        AbcInterface & operator=(const AbcInterface &) = delete;
         /*------------------------------*/ 
         /* Start and stop the framework */
         /*------------------------------*/ 
         /// @brief start the ABC framework
         void start();
+        /// @brief the number of environments started in this process and not destroyed. They share the framework,
+        /// so loading a network into a new one replaces theirs. Environments inherited through a fork do not count
+        static IntType numLiveEnvs();
         /// @brief end the ABC framework
         void end();
         /// @brief read a file
         /// @param filename
         /// @return if successful
         bool read(const std::string & filename);
+        /// @brief write the current network, in the format of the file extension, e.g. binary AIGER for .aig
+        /// @param filename
+        /// @return if successful
+        bool write(const std::string &filename);
         /*------------------------------*/ 
         /* Take actions                 */
         /*------------------------------*/ 
@@ -226,28 +180,276 @@ class AbcInterface
         /// @brief compress2rs "b -l; rs -K 6 -l; rw -l; rs -K 6 -N 2 -l; rf -l; rs -K 8 -l; b -l; rs -K 8 -N 2 -l; rw -l; rs -K 10 -l; rwz -l; rs -K 10 -N 2 -l; b -l; rs -K 12 -l; rfz -l; rs -K 12 -N 2 -l; rwz -l; b -l
         /// @return if successful
         bool compress2rs();
+        /// @brief execute any ABC command or script as one action, e.g. "b; rw -l; rf -l". A command starting with & runs on the GIA
+        /// @param the command
+        /// @return if successful
+        bool execute(const std::string &cmd) { return this->executeAction("command", cmd); }
+        /// @brief take an action of the discrete action space
+        /// @param the AbcAction
+        /// @return if successful. False for an action out of the space
+        bool takeAction(IntType action);
+        /*------------------------------*/ 
+        /* GIA actions                  */
+        /*------------------------------*/ 
+        /// @brief &b. balances the AIG in the &-space
+        /// @param -d : toggle duplicating logic to reduce the delay [default = no]
+        /// @return if successful
+        bool giaBalance(bool d = false);
+        /// @brief &syn2. rewrites, balances and refactors in the &-space, the fast counterpart of compress2
+        /// @return if successful
+        bool giaSyn2();
+        /// @brief &dc2. the &-space counterpart of dc2, alternating balancing and rewriting
+        /// @return if successful
+        bool giaDc2();
+        /// @brief &dch. computes structural choices by combining snapshots of synthesis, which the mapping of the GIA uses
+        /// @return if successful
+        bool giaDch();
+        /// @brief take an action of the GIA action space
+        /// @param the GiaAction
+        /// @return if successful. False for an action out of the space
+        bool takeGiaAction(IntType action);
+        /// @brief set whether read() moves the design to the GIA right away, so the stats and the mirror come from it
+        /// @param whether to keep the designs read as GIA
+        void setGiaMode(bool giaMode) { _giaMode = giaMode; }
+        /// @brief whether read() moves the design to the GIA
+        bool giaMode() const { return _giaMode; }
+        /// @brief whether the current design is the GIA rather than the network
+        bool isGiaCurrent() const { return _giaCurrent; }
+        /// @brief whether a design has been loaded into the environment
+        bool hasDesign() const;
+        /// @brief set whether the step result of the actions counts the created and removed nodes. It costs one pass over the network per action
+        /// @param whether to count the nodes
+        void setStepTracking(bool stepTracking) { _stepTracker.setTrackNodes(stepTracking); }
+        /// @brief set the time budget of each action. With a budget, an action runs in a forked copy of the process,
+        /// which is killed at the deadline, leaving the network as before the action; otherwise its network is
+        /// brought back. compress2rs shares one budget among its sub-actions and keeps the network of those finished.
+        /// A timeout fails the action and is reported by lastStep().timedOut(). The &-actions bring their GIA back
+        /// through the network, and the actions refuse a sequential design while a budget is set
+        /// @param the budget in seconds. 0 for none
+        void setActionTimeout(RealType timeoutSec) { _actionTimeout = std::max(timeoutSec, 0.0); }
+        /// @brief get the time budget of each action. 0 for none
+        RealType actionTimeout() const { return _actionTimeout; }
+        /// @brief get the step result of the last action. compress2rs is recorded as one step
+        /// @return the step result
+        const StepResult & lastStep() const { return _stepTracker.lastStep(); }
+        /*------------------------------*/ 
+        /* Verification                 */
+        /*------------------------------*/ 
+        /// @brief check the current network against the network loaded by the last read()
+        /// @return the result. FAIL comes with the failing PO and a counterexample when the interfaces match
+        VerifyResult verify();
+        /// @brief set the conflict limit of each SAT call of verify()
+        /// @param the conflict limit. 0 for no limit
+        void setVerifyConflictLimit(IntType conflictLimit) { _equivChecker.setConflictLimit(conflictLimit); }
+        /*------------------------------*/ 
+        /* Mapping                      */
+        /*------------------------------*/ 
+        /// @brief read the cell library of the standard-cell mapping
+        /// @param a Liberty file, or a genlib file if it ends with .genlib
+        /// @return if successful
+        bool readLibrary(const std::string &filename);
+        /// @brief map a copy of the current network in the background and get its QoR. Results are cached by the network structure
+        /// @param first: the mapping
+        /// @param second: the LUT size of the LUT mapping
+        /// @return the future of the QoR. Ready with a failed QoR if there is no network to map
+        std::shared_future<MappingQoR> mappingQoR(MappingMode mode, IntType lutSize = 6);
+        /// @brief set the largest number of mappings running at once
+        /// @param the number of mapping workers
+        void setMappingWorkers(IntType numWorkers) { _mappingEvaluator.setNumWorkers(numWorkers); }
+        /// @brief drop the cached mapping results
+        void clearMappingCache() { _mappingEvaluator.clearCache(); }
+        /*------------------------------*/ 
+        /* Parameter sweep              */
+        /*------------------------------*/ 
+        /// @brief evaluate the points of a parameter grid on copies of the current network, which is left as is
+        /// @param the sweep with its grid and cache
+        /// @return a row per point, in the order of the grid
+        std::vector<SweepRow> sweep(ParamSweep &paramSweep);
+        /// @brief take the network a sweep point left as the current network, as an action running its command would,
+        /// without running it again. The sweep must keep the networks, see ParamSweep::setKeepNetworks()
+        /// @param the row of the point
+        /// @return if successful. False if the row has no network, e.g. it failed or the network has latches
+        bool takeSweepRow(const SweepRow &row);
+        /*------------------------------*/ 
+        /* Checkpoint                   */
+        /*------------------------------*/ 
+        /// @brief save the current network, the reference network of verify() and the mirrored graph to a file
+        /// @param the file name
+        /// @return if successful. False for a network with latches, which the checkpoint cannot hold
+        bool checkpoint(const std::string &filename);
+        /// @brief replace the current network and the reference network with the ones in a checkpoint file.
+        /// The file is memory-mapped and its arrays are read in place
+        /// @param the file name
+        /// @return if successful
+        bool restore(const std::string &filename);
+        /// @brief encode the state saved by checkpoint() in memory
+        /// @return the checkpoint. Empty if no network is loaded or it has latches
+        std::string serialize();
+        /// @brief restore from a checkpoint in memory
+        /// @param first: the checkpoint
+        /// @param second: the number of bytes
+        /// @return if successful
+        bool deserialize(const char *data, std::size_t size);
+        /*------------------------------*/ 
+        /* Memory                       */
+        /*------------------------------*/ 
+        /// @brief get the bytes held by the network, the mirror, the snapshots and the caches
+        /// @return the memory usage
+        MemoryUsage memoryUsage();
+        /// @brief get the high-water mark of the total bytes held after each kind of action
+        /// @return the bytes by the action name
+        const std::map<std::string, std::uint64_t> & actionMemoryPeaks() const { return _actionMemoryPeaks; }
+        /// @brief set a soft memory cap. Once the total bytes reach it, checkpoints, the verify() snapshot of a design
+        /// read and new mapping cache entries are refused, while the actions keep running
+        /// @param the cap in bytes. 0 for no cap
+        void setMemoryCap(std::uint64_t memoryCap) { _memoryCap = memoryCap; }
+        /// @brief get the soft memory cap. 0 for no cap
+        std::uint64_t memoryCap() const { return _memoryCap; }
         /*------------------------------*/ 
         /* Query the information        */
         /*------------------------------*/ 
-        /// @brief get the design AIG stats from ABC
+        /// @brief get the design AIG stats from ABC. The mirror is updated first, from the network or the GIA alike
         /// @return the AIG stats from ABC
         AigStats aigStats();
         /// @brief get the number of nodes (aig + PI + PO)
         /// @return the number of total nodes
         IntType numNodes();
-        /// @brief update the graph
+        /// @brief update the graph. From the GIA when it is current: the nodes are then indexed by the GIA object id,
+        /// with object 0 as the constant 1 node and the edges from it complemented accordingly
         void updateGraph();
         /// @brief Get one AigNode
         /// @param The index of AigNode
         /// @return The AigNode
         AigNode & aigNode(IntType nodeIdx) 
         { 
-            AssertMsg(nodeIdx < this->numNodes(), "Access node out of range %d / %d \n", nodeIdx, this->numNodes()); 
+            MirrorAccess::checkRange(nodeIdx, _aigNodes.size(), "aigNode");
             return _aigNodes[nodeIdx]; 
         }
+        /// @brief Get all the mirrored AigNodes, indexed by the ABC object id, or by the compact id in the compact mode
+        /// @return the mirrored nodes
+        const std::vector<AigNode> & aigNodes() const { return _aigNodes; }
+        /// @brief Get the generation of the mirror. It moves on with each updateGraph() and each action, so a view
+        /// exported from the mirror is stale once the generation differs from the one it was exported at
+        /// @return the generation
+        std::uint64_t graphGeneration() const { return _graphGeneration; }
+        /// @brief Get the generation the mirror was built at by the last updateGraph(). It lags graphGeneration()
+        /// once an action has run, so a copy of the mirror taken then is stale from the start
+        /// @return the generation of the mirror
+        std::uint64_t mirrorGeneration() const { return _mirrorGeneration; }
+        /// @brief Set whether updateGraph() packs the fanouts of the mirror, sorted and group varint coded.
+        /// It saves most of their memory on large designs, at the cost of decoding on access
+        /// @param whether to pack the fanouts
+        void setCompressedFanouts(bool compressed) { _fanoutLayout.packed = compressed; }
+        /// @brief Whether updateGraph() packs the fanouts
+        bool compressedFanouts() const { return _fanoutLayout.packed; }
+        /// @brief Set whether updateGraph() renumbers the mirror with dense, topologically ordered ids, see AigCompactor.
+        /// Otherwise the mirror is indexed by the ABC object id, with an empty slot for each object deleted
+        /// @param whether to compact the ids
+        void setCompactIds(bool compactIds) { _compactIds = compactIds; }
+        /// @brief Whether updateGraph() compacts the ids
+        bool compactIds() const { return _compactIds; }
+        /// @brief Get the ABC object id of each node of the mirror. Empty unless the ids are compacted
+        const std::vector<IntType> & compactToAbc() const { return _compactor.compactToAbc(); }
+        /// @brief Get the node of the mirror of each ABC object id, -1 for the empty slots. Empty unless the ids are compacted
+        const std::vector<IntType> & abcToCompact() const { return _compactor.abcToCompact(); }
+        /// @brief Get the arena of the mirror. Buffers exported from the mirror may be allocated here; they stay
+        /// valid until the next updateGraph(), which resets the arena
+        /// @return the arena
+        Arena & graphArena() { return _graphArena; }
+        /// @brief Set whether updateGraph() also partitions the graph into topological layers
+        /// @param whether to build the level partition
+        void setLevelPartition(bool levelPartition) { _buildLevelPartition = levelPartition; }
+        /// @brief Get the level partition built by the last updateGraph(). Empty if not enabled
+        /// @return the level partition
+        const AigLevelPartition & levelPartition() const { return _levelPartition; }
+        /// @brief Set whether updateGraph() matches the nodes of the new mirror to those of the last one by structure,
+        /// so per-node state such as embeddings can be carried across the renumbering done by the actions.
+        /// It costs one pass over the mirror and a sort of the keys per update
+        /// @param whether to diff the mirrors
+        void setGraphDiff(bool graphDiff);
+        /// @brief Get the mapping between the mirrors of the last two updateGraph() calls, see AigGraphDiff.
+        /// Empty until two updates have been made with the diff enabled
+        /// @return the mapping
+        const AigGraphDiff & graphDiff() const { return _graphDiff; }
+
+    private:
+        /// @brief execute the command of an action and record its metrics. A command of the &-space runs on the GIA,
+        /// the others on the network; the design is moved there first
+        /// @param first: the action name, used as the metric label
+        /// @param second: the ABC command
+        /// @return if successful
+        bool executeAction(const char *action, const std::string &cmd);
+        /// @brief execute a command in a forked copy of the process within the time left of the step, and take
+        /// its network. The result of an &-command is moved back to the GIA. A design with latches is refused,
+        /// as the network comes back without them
+        /// @param first: the ABC command
+        /// @param second: whether the command runs on the GIA
+        /// @return if successful. A timeout sets _stepTimedOut
+        bool executeWithDeadline(const std::string &cmd, bool onGia);
+        /// @brief in the forked copy, execute a command and encode the network it leaves. The GIA left by an
+        /// &-command is moved to the network first
+        /// @param first: the ABC command
+        /// @param second: whether the command runs on the GIA
+        /// @return the network as checkpoint sections. Empty if the command failed
+        std::string executeInChild(const std::string &cmd, bool onGia);
+        /// @brief in a forked copy, encode the current network, mirrored by its object ids, as checkpoint sections
+        /// @return the sections. Empty if the network has latches
+        std::string encodeNetworkInChild();
+        /// @brief make the GIA the current design, converting the network if needed
+        /// @return if successful
+        bool ensureGia();
+        /// @brief make the network the current design, converting the GIA if needed
+        /// @return if successful
+        bool ensureNetwork();
+        /// @brief the number of AND nodes of the current design
+        IntType currentNumAnd() const;
+        /// @brief update the mirror from the network
+        void updateGraphFromNetwork();
+        /// @brief update the mirror from the GIA
+        void updateGraphFromGia();
+        /// @brief start recording a step, unless already inside one
+        void beginStep();
+        /// @brief finish recording a step when leaving the outermost one
+        /// @param whether the step succeeded
+        void endStep(bool success);
+        /// @brief record the time spent on the current design, if any
+        void finishDesignMetrics();
+        /// @brief get the PI and PO node indices of the current network in the port order
+        /// @param first: the PI node indices
+        /// @param second: the PO node indices
+        void interfaceNodes(std::vector<IntType> &piNodes, std::vector<IntType> &poNodes) const;
+        /// @brief add the sections of the current network, its mirrored graph and the reference network
+        /// @param the checkpoint writer
+        /// @return false if no network is loaded
+        bool addCheckpointSections(CheckpointWriter &writer);
+        /// @brief get the bytes held by the components, without the process figures
+        MemoryUsage heldMemory();
+        /// @brief check a new snapshot or cache entry against the soft memory cap
+        /// @param the kind of memory asked for, used in the warning and as the metric label
+        /// @return whether it is allowed
+        bool admitMemory(const char *kind);
+        /// @class ABC_PY::AbcInterface::ActionMetrics
+        /// @brief The metrics of one action, looked up in the registry once instead of on every action
+        struct ActionMetrics
+        {
+            MetricCounter *actions = nullptr; ///< abc_py_actions_total
+            MetricCounter *failures = nullptr; ///< abc_py_action_failures_total
+            MetricCounter *timeouts = nullptr; ///< abc_py_action_timeouts_total
+            MetricCounter *nodesRemoved = nullptr; ///< abc_py_nodes_removed_total
+            MetricCounter *nodesAdded = nullptr; ///< abc_py_nodes_added_total
+            MetricHistogram *seconds = nullptr; ///< abc_py_action_seconds
+            std::uint64_t *memoryPeak = nullptr; ///< The entry of the action in _actionMemoryPeaks
+        };
+        /// @brief the metrics of an action, registered on its first use
+        /// @param the action name, a string literal
+        ActionMetrics & actionMetrics(const char *action);
+        /// @brief record the memory held after an action in its high-water mark
+        /// @param the metrics of the action
+        void recordActionMemory(ActionMetrics &actionMetrics);
 
     private:
         Abc_Frame_t_ * _pAbc = nullptr; ///< The pointer to the ABC framework
+        pid_t _startPid = -1; ///< The process that started the environment. -1 if not started
         RealType _lastClk; ///< The time of last operation
         IntType _numAigAnds = -1; ///< Number of AIG AND nodes
         IntType _depth = -1; ///< The depth of the AIG network
@@ -255,6 +457,33 @@ class AbcInterface
         IntType _numPO = -1; ///< Number of POs of the AIG network
         IntType _numConst = -1; ///< Number of CONST of the AIG network
         std::vector<AigNode> _aigNodes; ///< The current AIG network nodes
+        Arena _graphArena; ///< Holds the fanouts of the mirror and the buffers exported from it. Reset by updateGraph()
+        FanoutLayout _fanoutLayout; ///< How updateGraph() stores the fanouts
+        bool _compactIds = false; ///< Whether updateGraph() compacts the ids
+        AigCompactor _compactor; ///< Renumbers the mirror in the compact mode, keeping the id maps
+        bool _buildLevelPartition = false; ///< Whether to build the level partition in updateGraph()
+        AigLevelPartition _levelPartition; ///< The topological layers of the current AIG network
+        bool _buildGraphDiff = false; ///< Whether to diff the mirrors in updateGraph()
+        std::vector<std::uint64_t> _graphKeys; ///< The structural keys of the nodes of the mirror. Empty if not diffed
+        std::uint64_t _graphKeysGeneration = 0; ///< The generation of the mirror the keys were taken from
+        AigGraphDiff _graphDiff; ///< The mapping from the last mirror to the current one
+        MetricsTimer _designTimer; ///< Time since the current design was read
+        bool _hasDesign = false; ///< Whether a design has been read and not finished
+        AigEquivChecker _equivChecker; ///< Checks the current network against the network read
+        AigStepTracker _stepTracker; ///< Records the step result of the actions
+        MappingEvaluator _mappingEvaluator; ///< Maps copies of the network in the background
+        IntType _stepNesting = 0; ///< The depth of nested steps, as compress2rs calls other actions
+        RealType _actionTimeout = 0; ///< The time budget of each action in seconds. 0 for none
+        MetricsTimer _stepTimer; ///< Time since the outermost step began, checked against the budget
+        bool _stepTimedOut = false; ///< Whether the current step ran out of time
+        bool _giaMode = false; ///< Whether read() moves the design to the GIA
+        bool _giaCurrent = false; ///< Whether the GIA rather than the network holds the current design
+        std::uint64_t _graphGeneration = 0; ///< Moves on with each updateGraph() and each action
+        std::uint64_t _mirrorGeneration = 0; ///< The generation of the last updateGraph()
+        std::uint64_t _mirrorBytes = 0; ///< The heap bytes of the mirror, measured by updateGraph()
+        std::uint64_t _memoryCap = 0; ///< The soft memory cap. 0 for none
+        std::map<std::string, std::uint64_t> _actionMemoryPeaks; ///< The high-water mark of the bytes held after each action
+        std::unordered_map<const char *, ActionMetrics> _actionMetrics; ///< The metrics by the address of the action name
 };
 
 PROJECT_NAMESPACE_END
@@ -0,0 +1,312 @@
+#include "AigCheckpoint.h"
+#include <cstring>
+#include "util/ByteStream.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the section after another one
+static std::uint32_t sectionId(CheckpointSection section, std::uint32_t offset = 0)
+{
+    return static_cast<std::uint32_t>(section) + offset;
+}
+
+/// @brief the plain form of an AigNode
+static CheckpointNode toCheckpointNode(const AigNode &node)
+{
+    CheckpointNode plain;
+    plain.nodeType = node.isValid() ? node.nodeType() : AIG_NODE_NUMBER;
+    plain.fanin0 = node.hasFanin0() ? node.fanin0() : -1;
+    plain.fanin1 = node.hasFanin1() ? node.fanin1() : -1;
+    plain.level = node.level();
+    plain.poCompl = plain.nodeType == AIG_NODE_PO && node.isFanin0Compl();
+    return plain;
+}
+
+/// @brief configure an AigNode from its plain form. The fanouts are left as they are
+static void fromCheckpointNode(const CheckpointNode &plain, AigNode &node)
+{
+    node.setNodeType(plain.nodeType);
+    node.setFanin0(plain.fanin0);
+    node.setFanin1(plain.fanin1);
+    node.setLevel(plain.level);
+    node.setPoCompl(plain.poCompl != 0);
+}
+
+/// @brief whether a plain node is an AND node
+static bool isAnd(const CheckpointNode &plain)
+{
+    return plain.nodeType == AIG_NODE_NONO || plain.nodeType == AIG_NODE_INVNO || plain.nodeType == AIG_NODE_INVINV;
+}
+
+void AigCheckpoint::addGraph(CheckpointWriter &writer, CheckpointSection nodeSection, const std::vector<AigNode> &nodes,
+        const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes)
+{
+    std::vector<CheckpointNode> plain(nodes.size());
+    for (IndexType nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+    {
+        plain[nodeIdx] = toCheckpointNode(nodes[nodeIdx]);
+    }
+    writer.addArray(sectionId(nodeSection), plain);
+    writer.addArray(sectionId(nodeSection, 1), piNodes);
+    writer.addArray(sectionId(nodeSection, 2), poNodes);
+}
+
+bool AigCheckpoint::readGraph(const CheckpointReader &reader, CheckpointSection nodeSection, std::vector<AigNode> &nodes,
+        std::vector<IntType> &piNodes, std::vector<IntType> &poNodes)
+{
+    std::size_t numNodes = 0, numPis = 0, numPos = 0;
+    const CheckpointNode *plain = reader.array<CheckpointNode>(sectionId(nodeSection), numNodes);
+    const IntType *pis = reader.array<IntType>(sectionId(nodeSection, 1), numPis);
+    const IntType *pos = reader.array<IntType>(sectionId(nodeSection, 2), numPos);
+    if (plain == nullptr || pis == nullptr || pos == nullptr)
+    {
+        return false;
+    }
+    nodes.assign(numNodes, AigNode());
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        const CheckpointNode &node = plain[nodeIdx];
+        if (node.fanin0 < -1 || node.fanin0 >= static_cast<IntType>(numNodes) || node.fanin1 < -1 || node.fanin1 >= static_cast<IntType>(numNodes))
+        {
+            ERR("%s: node %d has a fanin out of range \n", __FUNCTION__, nodeIdx);
+            return false;
+        }
+        fromCheckpointNode(node, nodes[nodeIdx]);
+    }
+    // ABC lists the fanouts of a node in the order they were connected, which the checkpoint does not keep
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        if (plain[nodeIdx].fanin0 >= 0)
+        {
+            nodes[plain[nodeIdx].fanin0].addFanout(nodeIdx);
+        }
+        if (plain[nodeIdx].fanin1 >= 0)
+        {
+            nodes[plain[nodeIdx].fanin1].addFanout(nodeIdx);
+        }
+    }
+    piNodes.assign(pis, pis + numPis);
+    poNodes.assign(pos, pos + numPos);
+    return true;
+}
+
+void AigCheckpoint::addNames(CheckpointWriter &writer, Abc_Ntk_t *pNtk)
+{
+    std::string names = pNtk->pName != nullptr ? pNtk->pName : "";
+    names += '\0';
+    for (IntType pi = 0; pi < Abc_NtkPiNum(pNtk); ++pi)
+    {
+        names += Abc_ObjName(Abc_NtkPi(pNtk, pi));
+        names += '\0';
+    }
+    for (IntType po = 0; po < Abc_NtkPoNum(pNtk); ++po)
+    {
+        names += Abc_ObjName(Abc_NtkPo(pNtk, po));
+        names += '\0';
+    }
+    writer.addSection(sectionId(CheckpointSection::NETWORK_NAMES), std::move(names));
+}
+
+Abc_Ntk_t * AigCheckpoint::buildNetwork(const CheckpointReader &reader)
+{
+    std::size_t numNodes = 0, numPis = 0, numPos = 0;
+    const CheckpointNode *nodes = reader.array<CheckpointNode>(sectionId(CheckpointSection::NETWORK_NODES), numNodes);
+    const IntType *pis = reader.array<IntType>(sectionId(CheckpointSection::NETWORK_PIS), numPis);
+    const IntType *pos = reader.array<IntType>(sectionId(CheckpointSection::NETWORK_POS), numPos);
+    if (nodes == nullptr || pis == nullptr || pos == nullptr)
+    {
+        ERR("%s: the checkpoint has no network \n", __FUNCTION__);
+        return nullptr;
+    }
+    auto inRange = [numNodes](IntType nodeIdx) { return nodeIdx >= 0 && nodeIdx < static_cast<IntType>(numNodes); };
+    Abc_Ntk_t *pNtk = Abc_NtkAlloc(ABC_NTK_STRASH, ABC_FUNC_AIG, 1);
+    std::vector<Abc_Obj_t *> objs(numNodes, nullptr);
+    std::vector<char> visiting(numNodes, 0);
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        if (nodes[nodeIdx].nodeType == AIG_NODE_CONST1)
+        {
+            objs[nodeIdx] = Abc_AigConst1(pNtk);
+        }
+    }
+    // The ports are created first and in order, as ABC numbers them after the constant
+    bool ok = true;
+    for (IndexType pi = 0; pi < numPis && ok; ++pi)
+    {
+        ok = inRange(pis[pi]) && nodes[pis[pi]].nodeType == AIG_NODE_PI && objs[pis[pi]] == nullptr;
+        if (ok)
+        {
+            objs[pis[pi]] = Abc_NtkCreatePi(pNtk);
+        }
+    }
+    std::vector<Abc_Obj_t *> poObjs;
+    for (IndexType po = 0; po < numPos && ok; ++po)
+    {
+        ok = inRange(pos[po]) && nodes[pos[po]].nodeType == AIG_NODE_PO && inRange(nodes[pos[po]].fanin0);
+        if (ok)
+        {
+            poObjs.push_back(Abc_NtkCreatePo(pNtk));
+        }
+    }
+    // Build the AND nodes in depth-first order from the POs, so the fanins always exist
+    std::vector<IntType> stack;
+    for (IndexType po = 0; po < numPos && ok; ++po)
+    {
+        stack.push_back(nodes[pos[po]].fanin0);
+        while (!stack.empty() && ok)
+        {
+            IntType nodeIdx = stack.back();
+            if (objs[nodeIdx] != nullptr)
+            {
+                stack.pop_back();
+                continue;
+            }
+            const CheckpointNode &node = nodes[nodeIdx];
+            ok = isAnd(node) && inRange(node.fanin0) && inRange(node.fanin1);
+            if (!ok)
+            {
+                break;
+            }
+            visiting[nodeIdx] = 1;
+            bool ready = true;
+            for (IntType fanin : { node.fanin0, node.fanin1 })
+            {
+                if (objs[fanin] == nullptr)
+                {
+                    // A fanin still being built is a cycle
+                    ok = ok && !visiting[fanin];
+                    stack.push_back(fanin);
+                    ready = false;
+                }
+            }
+            if (ready)
+            {
+                Abc_Obj_t *pFanin0 = Abc_ObjNotCond(objs[node.fanin0], node.nodeType != AIG_NODE_NONO);
+                Abc_Obj_t *pFanin1 = Abc_ObjNotCond(objs[node.fanin1], node.nodeType == AIG_NODE_INVINV);
+                objs[nodeIdx] = Abc_AigAnd(static_cast<Abc_Aig_t *>(pNtk->pManFunc), pFanin0, pFanin1);
+                stack.pop_back();
+            }
+        }
+    }
+    if (!ok)
+    {
+        ERR("%s: the network in the checkpoint is inconsistent \n", __FUNCTION__);
+        Abc_NtkDelete(pNtk);
+        return nullptr;
+    }
+    for (IndexType po = 0; po < numPos; ++po)
+    {
+        const CheckpointNode &node = nodes[pos[po]];
+        Abc_ObjAddFanin(poObjs[po], Abc_ObjNotCond(objs[node.fanin0], node.poCompl));
+    }
+    // Name the network and the ports, or fall back to the generated names
+    const char *names = nullptr;
+    std::size_t namesSize = 0;
+    std::vector<const char *> nameList;
+    if (reader.section(sectionId(CheckpointSection::NETWORK_NAMES), names, namesSize))
+    {
+        for (std::size_t offset = 0; offset < namesSize; offset += std::strlen(names + offset) + 1)
+        {
+            if (std::memchr(names + offset, '\0', namesSize - offset) == nullptr)
+            {
+                break;
+            }
+            nameList.push_back(names + offset);
+        }
+    }
+    if (nameList.size() == 1 + numPis + numPos)
+    {
+        pNtk->pName = Abc_UtilStrsav(const_cast<char *>(nameList[0]));
+        for (IndexType pi = 0; pi < numPis; ++pi)
+        {
+            Abc_ObjAssignName(objs[pis[pi]], const_cast<char *>(nameList[1 + pi]), nullptr);
+        }
+        for (IndexType po = 0; po < numPos; ++po)
+        {
+            Abc_ObjAssignName(poObjs[po], const_cast<char *>(nameList[1 + numPis + po]), nullptr);
+        }
+    }
+    else
+    {
+        Abc_NtkAddDummyPiNames(pNtk);
+        Abc_NtkAddDummyPoNames(pNtk);
+    }
+    if (!Abc_NtkCheck(pNtk))
+    {
+        ERR("%s: the network built from the checkpoint fails the check \n", __FUNCTION__);
+        Abc_NtkDelete(pNtk);
+        return nullptr;
+    }
+    return pNtk;
+}
+
+std::string AigCheckpoint::encodeStats(const AigStats &stats)
+{
+    ByteWriter out;
+    out.write(stats.numIn());
+    out.write(stats.numOut());
+    out.write(stats.numLat());
+    out.write(stats.numAnd());
+    out.write(stats.lev());
+    CheckpointWriter writer;
+    writer.addSection(sectionId(CheckpointSection::STATS), out.release());
+    return writer.finish();
+}
+
+bool AigCheckpoint::decodeStats(const std::string &bytes, AigStats &stats)
+{
+    CheckpointReader reader;
+    const char *data = nullptr;
+    std::size_t size = 0;
+    if (!reader.open(bytes.data(), bytes.size()) || !reader.section(sectionId(CheckpointSection::STATS), data, size))
+    {
+        return false;
+    }
+    ByteReader in(data, size);
+    IndexType numIn = 0, numOut = 0, numLat = 0, numAnd = 0, lev = 0;
+    if (!in.read(numIn) || !in.read(numOut) || !in.read(numLat) || !in.read(numAnd) || !in.read(lev))
+    {
+        return false;
+    }
+    stats.setNumIn(numIn);
+    stats.setNumOut(numOut);
+    stats.setNumLat(numLat);
+    stats.setNumAnd(numAnd);
+    stats.setLev(lev);
+    return true;
+}
+
+std::string AigCheckpoint::encodeNode(const AigNode &node)
+{
+    FanoutRange range = node.fanouts();
+    std::vector<IntType> fanouts(range.begin(), range.end());
+    CheckpointWriter writer;
+    writer.addArray(sectionId(CheckpointSection::NODE), std::vector<CheckpointNode>(1, toCheckpointNode(node)));
+    writer.addArray(sectionId(CheckpointSection::NODE_FANOUTS), fanouts);
+    return writer.finish();
+}
+
+bool AigCheckpoint::decodeNode(const std::string &bytes, AigNode &node)
+{
+    CheckpointReader reader;
+    std::size_t numNodes = 0, numFanouts = 0;
+    if (!reader.open(bytes.data(), bytes.size()))
+    {
+        return false;
+    }
+    const CheckpointNode *plain = reader.array<CheckpointNode>(sectionId(CheckpointSection::NODE), numNodes);
+    const IntType *fanouts = reader.array<IntType>(sectionId(CheckpointSection::NODE_FANOUTS), numFanouts);
+    if (plain == nullptr || numNodes != 1 || fanouts == nullptr)
+    {
+        return false;
+    }
+    node = AigNode();
+    fromCheckpointNode(*plain, node);
+    for (IndexType idx = 0; idx < numFanouts; ++idx)
+    {
+        node.addFanout(fanouts[idx]);
+    }
+    return true;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,81 @@
+/**
+ * @file AigCheckpoint.h
+ * @brief Encode networks, mirrored graphs and stats into checkpoint sections and build networks back
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_CHECKPOINT_H_
+#define ABC_PY_AIG_CHECKPOINT_H_
+
+#include "interface/AbcInterface.h"
+#include "util/CheckpointFile.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The sections of the checkpoints written by abc_py
+enum class CheckpointSection : std::uint32_t
+{
+    NETWORK_NODES = 1, ///< The mirrored graph of the current network, as CheckpointNode indexed by the ABC object id
+    NETWORK_PIS = 2, ///< The PI nodes of the current network in the PI order
+    NETWORK_POS = 3, ///< The PO nodes of the current network in the PO order
+    NETWORK_NAMES = 4, ///< The network name, the PI names and the PO names, each ended by '\0'
+    REFERENCE_NODES = 5, ///< The mirrored reference network of verify()
+    REFERENCE_PIS = 6, ///< The reference PI nodes
+    REFERENCE_POS = 7, ///< The reference PO nodes
+    STATS = 8, ///< One AigStats
+    NODE = 9, ///< One AigNode, as a CheckpointNode
+    NODE_FANOUTS = 10 ///< The fanouts of the AigNode
+};
+
+/// @class ABC_PY::CheckpointNode
+/// @brief The plain form of an AigNode without its fanouts, read in place from a checkpoint
+struct CheckpointNode
+{
+    std::int32_t nodeType; ///< The AigNodeType. AIG_NODE_NUMBER for an empty slot
+    std::int32_t fanin0; ///< The fanin 0. -1 if none
+    std::int32_t fanin1; ///< The fanin 1. -1 if none
+    std::int32_t level; ///< The logic level
+    std::int32_t poCompl; ///< Whether the fanin of a PO is complemented
+};
+
+/// @class ABC_PY::AigCheckpoint
+/// @brief The encoding of the abc_py objects into checkpoint sections.
+/// A network is stored as its mirrored graph with the port order and names, which is all a strashed
+/// combinational AIG needs, and rebuilt with the ABC AIG constructors. The fanouts are derived again on reading.
+/// Latches are not stored, so the callers refuse sequential networks.
+class AigCheckpoint
+{
+    public:
+        /// @brief add a mirrored graph and its ports
+        /// @param first: the writer
+        /// @param second: the section of the nodes. The PI and PO sections follow it
+        /// @param third: the mirrored graph
+        /// @param fourth: the PI nodes in the PI order
+        /// @param fifth: the PO nodes in the PO order
+        static void addGraph(CheckpointWriter &writer, CheckpointSection nodeSection, const std::vector<AigNode> &nodes,
+                const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes);
+        /// @brief read a mirrored graph and its ports added by addGraph()
+        /// @return if successful
+        static bool readGraph(const CheckpointReader &reader, CheckpointSection nodeSection, std::vector<AigNode> &nodes,
+                std::vector<IntType> &piNodes, std::vector<IntType> &poNodes);
+        /// @brief add the names of the network and its ports
+        static void addNames(CheckpointWriter &writer, Abc_Ntk_t *pNtk);
+        /// @brief build a strashed network from the sections of the current network, reading them in place
+        /// @return the network. nullptr if the sections are missing or inconsistent
+        static Abc_Ntk_t * buildNetwork(const CheckpointReader &reader);
+        /// @brief encode an AigStats as a checkpoint
+        static std::string encodeStats(const AigStats &stats);
+        /// @brief decode an AigStats encoded by encodeStats()
+        /// @return if successful
+        static bool decodeStats(const std::string &bytes, AigStats &stats);
+        /// @brief encode an AigNode, with its fanouts, as a checkpoint
+        static std::string encodeNode(const AigNode &node);
+        /// @brief decode an AigNode encoded by encodeNode()
+        /// @return if successful
+        static bool decodeNode(const std::string &bytes, AigNode &node);
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_CHECKPOINT_H_
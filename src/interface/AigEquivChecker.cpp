@@ -0,0 +1,306 @@
+#include "AigEquivChecker.h"
+#include <numeric>
+#include <abc_src/sat/bsat/satSolver.h>
+#include "graph/AigSimulator.h"
+#include "graph/AigLevelPartition.h"
+#include "util/MemoryStats.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The solver is rebuilt from the reference once it holds this many times the variables of the reference alone
+constexpr IntType SOLVER_RESET_RATIO = 8;
+
+AigEquivChecker::~AigEquivChecker()
+{
+    this->clear();
+}
+
+void AigEquivChecker::clear()
+{
+    if (_solver != nullptr)
+    {
+        sat_solver_delete(_solver);
+        _solver = nullptr;
+    }
+    _numVars = 0;
+    _refNumVars = 0;
+    _refPoLits.clear();
+    _andVars.clear();
+    _provedPairs.clear();
+    _refNodes.clear();
+    _refPis.clear();
+    _refPos.clear();
+    _numChecks = 0;
+    _hasReference = false;
+}
+
+void AigEquivChecker::setReference(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes)
+{
+    this->clear();
+    _refNodes = nodes;
+    _refPis = piNodes;
+    _refPos = poNodes;
+    _hasReference = true;
+}
+
+std::uint64_t AigEquivChecker::memoryBytes() const
+{
+    std::uint64_t bytes = MemoryStats::vectorBytes(_refNodes) + MemoryStats::vectorBytes(_refPis) + MemoryStats::vectorBytes(_refPos)
+        + MemoryStats::vectorBytes(_refPoLits) + MemoryStats::hashBytes(_andVars) + MemoryStats::hashBytes(_provedPairs);
+    for (const AigNode &node : _refNodes)
+    {
+        bytes += node.fanoutBytes();
+    }
+    if (_solver != nullptr)
+    {
+        bytes += static_cast<std::uint64_t>(sat_solver_memory(_solver));
+    }
+    return bytes;
+}
+
+VerifyResult AigEquivChecker::check(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes)
+{
+    VerifyResult result;
+    if (!_hasReference)
+    {
+        ERR("%s: no reference network. Read a design first \n", __FUNCTION__);
+        return result;
+    }
+    if (piNodes.size() != _refPis.size() || poNodes.size() != _refPos.size())
+    {
+        ERR("%s: the reference has %lu PIs and %lu POs, but the network has %lu PIs and %lu POs \n", __FUNCTION__,
+                _refPis.size(), _refPos.size(), piNodes.size(), poNodes.size());
+        result.setStatus(VerifyStatus::FAIL);
+        return result;
+    }
+    ++_numChecks;
+    // Cheap filter first. A simulation mismatch is a real counterexample
+    if (!this->simulate(nodes, piNodes, poNodes, result))
+    {
+        return result;
+    }
+    if (_solver == nullptr || _numVars > SOLVER_RESET_RATIO * _refNumVars)
+    {
+        this->startSolver();
+    }
+    std::vector<IntType> poLits;
+    this->encode(nodes, piNodes, poNodes, poLits);
+    bool undecided = false;
+    IntType numSatCalls = 0;
+    for (IndexType po = 0; po < poNodes.size(); ++po)
+    {
+        IntType lit0 = _refPoLits[po];
+        IntType lit1 = poLits[po];
+        std::uint64_t pair = (static_cast<std::uint64_t>(lit0) << 32) | static_cast<std::uint32_t>(lit1);
+        if (lit0 == lit1 || _provedPairs.count(pair))
+        {
+            // Structurally the same, or proved by an earlier check
+            continue;
+        }
+        // diff <-> lit0 xor lit1
+        lit diff = toLit(this->newVar());
+        this->addClause({lit_neg(diff), lit0, lit1});
+        this->addClause({lit_neg(diff), lit_neg(lit0), lit_neg(lit1)});
+        this->addClause({diff, lit_neg(lit0), lit1});
+        this->addClause({diff, lit0, lit_neg(lit1)});
+        ++numSatCalls;
+        int status = sat_solver_solve(_solver, &diff, &diff + 1, _conflictLimit, 0, 0, 0);
+        if (status == l_False)
+        {
+            // Keep the proved equivalence for the later checks
+            _provedPairs.insert(pair);
+            this->addClause({lit_neg(diff)});
+            this->addClause({lit_neg(lit0), lit1});
+            this->addClause({lit0, lit_neg(lit1)});
+        }
+        else if (status == l_True)
+        {
+            std::vector<IntType> counterexample(piNodes.size());
+            for (IndexType pi = 0; pi < piNodes.size(); ++pi)
+            {
+                counterexample[pi] = sat_solver_var_value(_solver, 1 + pi);
+            }
+            result.setStatus(VerifyStatus::FAIL);
+            result.setFailingOutput(po);
+            result.setCounterexample(counterexample);
+            result.setNumSatCalls(numSatCalls);
+            return result;
+        }
+        else
+        {
+            undecided = true;
+        }
+    }
+    result.setStatus(undecided ? VerifyStatus::UNDECIDED : VerifyStatus::PASS);
+    result.setNumSatCalls(numSatCalls);
+    return result;
+}
+
+bool AigEquivChecker::simulate(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes,
+        VerifyResult &result)
+{
+    IntType numPis = piNodes.size();
+    // The words of each PI in the PI order, fresh for every check
+    std::vector<std::uint64_t> piWords(static_cast<std::size_t>(numPis) * _numSimWords);
+    std::uint64_t seed = klib::splitMix64(_numChecks);
+    for (IntType pi = 0; pi < numPis; ++pi)
+    {
+        std::uint64_t state = klib::splitMix64(seed ^ klib::splitMix64(pi));
+        for (IntType word = 0; word < _numSimWords; ++word)
+        {
+            state = klib::splitMix64(state);
+            piWords[static_cast<std::size_t>(pi) * _numSimWords + word] = state;
+        }
+    }
+    // The simulator takes the pattern rows in the node index order of the PIs
+    auto runSim = [&](AigSimulator &sim, const std::vector<AigNode> &simNodes, const std::vector<IntType> &simPis)
+    {
+        std::vector<IntType> rows(numPis);
+        std::iota(rows.begin(), rows.end(), 0);
+        std::sort(rows.begin(), rows.end(), [&](IntType pi0, IntType pi1) { return simPis[pi0] < simPis[pi1]; });
+        std::vector<std::uint64_t> patterns(piWords.size());
+        for (IntType row = 0; row < numPis; ++row)
+        {
+            std::copy(piWords.begin() + static_cast<std::size_t>(rows[row]) * _numSimWords,
+                    piWords.begin() + static_cast<std::size_t>(rows[row] + 1) * _numSimWords,
+                    patterns.begin() + static_cast<std::size_t>(row) * _numSimWords);
+        }
+        sim.setNumWords(_numSimWords);
+        return sim.simulate(simNodes, patterns);
+    };
+    AigSimulator refSim;
+    AigSimulator sim;
+    if (!runSim(refSim, _refNodes, _refPis) || !runSim(sim, nodes, piNodes))
+    {
+        result.setStatus(VerifyStatus::FAIL);
+        return false;
+    }
+    for (IndexType po = 0; po < poNodes.size(); ++po)
+    {
+        const std::uint64_t *refSig = refSim.signature(_refPos[po]);
+        const std::uint64_t *sig = sim.signature(poNodes[po]);
+        for (IntType word = 0; word < _numSimWords; ++word)
+        {
+            std::uint64_t diff = refSig[word] ^ sig[word];
+            if (diff == 0)
+            {
+                continue;
+            }
+            IntType bit = __builtin_ctzll(diff);
+            std::vector<IntType> counterexample(numPis);
+            for (IntType pi = 0; pi < numPis; ++pi)
+            {
+                counterexample[pi] = (piWords[static_cast<std::size_t>(pi) * _numSimWords + word] >> bit) & 1;
+            }
+            result.setStatus(VerifyStatus::FAIL);
+            result.setFailingOutput(po);
+            result.setCounterexample(counterexample);
+            result.setBySimulation(true);
+            return false;
+        }
+    }
+    return true;
+}
+
+void AigEquivChecker::startSolver()
+{
+    if (_solver != nullptr)
+    {
+        sat_solver_delete(_solver);
+    }
+    _solver = sat_solver_new();
+    _numVars = 0;
+    _andVars.clear();
+    _provedPairs.clear();
+    // Variable 0 is the constant true, and variables 1 to numPIs are the PIs shared by all the networks
+    this->newVar();
+    this->addClause({toLit(0)});
+    for (IndexType pi = 0; pi < _refPis.size(); ++pi)
+    {
+        this->newVar();
+    }
+    this->encode(_refNodes, _refPis, _refPos, _refPoLits);
+    _refNumVars = _numVars;
+}
+
+void AigEquivChecker::encode(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes,
+        std::vector<IntType> &poLits)
+{
+    std::vector<IntType> lits(nodes.size(), -1);
+    for (IndexType pi = 0; pi < piNodes.size(); ++pi)
+    {
+        lits[piNodes[pi]] = toLit(1 + pi);
+    }
+    AigLevelPartition partition;
+    partition.build(nodes);
+    for (IntType nodeIdx : partition.nodeOrder())
+    {
+        const AigNode &node = nodes[nodeIdx];
+        IntType nodeType = node.nodeType();
+        if (nodeType == AIG_NODE_CONST1)
+        {
+            lits[nodeIdx] = toLit(0);
+        }
+        else if (nodeType != AIG_NODE_PI && nodeType != AIG_NODE_PO)
+        {
+            IntType lit0 = lits[node.fanin0()] ^ (node.isFanin0Compl() ? 1 : 0);
+            IntType lit1 = lits[node.fanin1()] ^ (node.isFanin1Compl() ? 1 : 0);
+            lits[nodeIdx] = this->andLit(lit0, lit1);
+        }
+    }
+    poLits.resize(poNodes.size());
+    for (IndexType po = 0; po < poNodes.size(); ++po)
+    {
+        const AigNode &node = nodes[poNodes[po]];
+        AssertMsg(lits[node.fanin0()] >= 0, "PO %lu is driven by an unencoded node \n", po);
+        poLits[po] = lits[node.fanin0()] ^ (node.isFanin0Compl() ? 1 : 0);
+    }
+}
+
+IntType AigEquivChecker::andLit(IntType lit0, IntType lit1)
+{
+    AssertMsg(lit0 >= 0 && lit1 >= 0, "AND node with an unencoded fanin \n");
+    if (lit0 > lit1)
+    {
+        std::swap(lit0, lit1);
+    }
+    // Literal 0 is true and literal 1 is false
+    if (lit0 == 0 || lit0 == lit1)
+    {
+        return lit1;
+    }
+    if (lit0 == 1 || lit0 == lit_neg(lit1))
+    {
+        return 1;
+    }
+    std::uint64_t key = (static_cast<std::uint64_t>(lit0) << 32) | static_cast<std::uint32_t>(lit1);
+    auto iter = _andVars.find(key);
+    if (iter != _andVars.end())
+    {
+        return toLit(iter->second);
+    }
+    IntType var = this->newVar();
+    _andVars[key] = var;
+    lit out = toLit(var);
+    this->addClause({lit_neg(out), lit0});
+    this->addClause({lit_neg(out), lit1});
+    this->addClause({out, lit_neg(lit0), lit_neg(lit1)});
+    return out;
+}
+
+IntType AigEquivChecker::newVar()
+{
+    IntType var = _numVars++;
+    sat_solver_setnvars(_solver, _numVars);
+    return var;
+}
+
+void AigEquivChecker::addClause(std::initializer_list<IntType> lits)
+{
+    // The solver may reorder the literals, so pass a copy
+    lit clause[4];
+    std::copy(lits.begin(), lits.end(), clause);
+    sat_solver_addclause(_solver, clause, clause + lits.size());
+}
+
+PROJECT_NAMESPACE_END
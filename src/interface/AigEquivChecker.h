@@ -0,0 +1,138 @@
+/**
+ * @file AigEquivChecker.h
+ * @brief Combinational equivalence check of the current network against a reference
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_EQUIV_CHECKER_H_
+#define ABC_PY_AIG_EQUIV_CHECKER_H_
+
+#include <unordered_map>
+#include <unordered_set>
+#include "interface/AigNode.h"
+
+struct sat_solver_t;
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the outcome of an equivalence check
+enum class VerifyStatus
+{
+    PASS = 0, ///< All the outputs are proved equivalent
+    FAIL = 1, ///< Some output differs, or the interfaces do not match
+    UNDECIDED = 2 ///< The conflict limit was reached, or there is no reference
+};
+
+/// @class ABC_PY::VerifyResult
+/// @brief The result of AigEquivChecker::check
+class VerifyResult
+{
+    public:
+        explicit VerifyResult() = default;
+        /// @brief get the status
+        VerifyStatus status() const { return _status; }
+        /// @brief whether the check passed
+        bool passed() const { return _status == VerifyStatus::PASS; }
+        /// @brief get the index of the first failing PO. -1 if none, or if the interfaces do not match
+        IntType failingOutput() const { return _failingOutput; }
+        /// @brief get the counterexample, the value of each PI in the PI order. Empty if none
+        const std::vector<IntType> & counterexample() const { return _counterexample; }
+        /// @brief get whether the result was decided by simulation alone
+        bool bySimulation() const { return _bySimulation; }
+        /// @brief get the number of SAT calls made
+        IntType numSatCalls() const { return _numSatCalls; }
+
+        void setStatus(VerifyStatus status) { _status = status; }
+        void setFailingOutput(IntType failingOutput) { _failingOutput = failingOutput; }
+        void setCounterexample(const std::vector<IntType> &counterexample) { _counterexample = counterexample; }
+        void setBySimulation(bool bySimulation) { _bySimulation = bySimulation; }
+        void setNumSatCalls(IntType numSatCalls) { _numSatCalls = numSatCalls; }
+    private:
+        VerifyStatus _status = VerifyStatus::UNDECIDED; ///< The status
+        IntType _failingOutput = -1; ///< The first failing PO
+        std::vector<IntType> _counterexample; ///< The PI values of the counterexample
+        bool _bySimulation = false; ///< Whether simulation decided the result
+        IntType _numSatCalls = 0; ///< The number of SAT calls
+};
+
+/// @class ABC_PY::AigEquivChecker
+/// @brief Check mirrored networks against a reference network, matching the PIs and POs by their order.
+/// Random simulation filters out most non-equivalent networks and gives the counterexample directly.
+/// The remaining outputs are proved by SAT. The solver persists across the checks of one reference:
+/// the AND nodes are structurally hashed onto shared solver variables, so a network that differs
+/// from the previously checked one by a few local rewrites only adds clauses for the new nodes,
+/// and the proved output equivalences and the learnt clauses carry over.
+class AigEquivChecker
+{
+    public:
+        explicit AigEquivChecker() = default;
+        ~AigEquivChecker();
+        AigEquivChecker(const AigEquivChecker &) = delete;
+        AigEquivChecker & operator=(const AigEquivChecker &) = delete;
+        /// @brief set the reference network and reset the solver
+        /// @param first: the mirrored graph
+        /// @param second: the PI node indices in the PI order
+        /// @param third: the PO node indices in the PO order
+        void setReference(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes);
+        /// @brief drop the reference and the solver
+        void clear();
+        /// @brief whether a reference is set
+        bool hasReference() const { return _hasReference; }
+        /// @brief get the mirrored reference network
+        const std::vector<AigNode> & refNodes() const { return _refNodes; }
+        /// @brief get the reference PI nodes in the PI order
+        const std::vector<IntType> & refPis() const { return _refPis; }
+        /// @brief get the reference PO nodes in the PO order
+        const std::vector<IntType> & refPos() const { return _refPos; }
+        /// @brief the heap bytes of the reference network, the solver and the hash tables
+        std::uint64_t memoryBytes() const;
+        /// @brief set the number of 64-bit words of random patterns simulated per check
+        void setNumSimWords(IntType numSimWords) { _numSimWords = std::max(numSimWords, 1); }
+        /// @brief set the conflict limit of each SAT call. 0 for no limit
+        void setConflictLimit(IntType conflictLimit) { _conflictLimit = conflictLimit; }
+        /// @brief check a network against the reference
+        /// @param first: the mirrored graph
+        /// @param second: the PI node indices in the PI order
+        /// @param third: the PO node indices in the PO order
+        /// @return the result
+        VerifyResult check(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes);
+    private:
+        /// @brief simulate both networks on the same random patterns
+        /// @return false and fill the result if some output differs
+        bool simulate(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes,
+                VerifyResult &result);
+        /// @brief start a solver with the constant and the PI variables
+        void startSolver();
+        /// @brief encode a network into the solver
+        /// @param first: the mirrored graph
+        /// @param second: the PI node indices in the PI order
+        /// @param third: the PO node indices in the PO order
+        /// @param fourth: the solver literals of the POs
+        void encode(const std::vector<AigNode> &nodes, const std::vector<IntType> &piNodes, const std::vector<IntType> &poNodes,
+                std::vector<IntType> &poLits);
+        /// @brief get the literal of the AND of two literals, adding a variable and its clauses if new
+        IntType andLit(IntType lit0, IntType lit1);
+        /// @brief get a new solver variable
+        IntType newVar();
+        /// @brief add a clause to the solver
+        void addClause(std::initializer_list<IntType> lits);
+    private:
+        bool _hasReference = false; ///< Whether a reference is set
+        std::vector<AigNode> _refNodes; ///< The mirrored reference network
+        std::vector<IntType> _refPis; ///< The reference PI nodes
+        std::vector<IntType> _refPos; ///< The reference PO nodes
+        IntType _numSimWords = 16; ///< The number of words of random patterns
+        IntType _conflictLimit = 0; ///< The conflict limit of each SAT call
+        std::uint64_t _numChecks = 0; ///< The number of checks against the reference, to vary the patterns
+        sat_solver_t *_solver = nullptr; ///< The persistent solver
+        IntType _numVars = 0; ///< The number of solver variables
+        IntType _refNumVars = 0; ///< The number of solver variables after encoding the reference
+        std::vector<IntType> _refPoLits; ///< The solver literals of the reference POs
+        std::unordered_map<std::uint64_t, IntType> _andVars; ///< The variable of each AND of two literals
+        std::unordered_set<std::uint64_t> _provedPairs; ///< The pairs of reference and network PO literals proved equivalent
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_EQUIV_CHECKER_H_
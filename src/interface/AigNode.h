@@ -0,0 +1,520 @@
+/**
+ * @file AigNode.h
+ * @brief The node of the AIG graph mirrored from ABC
+ * @author Keren Zhu
+ * @date 10/23/2019
+ */
+
+#ifndef ABC_PY_AIG_NODE_H_
+#define ABC_PY_AIG_NODE_H_
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "global/global.h"
+#include "util/AccessPolicy.h"
+#include "util/Arena.h"
+#include "util/GroupVarint.h"
+#include <abc_src/base/abc/abc.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+// object types
+typedef enum { 
+    AIG_NODE_CONST1= 0, //  0:  constant 1 node
+    AIG_NODE_PO,        //  1:  primary output terminal
+    AIG_NODE_PI,        //  2:  primary input terminal
+    AIG_NODE_NONO,      //  3:  fanin 0: no inverter fanin 1: no inv
+    AIG_NODE_INVNO,     //  4:  fanin 0: has inverter fanin 1: no inverter
+    AIG_NODE_INVINV,    //  5:  fanin 0: has inverter fanin 1: has inverter
+    AIG_NODE_NUMBER     //  6:  unused
+} AigNodeType;
+
+/// @class ABC_PY::FanoutLayout
+/// @brief How configureNodeFromAbc() stores the fanouts of the nodes
+struct FanoutLayout
+{
+    Arena *arena = nullptr; ///< The arena of the fanouts. nullptr to hold them in the nodes
+    bool packed = false; ///< Whether to store them sorted, delta and group varint coded. Needs the arena
+    std::vector<std::uint32_t> scratch; ///< The buffer of the coding, reused across the nodes
+};
+
+/// @brief Where the fanouts of an AigNode are stored
+enum class FanoutStorage : std::uint8_t
+{
+    OWNED,  ///< A heap array held by the node
+    ARENA,  ///< A plain array in the arena of the mirror
+    PACKED  ///< Sorted and group varint coded in the arena of the mirror
+};
+
+/// @class ABC_PY::FanoutIterator
+/// @brief Walk the fanouts of a node, plain or packed. A packed list is decoded one group of four at a time
+class FanoutIterator
+{
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef IntType value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const IntType * pointer;
+        typedef IntType reference;
+        /// @brief the end of any list
+        explicit FanoutIterator() = default;
+        /// @brief the start of a plain list
+        /// @param first: the fanouts
+        /// @param second: the number of fanouts
+        explicit FanoutIterator(const IntType *plain, IntType count) : _plain(plain), _remaining(count) {}
+        /// @brief the start of a packed list
+        /// @param first: the first fanout
+        /// @param second: the coded gaps of the other fanouts
+        /// @param third: the end of the coded gaps
+        /// @param fourth: the number of fanouts
+        explicit FanoutIterator(IntType first, const std::uint8_t *packed, const std::uint8_t *packedEnd, IntType count)
+            : _packed(packed), _packedEnd(packedEnd), _remaining(count), _value(first) {}
+        IntType operator*() const { return _plain != nullptr ? *_plain : static_cast<IntType>(_value); }
+        FanoutIterator & operator++()
+        {
+            --_remaining;
+            if (_plain != nullptr)
+            {
+                ++_plain;
+            }
+            else if (_remaining > 0)
+            {
+                if (++_groupPos == 4)
+                {
+                    this->decodeGroup();
+                }
+                else
+                {
+                    _value += _group[_groupPos];
+                }
+            }
+            return *this;
+        }
+        /// @brief iterators of the same list compare by the fanouts left
+        bool operator==(const FanoutIterator &other) const { return _remaining == other._remaining; }
+        bool operator!=(const FanoutIterator &other) const { return _remaining != other._remaining; }
+    private:
+        /// @brief decode the next group and move to its first fanout
+        void decodeGroup()
+        {
+            _packed = GroupVarint::decodeGroup(_packed, _packedEnd - _packed, std::min(_remaining, 4), _group);
+            _groupPos = 0;
+            _value += _group[0];
+        }
+    private:
+        const IntType *_plain = nullptr; ///< The current fanout of a plain list
+        const std::uint8_t *_packed = nullptr; ///< The next group of a packed list
+        const std::uint8_t *_packedEnd = nullptr; ///< The end of a packed list
+        IntType _remaining = 0; ///< The fanouts left, the current one included
+        std::uint32_t _group[4]; ///< The deltas of the current group
+        IntType _groupPos = 3; ///< The position of the current fanout in the group. The first fanout is before the groups
+        std::uint32_t _value = 0; ///< The current fanout of a packed list
+};
+
+/// @class ABC_PY::FanoutRange
+/// @brief The fanouts of a node, for range-based for loops
+class FanoutRange
+{
+    public:
+        explicit FanoutRange(FanoutIterator begin, IntType size) : _begin(begin), _size(size) {}
+        FanoutIterator begin() const { return _begin; }
+        FanoutIterator end() const { return FanoutIterator(); }
+        IntType size() const { return _size; }
+    private:
+        FanoutIterator _begin; ///< The first fanout
+        IntType _size; ///< The number of fanouts
+};
+
+/// @class ABC_PY::AigNode
+/// @brief Single AigNode of the graph. Basically a entry in adjacent list representation.
+/// The fanouts configured from ABC live in the arena of the mirror and stay valid until it is reset; the ones
+/// added one by one and the ones of a copy are held by the node itself, so copies outlive the mirror.
+/// With a packed FanoutLayout the fanouts are sorted and coded as group varint deltas, which takes about a
+/// quarter of the plain bytes; fanouts() decodes them in order, while fanout(idx) decodes up to idx.
+/// The three storages share one union, so a node takes 40 bytes whichever holds its fanouts
+class AigNode
+{
+    public:
+        /// @brief default constructor
+        explicit AigNode() = default;
+        /// @brief copy constructor. The fanouts are copied into the node
+        AigNode(const AigNode &other) { *this = other; }
+        /// @brief move constructor. The fanouts are taken over, wherever they are
+        AigNode(AigNode &&other) noexcept { *this = std::move(other); }
+        ~AigNode() { this->releaseFanouts(); }
+        /// @brief copy assignment. The fanouts are copied into the node
+        AigNode & operator=(const AigNode &other)
+        {
+            if (this != &other)
+            {
+                _fanin0 = other._fanin0;
+                _fanin1 = other._fanin1;
+                this->ownFanouts(other.fanouts(), other._numFanouts);
+                _numFanouts = other._numFanouts;
+                _nodeType = other._nodeType;
+                _level = other._level;
+                _poCompl = other._poCompl;
+            }
+            return *this;
+        }
+        /// @brief move assignment. The fanouts are taken over, wherever they are
+        AigNode & operator=(AigNode &&other) noexcept
+        {
+            if (this != &other)
+            {
+                this->releaseFanouts();
+                _fanin0 = other._fanin0;
+                _fanin1 = other._fanin1;
+                _store = other._store;
+                _storage = other._storage;
+                _numFanouts = other._numFanouts;
+                _nodeType = other._nodeType;
+                _level = other._level;
+                _poCompl = other._poCompl;
+                other._storage = FanoutStorage::OWNED;
+                other._store.owned = OwnedFanouts();
+                other._numFanouts = 0;
+            }
+            return *this;
+        }
+        /// @brief whether has fanin 0
+        /// @return if has fanin 0
+        bool hasFanin0() const { return _fanin0 != -1; }
+        /// @brief get the index of fanin 0 node
+        /// @return the index of fanin 0 node
+        IntType fanin0() const { AssertMsg(hasFanin0(), "The node does not has fanin 0!\n"); return _fanin0; }
+        /// @brief whether has fanin 1
+        /// @return if has fanin 1
+        bool hasFanin1() const { return _fanin1 != -1; }
+        /// @brief get the index of fanin 1 node
+        /// @return the index of fanin 1 node
+        IntType fanin1() const { AssertMsg(hasFanin1(), "The node does not has fanin 1!\n"); return _fanin1; }
+        /// @brief Get number of fanouts
+        /// @reutn number of fanouts
+        IntType numFanouts() const { return _numFanouts; }
+        /// @brief Get the heap bytes of the fanout list held by the node. Those in the arena are counted with the arena
+        std::uint64_t fanoutBytes() const { return _storage == FanoutStorage::OWNED ? _store.owned.capacity * sizeof(IntType) : 0; }
+        /// @brief Get the fanout node
+        /// @param the index of nodes saved in this node
+        /// @return the fanout node index in the network
+        IntType fanout(IntType idx) const
+        { 
+            MirrorAccess::checkRange(idx, _numFanouts, "fanout");
+            if (_storage != FanoutStorage::PACKED)
+            {
+                return this->plainFanouts()[idx];
+            }
+            FanoutIterator iter = this->fanouts().begin();
+            for (IntType pos = 0; pos < idx; ++pos)
+            {
+                ++iter;
+            }
+            return *iter;
+        }
+        /// @brief Get all the fanouts. Sorted if packed, otherwise in the order of ABC
+        /// @return the fanouts
+        FanoutRange fanouts() const
+        {
+            if (_storage == FanoutStorage::PACKED)
+            {
+                const PackedFanouts &packed = _store.packed;
+                return FanoutRange(FanoutIterator(packed.first, packed.bytes, packed.bytes + packed.numBytes, _numFanouts), _numFanouts);
+            }
+            return FanoutRange(FanoutIterator(this->plainFanouts(), _numFanouts), _numFanouts);
+        }
+        /// @brief Whether the fanouts are packed
+        bool isFanoutPacked() const { return _storage == FanoutStorage::PACKED; }
+        /// @brief Where the fanouts are stored
+        FanoutStorage fanoutStorage() const { return _storage; }
+        /// @brief Add one fanout node. The fanouts are moved into the node first if they are in an arena
+        /// @param The index of the fanout node in the network
+        void addFanout(IntType nodeIdx)
+        {
+            if (_storage != FanoutStorage::OWNED || _store.owned.capacity == _numFanouts)
+            {
+                this->ownFanouts(this->fanouts(), std::max(2 * _numFanouts, 4));
+            }
+            _store.owned.data[_numFanouts] = nodeIdx;
+            ++_numFanouts;
+        }
+        /// @brief Set the type of the node
+        /// @param The type of the node. The type of defined in AigNodeType enum
+        void setNodeType(IntType nodeType) { _nodeType = nodeType; }
+        /// @brief Set the fanin 0
+        /// @param The index of the fanin 0 node. -1 for none
+        void setFanin0(IntType fanin0) { _fanin0 = fanin0; }
+        /// @brief Set the fanin 1
+        /// @param The index of the fanin 1 node. -1 for none
+        void setFanin1(IntType fanin1) { _fanin1 = fanin1; }
+        /// @brief Set the logic level
+        /// @param The logic level
+        void setLevel(IntType level) { _level = level; }
+        /// @brief Set whether the fanin of a PO is complemented
+        /// @param if the edge from the fanin has an inverter
+        void setPoCompl(bool poCompl) { _poCompl = poCompl; }
+        /// @brief Get the type of the node
+        /// @param The type of the node.
+        IntType nodeType() const
+        {
+            AssertMsg(_nodeType != AIG_NODE_NUMBER, "Node type is unknown! \n");
+            return _nodeType;
+        }
+        /// @brief Whether fanin 0 is complemented
+        /// @return if the edge from fanin 0 has an inverter
+        bool isFanin0Compl() const 
+        { 
+            return _nodeType == AIG_NODE_INVNO || _nodeType == AIG_NODE_INVINV || (_nodeType == AIG_NODE_PO && _poCompl); 
+        }
+        /// @brief Whether fanin 1 is complemented
+        /// @return if the edge from fanin 1 has an inverter
+        bool isFanin1Compl() const { return _nodeType == AIG_NODE_INVINV; }
+        /// @brief Whether the node has been configured with a known type
+        /// @return if the type is known
+        bool isValid() const { return _nodeType != AIG_NODE_NUMBER; }
+        /// @brief Get the logic level of the node
+        /// @return the level recorded by ABC
+        IntType level() const { return _level; }
+        /// @brief Configure the node with Abc_Obj_t
+        /// @brief All the fields are reset, so a node can be reused across updates
+        /// @param first: Pointer to Abc_Obj_t
+        /// @param second: where to store the fanouts. nullptr to hold them in the node
+        void configureNodeFromAbc(Abc_Obj_t *pObj, FanoutLayout *layout = nullptr);
+        /// @brief Configure the node from its fields, for a mirror built from another representation than Abc_Obj_t.
+        /// All the fields are reset
+        /// @param first: the AigNodeType
+        /// @param second: the fanin 0. -1 for none
+        /// @param third: the fanin 1. -1 for none
+        /// @param fourth: whether the fanin of a PO is complemented
+        /// @param fifth: the logic level
+        /// @param sixth: the fanouts
+        /// @param seventh: the number of fanouts
+        /// @param eighth: where to store the fanouts. nullptr to hold them in the node
+        void configureNode(IntType nodeType, IntType fanin0, IntType fanin1, bool poCompl, IntType level,
+                const IntType *fanouts, IntType numFanouts, FanoutLayout *layout = nullptr);
+    private:
+        /// @brief The fanouts on the heap
+        struct OwnedFanouts
+        {
+            IntType *data = nullptr; ///< The fanouts
+            IntType capacity = 0; ///< The length of the array
+        };
+        /// @brief The packed fanouts in the arena
+        struct PackedFanouts
+        {
+            const std::uint8_t *bytes; ///< The coded gaps between the sorted fanouts
+            IntType numBytes; ///< The bytes of the coded gaps
+            IntType first; ///< The smallest fanout
+        };
+        /// @brief The fanouts in one of the storages, told apart by _storage
+        union FanoutStore
+        {
+            OwnedFanouts owned; ///< FanoutStorage::OWNED
+            const IntType *arena; ///< FanoutStorage::ARENA
+            PackedFanouts packed; ///< FanoutStorage::PACKED
+            FanoutStore() : owned() {}
+        };
+    private:
+        /// @brief the plain fanouts, owned or in the arena
+        const IntType *plainFanouts() const { return _storage == FanoutStorage::OWNED ? _store.owned.data : _store.arena; }
+        /// @brief free the fanouts held by the node and fall back to an empty owned array. The count is kept
+        void releaseFanouts();
+        /// @brief copy fanouts into a new owned array
+        /// @param first: the fanouts, which may be the current ones of the node
+        /// @param second: the capacity of the array, at least the number of fanouts
+        void ownFanouts(FanoutRange fanouts, IntType capacity);
+        /// @brief clear the fanouts
+        void clearFanouts();
+        /// @brief copy the fanouts
+        /// @param first: the first fanout
+        /// @param second: the end of the fanouts
+        /// @param third: where to store them
+        void setFanouts(const IntType *begin, const IntType *end, FanoutLayout *layout);
+    private:
+        IntType _fanin0 = -1; ///< The fanin 0. -1 if no fanin 0
+        IntType _fanin1 = -1; ///< The fanin 1. -1 if no fanin 1
+        FanoutStore _store; ///< Indices to fanout nodes
+        IntType _numFanouts = 0; ///< The number of fanouts
+        IntType _nodeType = 6; ///< The type of this node
+        IntType _level = 0; ///< The logic level of this node
+        FanoutStorage _storage = FanoutStorage::OWNED; ///< Which member of _store holds the fanouts
+        bool _poCompl = false; ///< Whether the fanin of a PO is complemented. AND nodes encode it in the type
+};
+
+inline void AigNode::releaseFanouts()
+{
+    if (_storage == FanoutStorage::OWNED)
+    {
+        delete [] _store.owned.data;
+    }
+    _storage = FanoutStorage::OWNED;
+    _store.owned = OwnedFanouts();
+}
+
+inline void AigNode::ownFanouts(FanoutRange fanouts, IntType capacity)
+{
+    IntType *data = capacity > 0 ? new IntType[capacity] : nullptr;
+    std::copy(fanouts.begin(), fanouts.end(), data);
+    this->releaseFanouts();
+    _store.owned.data = data;
+    _store.owned.capacity = capacity;
+}
+
+inline void AigNode::clearFanouts()
+{
+    // An owned array is kept for the next fanouts, the ones in an arena are dropped with it
+    if (_storage != FanoutStorage::OWNED)
+    {
+        _storage = FanoutStorage::OWNED;
+        _store.owned = OwnedFanouts();
+    }
+    _numFanouts = 0;
+}
+
+inline void AigNode::setFanouts(const IntType *begin, const IntType *end, FanoutLayout *layout)
+{
+    IntType numFanouts = end - begin;
+    if (layout == nullptr || layout->arena == nullptr)
+    {
+        if (_storage != FanoutStorage::OWNED || _store.owned.capacity < numFanouts)
+        {
+            this->ownFanouts(FanoutRange(FanoutIterator(), 0), numFanouts);
+        }
+        std::copy(begin, end, _store.owned.data);
+        _numFanouts = numFanouts;
+        return;
+    }
+    this->releaseFanouts();
+    _numFanouts = numFanouts;
+    if (!layout->packed)
+    {
+        IntType *fanouts = layout->arena->allocateArray<IntType>(_numFanouts);
+        std::copy(begin, end, fanouts);
+        _store.arena = fanouts;
+        _storage = FanoutStorage::ARENA;
+    }
+    else if (_numFanouts > 0)
+    {
+        // The smallest fanout is kept in the node and the others coded as the gap to the one before,
+        // so a node with one fanout takes no bytes and the gaps of nearby fanouts take one each
+        std::vector<std::uint32_t> &deltas = layout->scratch;
+        deltas.assign(begin, end);
+        std::sort(deltas.begin(), deltas.end());
+        PackedFanouts packed;
+        packed.first = deltas[0];
+        for (IntType idx = _numFanouts - 1; idx > 0; --idx)
+        {
+            deltas[idx] -= deltas[idx - 1];
+        }
+        packed.numBytes = GroupVarint::encodedBytes(deltas.data() + 1, _numFanouts - 1);
+        std::uint8_t *bytes = layout->arena->allocateArray<std::uint8_t>(packed.numBytes);
+        GroupVarint::encode(deltas.data() + 1, _numFanouts - 1, bytes);
+        packed.bytes = bytes;
+        _store.packed = packed;
+        _storage = FanoutStorage::PACKED;
+    }
+}
+
+inline void AigNode::configureNodeFromAbc(Abc_Obj_t *pObj, FanoutLayout *layout)
+{
+    _fanin0 = -1;
+    _fanin1 = -1;
+    this->clearFanouts();
+    _nodeType = AIG_NODE_NUMBER;
+    _level = pObj->Level;
+    _poCompl = false;
+    if (pObj->Type == ABC_OBJ_CONST1)
+    {
+        _nodeType = AIG_NODE_CONST1;
+    }
+    else if (pObj->Type == ABC_OBJ_PI)
+    {
+        _nodeType = AIG_NODE_PI;
+        this->setFanouts(pObj->vFanouts.pArray, pObj->vFanouts.pArray + pObj->vFanouts.nSize, layout);
+    }
+    else if (pObj->Type == ABC_OBJ_PO)
+    {
+        _nodeType = AIG_NODE_PO;
+        AssertMsg(pObj->vFanins.nSize == 1, "PO node has %d fanin \n", pObj->vFanins.nSize);
+        _fanin0 = pObj->vFanins.pArray[0];
+        _poCompl = pObj->fCompl0;
+    }
+    else if (pObj->Type == ABC_OBJ_NODE)
+    {
+        // Determine the type based on whether has inverters, and set fanin
+        if (pObj->fCompl0 == 0 && pObj->fCompl1 == 0)
+        {
+            _nodeType = AIG_NODE_NONO;
+            _fanin0 = pObj->vFanins.pArray[0];
+            _fanin1 = pObj->vFanins.pArray[1];
+        }
+        else if (pObj->fCompl0 == 1 && pObj->fCompl1 == 0)
+        {
+            _nodeType = AIG_NODE_INVNO;
+            _fanin0 = pObj->vFanins.pArray[0];
+            _fanin1 = pObj->vFanins.pArray[1];
+        }
+        else if (pObj->fCompl0 == 0 && pObj->fCompl1 == 1)
+        {
+            _nodeType = AIG_NODE_INVNO;
+            _fanin0 = pObj->vFanins.pArray[1];
+            _fanin1 = pObj->vFanins.pArray[0];
+        }
+        else if (pObj->fCompl0 == 1 && pObj->fCompl1 == 1)
+        {
+            _nodeType = AIG_NODE_INVINV;
+            _fanin0 = pObj->vFanins.pArray[0];
+            _fanin1 = pObj->vFanins.pArray[1];
+        }
+        else
+        {
+            AssertMsg(false, "Unknown fanin complement type \n");
+        }
+        // Fanout can be anything...
+        this->setFanouts(pObj->vFanouts.pArray, pObj->vFanouts.pArray + pObj->vFanouts.nSize, layout);
+    }
+    else
+    {
+        AssertMsg(false, "Unexpected node type %d \n", pObj->Type);
+    }
+}
+
+inline void AigNode::configureNode(IntType nodeType, IntType fanin0, IntType fanin1, bool poCompl, IntType level,
+        const IntType *fanouts, IntType numFanouts, FanoutLayout *layout)
+{
+    this->clearFanouts();
+    _fanin0 = fanin0;
+    _fanin1 = fanin1;
+    _nodeType = nodeType;
+    _level = level;
+    _poCompl = nodeType == AIG_NODE_PO && poCompl;
+    this->setFanouts(fanouts, fanouts + numFanouts, layout);
+}
+
+/// @brief export the fanouts of the nodes in CSR form: the fanouts of node i are fanouts[offsets[i], offsets[i + 1])
+/// @param first: the nodes
+/// @param second: the offsets, one more than the nodes
+/// @param third: the fanouts
+template<typename Alloc>
+inline void exportFanouts(const std::vector<AigNode> &nodes, std::vector<IntType, Alloc> &offsets, std::vector<IntType, Alloc> &fanouts)
+{
+    offsets.clear();
+    offsets.reserve(nodes.size() + 1);
+    offsets.push_back(0);
+    for (const AigNode &node : nodes)
+    {
+        offsets.push_back(offsets.back() + node.numFanouts());
+    }
+    fanouts.clear();
+    fanouts.reserve(offsets.back());
+    for (const AigNode &node : nodes)
+    {
+        FanoutRange range = node.fanouts();
+        fanouts.insert(fanouts.end(), range.begin(), range.end());
+    }
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_NODE_H_
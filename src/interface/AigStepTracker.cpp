@@ -0,0 +1,105 @@
+#include "AigStepTracker.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+void AigStepTracker::setTrackNodes(bool trackNodes)
+{
+    _trackNodes = trackNodes;
+    if (!_trackNodes)
+    {
+        _keysValid = false;
+        _keys.clear();
+        _keys.shrink_to_fit();
+    }
+}
+
+void AigStepTracker::begin(Abc_Ntk_t *pNtk)
+{
+    _lastStep = StepResult();
+    _lastStep.setNumAndBefore(Abc_NtkNodeNum(pNtk));
+    _lastStep.setLevBefore(Abc_AigLevel(pNtk));
+    if (_trackNodes && !_keysValid)
+    {
+        AigStructHash::nodeKeys(pNtk, _keys);
+        _keysValid = true;
+    }
+    _timer.reset();
+}
+
+void AigStepTracker::begin(Gia_Man_t *pGia)
+{
+    _lastStep = StepResult();
+    _lastStep.setNumAndBefore(Gia_ManAndNum(pGia));
+    _lastStep.setLevBefore(Gia_ManLevelNum(pGia));
+    if (_trackNodes && !_keysValid)
+    {
+        AigStructHash::nodeKeys(pGia, _keys);
+        _keysValid = true;
+    }
+    _timer.reset();
+}
+
+void AigStepTracker::end(Abc_Ntk_t *pNtk, bool success)
+{
+    _lastStep.setRuntime(_timer.elapsed());
+    _lastStep.setSuccess(success);
+    _lastStep.setNumAndAfter(Abc_NtkNodeNum(pNtk));
+    _lastStep.setLevAfter(Abc_AigLevel(pNtk));
+    if (!_trackNodes)
+    {
+        return;
+    }
+    std::vector<std::uint64_t> keys;
+    AigStructHash::nodeKeys(pNtk, keys);
+    this->diffKeys(keys);
+}
+
+void AigStepTracker::end(Gia_Man_t *pGia, bool success)
+{
+    _lastStep.setRuntime(_timer.elapsed());
+    _lastStep.setSuccess(success);
+    _lastStep.setNumAndAfter(Gia_ManAndNum(pGia));
+    _lastStep.setLevAfter(Gia_ManLevelNum(pGia));
+    if (!_trackNodes)
+    {
+        return;
+    }
+    std::vector<std::uint64_t> keys;
+    AigStructHash::nodeKeys(pGia, keys);
+    this->diffKeys(keys);
+}
+
+void AigStepTracker::diffKeys(std::vector<std::uint64_t> &keys)
+{
+    // Both are sorted, so one merge counts the keys only before and only after
+    IntType numRemoved = 0;
+    IntType numCreated = 0;
+    auto before = _keys.begin();
+    auto after = keys.begin();
+    while (before != _keys.end() && after != keys.end())
+    {
+        if (*before < *after)
+        {
+            ++numRemoved;
+            ++before;
+        }
+        else if (*after < *before)
+        {
+            ++numCreated;
+            ++after;
+        }
+        else
+        {
+            ++before;
+            ++after;
+        }
+    }
+    numRemoved += _keys.end() - before;
+    numCreated += keys.end() - after;
+    _lastStep.setNumCreated(numCreated);
+    _lastStep.setNumRemoved(numRemoved);
+    _keys.swap(keys);
+    _keysValid = true;
+}
+
+PROJECT_NAMESPACE_END
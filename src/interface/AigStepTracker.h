@@ -0,0 +1,118 @@
+/**
+ * @file AigStepTracker.h
+ * @brief Track the change of the network made by one action
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_STEP_TRACKER_H_
+#define ABC_PY_AIG_STEP_TRACKER_H_
+
+#include "global/global.h"
+#include "util/Metrics.h"
+#include "util/MemoryStats.h"
+#include "interface/AigStructHash.h"
+#include <abc_src/base/abc/abc.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::StepResult
+/// @brief The change of the network made by one action
+class StepResult
+{
+    public:
+        explicit StepResult() = default;
+        /// @brief whether the action succeeded
+        bool success() const { return _success; }
+        /// @brief the number of AND nodes before the action
+        IntType numAndBefore() const { return _numAndBefore; }
+        /// @brief the number of AND nodes after the action
+        IntType numAndAfter() const { return _numAndAfter; }
+        /// @brief the depth before the action
+        IntType levBefore() const { return _levBefore; }
+        /// @brief the depth after the action
+        IntType levAfter() const { return _levAfter; }
+        /// @brief the change of the number of AND nodes
+        IntType deltaAnd() const { return _numAndAfter - _numAndBefore; }
+        /// @brief the change of the depth
+        IntType deltaLev() const { return _levAfter - _levBefore; }
+        /// @brief the wall time of the action in seconds
+        RealType runtime() const { return _runtime; }
+        /// @brief the number of AND nodes created by the action. -1 if node tracking is off
+        IntType numCreated() const { return _numCreated; }
+        /// @brief the number of AND nodes removed by the action. -1 if node tracking is off
+        IntType numRemoved() const { return _numRemoved; }
+        /// @brief whether the action ran out of its time budget
+        bool timedOut() const { return _timedOut; }
+
+        void setSuccess(bool success) { _success = success; }
+        void setNumAndBefore(IntType numAndBefore) { _numAndBefore = numAndBefore; }
+        void setNumAndAfter(IntType numAndAfter) { _numAndAfter = numAndAfter; }
+        void setLevBefore(IntType levBefore) { _levBefore = levBefore; }
+        void setLevAfter(IntType levAfter) { _levAfter = levAfter; }
+        void setRuntime(RealType runtime) { _runtime = runtime; }
+        void setNumCreated(IntType numCreated) { _numCreated = numCreated; }
+        void setNumRemoved(IntType numRemoved) { _numRemoved = numRemoved; }
+        void setTimedOut(bool timedOut) { _timedOut = timedOut; }
+    private:
+        bool _success = false; ///< Whether the action succeeded
+        IntType _numAndBefore = 0; ///< Number of AND nodes before
+        IntType _numAndAfter = 0; ///< Number of AND nodes after
+        IntType _levBefore = 0; ///< The depth before
+        IntType _levAfter = 0; ///< The depth after
+        RealType _runtime = 0; ///< The wall time in seconds
+        IntType _numCreated = -1; ///< Number of AND nodes created
+        IntType _numRemoved = -1; ///< Number of AND nodes removed
+        bool _timedOut = false; ///< Whether the action ran out of time
+};
+
+/// @class ABC_PY::AigStepTracker
+/// @brief Record the StepResult of the actions. The node count and the depth are read from ABC in O(1) and O(#PO).
+/// With node tracking, the created and removed nodes are the differences between the structural keys
+/// of the AND nodes before and after, see AigStructHash. The keys after one action are the keys before the next,
+/// so each action costs one pass over the network.
+class AigStepTracker
+{
+    public:
+        explicit AigStepTracker() = default;
+        /// @brief set whether to count the created and removed nodes
+        void setTrackNodes(bool trackNodes);
+        /// @brief whether the created and removed nodes are counted
+        bool trackNodes() const { return _trackNodes; }
+        /// @brief record the state before an action
+        /// @param the current network
+        void begin(Abc_Ntk_t *pNtk);
+        /// @brief record the state after an action and fill the step result
+        /// @param first: the current network, which may have been replaced by the action
+        /// @param second: whether the action succeeded
+        void end(Abc_Ntk_t *pNtk, bool success);
+        /// @brief record the state before an action on the GIA
+        /// @param the current GIA
+        void begin(Gia_Man_t *pGia);
+        /// @brief record the state after an action on the GIA and fill the step result
+        /// @param first: the current GIA, which may have been replaced by the action
+        /// @param second: whether the action succeeded
+        void end(Gia_Man_t *pGia, bool success);
+        /// @brief mark whether the last action ran out of its time budget
+        void setTimedOut(bool timedOut) { _lastStep.setTimedOut(timedOut); }
+        /// @brief drop the cached keys, for when the network is replaced outside the actions
+        void invalidate() { _keysValid = false; }
+        /// @brief get the result of the last action
+        const StepResult & lastStep() const { return _lastStep; }
+        /// @brief the heap bytes of the cached keys
+        std::uint64_t memoryBytes() const { return MemoryStats::vectorBytes(_keys); }
+    private:
+        /// @brief count the created and removed nodes from the keys after the action, which become the cached keys
+        /// @param the sorted keys after the action
+        void diffKeys(std::vector<std::uint64_t> &keys);
+    private:
+        bool _trackNodes = false; ///< Whether to count the created and removed nodes
+        bool _keysValid = false; ///< Whether _keys holds the current network
+        std::vector<std::uint64_t> _keys; ///< The sorted structural keys of the current network
+        MetricsTimer _timer; ///< Time since begin()
+        StepResult _lastStep; ///< The result of the last action
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_STEP_TRACKER_H_
@@ -0,0 +1,97 @@
+#include "AigStructHash.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+void AigStructHash::nodeKeys(Abc_Ntk_t *pNtk, std::vector<std::uint64_t> &keys)
+{
+    std::vector<std::uint64_t> objKeys;
+    objectKeys(pNtk, objKeys, &keys);
+    std::sort(keys.begin(), keys.end());
+}
+
+void AigStructHash::nodeKeys(Gia_Man_t *pGia, std::vector<std::uint64_t> &keys)
+{
+    // The constant of a GIA is constant 0, the complement of the constant 1 of a network
+    std::vector<std::uint64_t> objKeys(Gia_ManObjNum(pGia), STRUCT_KEY_CONST1 ^ STRUCT_KEY_COMPL);
+    for (IntType ci = 0; ci < Gia_ManCiNum(pGia); ++ci)
+    {
+        objKeys[Gia_ObjId(pGia, Gia_ManCi(pGia, ci))] = klib::splitMix64(ci + 1);
+    }
+    // The objects are in topological order. Only the nodes reachable from the COs count, as with the DFS of a network
+    std::vector<char> reached(Gia_ManObjNum(pGia), 0);
+    for (IntType co = 0; co < Gia_ManCoNum(pGia); ++co)
+    {
+        Gia_Obj_t *pObj = Gia_ManCo(pGia, co);
+        reached[Gia_ObjFaninId0(pObj, Gia_ObjId(pGia, pObj))] = 1;
+    }
+    for (IntType id = Gia_ManObjNum(pGia) - 1; id > 0; --id)
+    {
+        Gia_Obj_t *pObj = Gia_ManObj(pGia, id);
+        if (reached[id] && Gia_ObjIsAnd(pObj))
+        {
+            reached[Gia_ObjFaninId0(pObj, id)] = 1;
+            reached[Gia_ObjFaninId1(pObj, id)] = 1;
+        }
+    }
+    keys.clear();
+    for (IntType id = 1; id < Gia_ManObjNum(pGia); ++id)
+    {
+        Gia_Obj_t *pObj = Gia_ManObj(pGia, id);
+        if (!Gia_ObjIsAnd(pObj))
+        {
+            continue;
+        }
+        std::uint64_t key0 = objKeys[Gia_ObjFaninId0(pObj, id)] ^ (Gia_ObjFaninC0(pObj) ? STRUCT_KEY_COMPL : 0);
+        std::uint64_t key1 = objKeys[Gia_ObjFaninId1(pObj, id)] ^ (Gia_ObjFaninC1(pObj) ? STRUCT_KEY_COMPL : 0);
+        objKeys[id] = andKey(key0, key1);
+        if (reached[id])
+        {
+            keys.push_back(objKeys[id]);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+}
+
+std::uint64_t AigStructHash::networkKey(Abc_Ntk_t *pNtk)
+{
+    std::vector<std::uint64_t> objKeys;
+    objectKeys(pNtk, objKeys, nullptr);
+    std::uint64_t key = klib::splitMix64(Abc_NtkCiNum(pNtk));
+    for (IntType co = 0; co < Abc_NtkCoNum(pNtk); ++co)
+    {
+        Abc_Obj_t *pObj = Abc_NtkCo(pNtk, co);
+        key = klib::splitMix64(key ^ objKeys[Abc_ObjFaninId0(pObj)] ^ (Abc_ObjFaninC0(pObj) ? STRUCT_KEY_COMPL : 0));
+    }
+    return key;
+}
+
+void AigStructHash::objectKeys(Abc_Ntk_t *pNtk, std::vector<std::uint64_t> &objKeys, std::vector<std::uint64_t> *nodeKeys)
+{
+    objKeys.assign(Abc_NtkObjNumMax(pNtk), 0);
+    objKeys[Abc_ObjId(Abc_AigConst1(pNtk))] = STRUCT_KEY_CONST1;
+    for (IntType ci = 0; ci < Abc_NtkCiNum(pNtk); ++ci)
+    {
+        objKeys[Abc_ObjId(Abc_NtkCi(pNtk, ci))] = klib::splitMix64(ci + 1);
+    }
+    // The object ids are renumbered by the actions, so use the DFS order rather than the id order
+    Vec_Ptr_t *vNodes = Abc_AigDfs(pNtk, 0, 0);
+    if (nodeKeys != nullptr)
+    {
+        nodeKeys->resize(Vec_PtrSize(vNodes));
+    }
+    for (IntType idx = 0; idx < Vec_PtrSize(vNodes); ++idx)
+    {
+        Abc_Obj_t *pObj = static_cast<Abc_Obj_t *>(Vec_PtrEntry(vNodes, idx));
+        std::uint64_t key0 = objKeys[Abc_ObjFaninId0(pObj)] ^ (Abc_ObjFaninC0(pObj) ? STRUCT_KEY_COMPL : 0);
+        std::uint64_t key1 = objKeys[Abc_ObjFaninId1(pObj)] ^ (Abc_ObjFaninC1(pObj) ? STRUCT_KEY_COMPL : 0);
+        std::uint64_t key = andKey(key0, key1);
+        objKeys[Abc_ObjId(pObj)] = key;
+        if (nodeKeys != nullptr)
+        {
+            (*nodeKeys)[idx] = key;
+        }
+    }
+    Vec_PtrFree(vNodes);
+}
+
+PROJECT_NAMESPACE_END
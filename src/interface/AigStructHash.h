@@ -0,0 +1,65 @@
+/**
+ * @file AigStructHash.h
+ * @brief Structural keys of the nodes of an ABC AIG network, independent of the object ids
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_AIG_STRUCT_HASH_H_
+#define ABC_PY_AIG_STRUCT_HASH_H_
+
+#include <algorithm>
+#include <vector>
+#include "global/global.h"
+#include <abc_src/base/abc/abc.h>
+#include <abc_src/aig/gia/gia.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The key of the constant node
+constexpr std::uint64_t STRUCT_KEY_CONST1 = 0x5bd1e9955bd1e995ULL;
+/// The mask applied to the key of a complemented fanin
+constexpr std::uint64_t STRUCT_KEY_COMPL = 0xc2b2ae3d27d4eb4fULL;
+
+/// @class ABC_PY::AigStructHash
+/// @brief Every AND node gets a 64-bit key hashed from the keys of its fanins and their complements, and the CIs are keyed by their order.
+/// A node keeps its key across the renumbering done by ABC, and a node whose cone was rebuilt gets a new one.
+class AigStructHash
+{
+    public:
+        /// @brief compute the sorted keys of the AND nodes
+        /// @param first: the network
+        /// @param second: the keys
+        static void nodeKeys(Abc_Ntk_t *pNtk, std::vector<std::uint64_t> &keys);
+        /// @brief compute the sorted keys of the AND nodes of a GIA. They equal the keys of the same AIG as a network
+        /// @param first: the GIA
+        /// @param second: the keys
+        static void nodeKeys(Gia_Man_t *pGia, std::vector<std::uint64_t> &keys);
+        /// @brief compute the key of the whole network, from the keys of the COs in order
+        /// @param the network
+        /// @return the key. Structurally identical networks get the same key
+        static std::uint64_t networkKey(Abc_Ntk_t *pNtk);
+        /// @brief the key of an AND node from the keys of its fanins
+        /// @param first: the key of fanin 0, complemented already
+        /// @param second: the key of fanin 1, complemented already
+        /// @return the key
+        static std::uint64_t andKey(std::uint64_t key0, std::uint64_t key1)
+        {
+            // The fanins are unordered
+            if (key0 > key1)
+            {
+                std::swap(key0, key1);
+            }
+            return klib::splitMix64(klib::splitMix64(key0) + key1);
+        }
+    private:
+        /// @brief compute the key of every object, indexed by the object id
+        /// @param first: the network
+        /// @param second: the keys of the objects
+        /// @param third: if not null, the keys of the AND nodes in DFS order
+        static void objectKeys(Abc_Ntk_t *pNtk, std::vector<std::uint64_t> &objKeys, std::vector<std::uint64_t> *nodeKeys);
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_AIG_STRUCT_HASH_H_
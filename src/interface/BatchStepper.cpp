@@ -0,0 +1,311 @@
+#include "BatchStepper.h"
+#include <atomic>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "util/ByteStream.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// Binary AIGER takes about two bytes per AND node, which is what the size of a slot not read yet is estimated from
+constexpr std::uint64_t BATCH_BYTES_PER_AND = 2;
+
+BatchStepper::BatchStepper(IntType numWorkers, const std::string &spillDir)
+{
+    static std::atomic<IntType> numSteppers(0);
+    _spillPrefix = spillDir + "/abc_py_batch_" + std::to_string(::getpid()) + "_" + std::to_string(numSteppers++) + "_";
+    // The workers, and their replacements from the completion thread, are forked by the spawner of the executor
+    _workers.resize(std::max(numWorkers, 1));
+    for (Worker &worker : _workers)
+    {
+        worker.env = _executor.createEnv();
+    }
+    _thread = std::thread([this]() { this->completionLoop(); });
+}
+
+BatchStepper::~BatchStepper()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _thread.join();
+    for (IndexType slotIdx = 0; slotIdx < _slots.size(); ++slotIdx)
+    {
+        if (_slots[slotIdx].spilled)
+        {
+            ::unlink(this->spillPath(slotIdx).c_str());
+        }
+    }
+}
+
+std::string BatchStepper::spillPath(IntType slot) const
+{
+    return _spillPrefix + std::to_string(slot) + ".ckp";
+}
+
+IntType BatchStepper::addSlot(const std::string &design)
+{
+    Slot slot;
+    slot.design = design;
+    struct stat st;
+    if (::stat(design.c_str(), &st) == 0)
+    {
+        slot.size = st.st_size / BATCH_BYTES_PER_AND;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _slots.push_back(std::move(slot));
+    return _slots.size() - 1;
+}
+
+std::uint64_t BatchStepper::step(IntType slot, IntType action)
+{
+    return this->stepBatch({ std::make_pair(slot, action) }).front();
+}
+
+std::vector<std::uint64_t> BatchStepper::stepBatch(const std::vector<std::pair<IntType, IntType>> &steps)
+{
+    std::vector<std::uint64_t> stepIds;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto &pair : steps)
+    {
+        if (pair.first < 0 || pair.first >= static_cast<IntType>(_slots.size()))
+        {
+            ERR("%s: slot %d does not exist \n", __FUNCTION__, pair.first);
+            stepIds.push_back(0);
+            continue;
+        }
+        std::uint64_t stepId = _nextStepId++;
+        stepIds.push_back(stepId);
+        ++_numPending;
+        Slot &slot = _slots[pair.first];
+        if (slot.failed)
+        {
+            this->complete(stepId, pair.first, pair.second, false);
+            continue;
+        }
+        slot.pending.emplace_back(stepId, pair.second);
+    }
+    this->schedule();
+    return stepIds;
+}
+
+std::vector<BatchCompletion> BatchStepper::wait(RealType timeoutSec)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto available = [this]() { return !_completions.empty() || _numPending == 0; };
+    if (timeoutSec < 0)
+    {
+        _completed.wait(lock, available);
+    }
+    else
+    {
+        _completed.wait_for(lock, std::chrono::duration<RealType>(timeoutSec), available);
+    }
+    std::vector<BatchCompletion> completions(_completions.begin(), _completions.end());
+    _completions.clear();
+    return completions;
+}
+
+IntType BatchStepper::numPending()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numPending;
+}
+
+bool BatchStepper::slotFailed(IntType slot)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return slot < 0 || slot >= static_cast<IntType>(_slots.size()) || _slots[slot].failed;
+}
+
+IntType BatchStepper::numSlots()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _slots.size();
+}
+
+void BatchStepper::complete(std::uint64_t stepId, IntType slot, IntType action, bool success, const StepResult &step)
+{
+    BatchCompletion completion;
+    completion.stepId = stepId;
+    completion.slot = slot;
+    completion.action = action;
+    completion.success = success;
+    completion.step = step;
+    _completions.push_back(completion);
+    --_numPending;
+    _completed.notify_all();
+}
+
+void BatchStepper::failSlot(IntType slot)
+{
+    Slot &target = _slots[slot];
+    if (!target.failed)
+    {
+        ERR("%s: slot %d lost its network \n", __FUNCTION__, slot);
+    }
+    target.failed = true;
+    for (const auto &pending : target.pending)
+    {
+        this->complete(pending.first, slot, pending.second, false);
+    }
+    target.pending.clear();
+}
+
+void BatchStepper::replaceWorker(Worker &worker)
+{
+    if (worker.slot >= 0)
+    {
+        _slots[worker.slot].worker = -1;
+        this->failSlot(worker.slot);
+    }
+    worker.slot = -1;
+    worker.env = _executor.createEnv();
+}
+
+void BatchStepper::schedule()
+{
+    auto &switchCounter = MetricsRegistry::instance().counter("abc_py_batch_switches_total", "Slots switched into a batch worker, by a first read or a migration");
+    for (IndexType workerIdx = 0; workerIdx < _workers.size(); ++workerIdx)
+    {
+        Worker &worker = _workers[workerIdx];
+        if (worker.env < 0 || worker.switchTicket != 0 || worker.actionTicket != 0)
+        {
+            continue;
+        }
+        // Serve the slot held first, which costs no migration, then steal the largest waiting slot
+        IntType slotIdx = -1;
+        if (worker.slot >= 0 && _slots[worker.slot].ready())
+        {
+            slotIdx = worker.slot;
+        }
+        else
+        {
+            for (IndexType idx = 0; idx < _slots.size(); ++idx)
+            {
+                if (_slots[idx].worker < 0 && _slots[idx].ready() && (slotIdx < 0 || _slots[idx].size > _slots[slotIdx].size))
+                {
+                    slotIdx = idx;
+                }
+            }
+            if (slotIdx < 0)
+            {
+                continue;
+            }
+            Slot &target = _slots[slotIdx];
+            bool save = worker.slot >= 0 && !_slots[worker.slot].failed;
+            std::string text = (save ? this->spillPath(worker.slot) : "") + "\n" + (target.spilled ? this->spillPath(slotIdx) : target.design);
+            std::uint64_t ticket = _executor.submit(worker.env, AsyncOp::SWITCH, { target.spilled ? 1 : 0 }, text);
+            if (ticket == 0)
+            {
+                this->replaceWorker(worker);
+                continue;
+            }
+            if (worker.slot >= 0)
+            {
+                _slots[worker.slot].worker = -1;
+                _slots[worker.slot].spilled = _slots[worker.slot].spilled || save;
+            }
+            worker.switchTicket = ticket;
+            worker.spillSlot = save ? worker.slot : -1;
+            worker.slot = slotIdx;
+            target.worker = workerIdx;
+            switchCounter.inc();
+        }
+        Slot &slot = _slots[slotIdx];
+        auto next = slot.pending.front();
+        slot.pending.pop_front();
+        std::uint64_t ticket = _executor.submit(worker.env, AsyncOp::ACTION, { next.second });
+        if (ticket == 0)
+        {
+            slot.pending.push_front(next);
+            this->replaceWorker(worker);
+            continue;
+        }
+        worker.actionTicket = ticket;
+        worker.stepId = next.first;
+        worker.action = next.second;
+        slot.running = true;
+    }
+}
+
+void BatchStepper::handle(const AsyncCompletion &completion)
+{
+    for (Worker &worker : _workers)
+    {
+        if (worker.env != completion.env)
+        {
+            continue;
+        }
+        if (completion.ticket == worker.switchTicket)
+        {
+            worker.switchTicket = 0;
+            if (!completion.success)
+            {
+                // Stage 1 means the slot switched out was saved and only the load failed
+                ByteReader reader(completion.payload);
+                std::int32_t stage = -1;
+                reader.read(stage);
+                if (stage != 1 && worker.spillSlot >= 0)
+                {
+                    this->failSlot(worker.spillSlot);
+                }
+                // The action queued behind the switch fails and completes the step
+                this->failSlot(worker.slot);
+            }
+            worker.spillSlot = -1;
+        }
+        else if (completion.ticket == worker.actionTicket)
+        {
+            worker.actionTicket = 0;
+            Slot &slot = _slots[worker.slot];
+            slot.running = false;
+            StepResult step = AbcExecutor::decodeStep(completion.payload);
+            if (completion.success)
+            {
+                slot.size = step.numAndAfter();
+            }
+            this->complete(worker.stepId, worker.slot, worker.action, completion.success && !slot.failed, step);
+            if (slot.failed)
+            {
+                _slots[worker.slot].worker = -1;
+                worker.slot = -1;
+            }
+        }
+        return;
+    }
+}
+
+void BatchStepper::completionLoop()
+{
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_stop)
+            {
+                break;
+            }
+        }
+        struct pollfd pollFd = { _executor.eventFd(), POLLIN, 0 };
+        ::poll(&pollFd, 1, 100);
+        std::vector<AsyncCompletion> completions = _executor.drain();
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const AsyncCompletion &completion : completions)
+        {
+            this->handle(completion);
+        }
+        // A worker that died between calls leaves no completion behind
+        for (Worker &worker : _workers)
+        {
+            if (worker.env >= 0 && worker.switchTicket == 0 && worker.actionTicket == 0 && !_executor.isAlive(worker.env))
+            {
+                this->replaceWorker(worker);
+            }
+        }
+        this->schedule();
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,127 @@
+/**
+ * @file BatchStepper.h
+ * @brief Step many designs at once on a pool of isolated ABC workers, scheduled by size with migration of idle work
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_BATCH_STEPPER_H_
+#define ABC_PY_BATCH_STEPPER_H_
+
+#include <condition_variable>
+#include "interface/AbcExecutor.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::BatchCompletion
+/// @brief A finished step of a slot
+struct BatchCompletion
+{
+    std::uint64_t stepId = 0; ///< The id returned by step()
+    IntType slot = -1; ///< The slot
+    IntType action = -1; ///< The AbcAction
+    bool success = false; ///< Whether the action succeeded. False if the slot failed
+    StepResult step; ///< The step result of the action
+};
+
+/// @class ABC_PY::BatchStepper
+/// @brief Take (slot, action) pairs over many designs and run them on a fixed pool of AbcExecutor workers.
+/// The actions of one slot run in order; different slots run in any order, and completions are returned as they come.
+///
+/// A worker holds the network of one slot at a time and keeps serving it while it has actions waiting. A worker
+/// with nothing of its own steals the largest waiting slot: its current network is checkpointed to the spill
+/// directory and the stolen slot is read, or restored from its own spill file. Taking the largest slot first
+/// starts the long actions early and leaves the small designs to fill the gaps, so the pool stays busy
+/// however skewed the design sizes are. The size of a slot is estimated from its file until its first step
+/// reports the AND count.
+class BatchStepper
+{
+    public:
+        /// @brief start the workers
+        /// @param first: the number of worker processes
+        /// @param second: the directory of the spill files
+        explicit BatchStepper(IntType numWorkers = 4, const std::string &spillDir = "/tmp");
+        /// @brief stop the workers and remove the spill files. Steps not completed are dropped
+        ~BatchStepper();
+        BatchStepper(const BatchStepper &) = delete;
+        BatchStepper & operator=(const BatchStepper &) = delete;
+        /// @brief add a design. It is read by the worker of its first step
+        /// @param the design file
+        /// @return the slot
+        IntType addSlot(const std::string &design);
+        /// @brief queue an action of a slot
+        /// @param first: the slot
+        /// @param second: the AbcAction
+        /// @return the step id. 0 if the slot does not exist
+        std::uint64_t step(IntType slot, IntType action);
+        /// @brief queue a batch of (slot, action) pairs
+        /// @return the step ids, in the order of the pairs
+        std::vector<std::uint64_t> stepBatch(const std::vector<std::pair<IntType, IntType>> &steps);
+        /// @brief wait for completions
+        /// @param the timeout in seconds. Negative to wait until one completes
+        /// @return the completions available. Empty on timeout or when no step is outstanding
+        std::vector<BatchCompletion> wait(RealType timeoutSec = -1);
+        /// @brief the number of steps queued or running
+        IntType numPending();
+        /// @brief whether a slot lost its network, after a crash or a failed migration. Its steps then fail
+        bool slotFailed(IntType slot);
+        /// @brief the number of slots
+        IntType numSlots();
+    private:
+        /// @class ABC_PY::BatchStepper::Slot
+        /// @brief A design and its queued actions
+        struct Slot
+        {
+            std::string design; ///< The design file
+            std::uint64_t size = 0; ///< The number of AND nodes, estimated until the first step
+            bool spilled = false; ///< Whether the network is in the spill file rather than to be read
+            IntType worker = -1; ///< The worker holding the network. -1 if none
+            bool running = false; ///< Whether an action is running
+            bool failed = false; ///< Whether the network is lost
+            std::deque<std::pair<std::uint64_t, IntType>> pending; ///< The step ids and the actions waiting
+            /// @brief whether the slot has an action that can start
+            bool ready() const { return !failed && !running && !pending.empty(); }
+        };
+        /// @class ABC_PY::BatchStepper::Worker
+        /// @brief The scheduling state of a worker
+        struct Worker
+        {
+            IntType env = -1; ///< The environment of the executor
+            IntType slot = -1; ///< The slot whose network the worker holds. -1 if none
+            IntType spillSlot = -1; ///< The slot being spilled by the running switch. -1 if none
+            std::uint64_t switchTicket = 0; ///< The running switch. 0 if none
+            std::uint64_t actionTicket = 0; ///< The running action. 0 if none
+            std::uint64_t stepId = 0; ///< The step of the running action
+            IntType action = -1; ///< The running action
+        };
+        /// @brief start the idle workers on the ready slots. The caller holds the mutex
+        void schedule();
+        /// @brief the loop of the completion thread
+        void completionLoop();
+        /// @brief handle a completion of the executor. The caller holds the mutex
+        void handle(const AsyncCompletion &completion);
+        /// @brief replace a dead worker and fail the slots it held. The caller holds the mutex
+        void replaceWorker(Worker &worker);
+        /// @brief mark a slot failed and fail its waiting steps. The caller holds the mutex
+        void failSlot(IntType slot);
+        /// @brief record a completion. The caller holds the mutex
+        void complete(std::uint64_t stepId, IntType slot, IntType action, bool success, const StepResult &step = StepResult());
+        /// @brief the spill file of a slot
+        std::string spillPath(IntType slot) const;
+    private:
+        AbcExecutor _executor; ///< Runs the workers
+        std::string _spillPrefix; ///< The path prefix of the spill files
+        std::vector<Worker> _workers; ///< The workers
+        std::vector<Slot> _slots; ///< The slots
+        std::deque<BatchCompletion> _completions; ///< The completions not taken yet
+        std::uint64_t _nextStepId = 1; ///< The next step id
+        IntType _numPending = 0; ///< The steps queued or running
+        std::mutex _mutex; ///< Guards the scheduling state
+        std::condition_variable _completed; ///< Signalled on completions
+        bool _stop = false; ///< Whether the completion thread should stop
+        std::thread _thread; ///< The completion thread
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_BATCH_STEPPER_H_
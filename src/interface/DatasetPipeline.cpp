@@ -0,0 +1,331 @@
+#include "DatasetPipeline.h"
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+#include "graph/AigTrajectory.h"
+#include "util/kLibBase.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the manifest of a prefix
+static std::string manifestPath(const std::string &prefix)
+{
+    return prefix + ".manifest";
+}
+
+bool DatasetPipeline::readManifest()
+{
+    _committed.clear();
+    _nextShard = 0;
+    std::string path = manifestPath(_prefix);
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open())
+    {
+        return true;
+    }
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+    std::string text = buffer.str();
+    ifs.close();
+    // Keep the complete records. A run killed while appending leaves a partial one at the end, which is cut off
+    std::vector<std::string> lines;
+    std::vector<std::size_t> lineEnds;
+    std::size_t begin = 0;
+    for (std::size_t pos = text.find('\n'); pos != std::string::npos; pos = text.find('\n', begin))
+    {
+        lines.push_back(text.substr(begin, pos - begin));
+        begin = pos + 1;
+        lineEnds.push_back(begin);
+    }
+    std::size_t validSize = 0;
+    IndexType lineIdx = 0;
+    while (lineIdx < lines.size())
+    {
+        const std::string &line = lines[lineIdx];
+        if (line.compare(0, 2, "F ") == 0)
+        {
+            _committed.insert(line.substr(2));
+            validSize = lineEnds[lineIdx];
+            ++lineIdx;
+            continue;
+        }
+        IntType shardIdx = -1;
+        IndexType count = 0;
+        if (std::sscanf(line.c_str(), "S %d %u", &shardIdx, &count) != 2 || shardIdx < 0 || lineIdx + count >= lines.size())
+        {
+            break;
+        }
+        bool complete = true;
+        for (IndexType idx = 1; idx <= count; ++idx)
+        {
+            complete = complete && lines[lineIdx + idx].compare(0, 2, "D ") == 0;
+        }
+        if (!complete)
+        {
+            break;
+        }
+        for (IndexType idx = 1; idx <= count; ++idx)
+        {
+            _committed.insert(lines[lineIdx + idx].substr(2));
+        }
+        _nextShard = std::max(_nextShard, shardIdx + 1);
+        lineIdx += count + 1;
+        validSize = lineEnds[lineIdx - 1];
+    }
+    if (validSize < text.size() && ::truncate(path.c_str(), validSize) != 0)
+    {
+        ERR("%s: cannot truncate %s \n", __FUNCTION__, path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool DatasetPipeline::appendManifest(const std::string &lines)
+{
+    std::string path = manifestPath(_prefix);
+    FILE *fp = std::fopen(path.c_str(), "ab");
+    if (fp == nullptr)
+    {
+        ERR("%s: cannot open %s \n", __FUNCTION__, path.c_str());
+        return false;
+    }
+    bool success = std::fwrite(lines.data(), 1, lines.size(), fp) == lines.size() && std::fflush(fp) == 0 && ::fsync(::fileno(fp)) == 0;
+    success = std::fclose(fp) == 0 && success;
+    if (!success)
+    {
+        ERR("%s: cannot write %s \n", __FUNCTION__, path.c_str());
+    }
+    return success;
+}
+
+void DatasetPipeline::readerLoop()
+{
+    for (IndexType designIdx = 0; designIdx < _designs.size() && !_stop; ++designIdx)
+    {
+        const std::string &design = _designs[designIdx];
+        if (_committed.count(design) > 0)
+        {
+            ++_numSkipped;
+            continue;
+        }
+        if (::access(design.c_str(), R_OK) != 0)
+        {
+            ERR("%s: cannot read %s \n", __FUNCTION__, design.c_str());
+            Result result;
+            result.designIdx = designIdx;
+            if (!_results->push(std::move(result)))
+            {
+                break;
+            }
+            continue;
+        }
+        Task task;
+        task.designIdx = designIdx;
+        if (!_script.empty())
+        {
+            task.actions = _script;
+        }
+        else
+        {
+            std::mt19937_64 rng(klib::splitMix64(_seed ^ designIdx));
+            std::uniform_int_distribution<IntType> dist(0, static_cast<IntType>(AbcAction::NUMBER) - 1);
+            for (IntType step = 0; step < _numSteps; ++step)
+            {
+                task.actions.push_back(dist(rng));
+            }
+        }
+        if (!_tasks->push(std::move(task)))
+        {
+            break;
+        }
+    }
+    _tasks->close();
+}
+
+bool DatasetPipeline::writerLoop()
+{
+    auto &metrics = MetricsRegistry::instance();
+    auto &designCounter = metrics.counter("abc_py_pipeline_designs_total", "Designs recorded by the dataset pipeline");
+    auto &failureCounter = metrics.counter("abc_py_pipeline_failures_total", "Designs failed in the dataset pipeline");
+    auto &throughput = metrics.gauge("abc_py_pipeline_designs_per_second", "Designs recorded per second by the running dataset pipeline");
+    TrajectoryWriter writer;
+    writer.setPrefix(_prefix);
+    writer.setShardBytes(_shardBytes);
+    writer.setCompressionLevel(_level);
+    writer.setShardIndex(_nextShard);
+    bool success = true;
+    IndexType numCommitted = 0;
+    std::vector<IndexType> inShard;
+    // Commit the designs of each shard closed since the last call
+    auto commitShards = [&]()
+    {
+        while (writer.shards().size() > numCommitted)
+        {
+            std::string lines = "S " + std::to_string(_nextShard + numCommitted) + " " + std::to_string(inShard.size()) + "\n";
+            for (IndexType designIdx : inShard)
+            {
+                lines += "D " + _designs[designIdx] + "\n";
+            }
+            success = this->appendManifest(lines) && success;
+            inShard.clear();
+            ++numCommitted;
+        }
+    };
+    Result result;
+    while (_results->pop(result))
+    {
+        // Keep consuming after an error so the workers are not blocked, but stop writing
+        if (result.success && success)
+        {
+            if (writer.appendBlock(result.block, result.numSteps))
+            {
+                inShard.push_back(result.designIdx);
+                ++_numDone;
+                designCounter.inc();
+                throughput.set(_numDone / std::max(_timer.elapsed(), 1e-9));
+                commitShards();
+                continue;
+            }
+            success = false;
+        }
+        ++_numFailed;
+        failureCounter.inc();
+        if (!result.success && success)
+        {
+            success = this->appendManifest("F " + _designs[result.designIdx] + "\n");
+        }
+    }
+    if (success)
+    {
+        success = writer.close();
+        commitShards();
+    }
+    return success;
+}
+
+bool DatasetPipeline::dispatch(AbcExecutor &executor, std::vector<IntType> &idle)
+{
+    std::map<IntType, IndexType> running; // The design of each busy worker
+    bool tasksLeft = true;
+    bool success = true;
+    while (true)
+    {
+        // Feed the idle workers. Wait for a task only if nothing else can happen
+        while (tasksLeft && !_stop && !idle.empty())
+        {
+            Task task;
+            if (!(running.empty() ? _tasks->pop(task) : _tasks->tryPop(task)))
+            {
+                tasksLeft = !_tasks->done();
+                break;
+            }
+            IntType env = idle.back();
+            if (executor.submit(env, AsyncOp::EPISODE, task.actions, _designs[task.designIdx]) == 0)
+            {
+                ERR("%s: the worker of %s is gone \n", __FUNCTION__, _designs[task.designIdx].c_str());
+                Result result;
+                result.designIdx = task.designIdx;
+                _results->push(std::move(result));
+                idle.pop_back();
+                continue;
+            }
+            running[env] = task.designIdx;
+            idle.pop_back();
+        }
+        if (running.empty())
+        {
+            if (!tasksLeft || _stop || idle.empty())
+            {
+                success = tasksLeft ? _stop.load() : true;
+                break;
+            }
+            continue;
+        }
+        struct pollfd pollFd = { executor.eventFd(), POLLIN, 0 };
+        ::poll(&pollFd, 1, 100);
+        for (AsyncCompletion &completion : executor.drain())
+        {
+            auto iter = running.find(completion.env);
+            if (iter == running.end())
+            {
+                continue;
+            }
+            Result result;
+            result.designIdx = iter->second;
+            result.success = completion.success && AbcExecutor::decodeEpisode(completion.payload, result.block, result.numSteps);
+            running.erase(iter);
+            // A design that crashes its worker fails alone. The worker is replaced
+            IntType env = executor.isAlive(completion.env) ? completion.env : executor.createEnv();
+            if (env >= 0)
+            {
+                idle.push_back(env);
+            }
+            _results->push(std::move(result));
+        }
+    }
+    if (!success)
+    {
+        ERR("%s: all the workers are gone \n", __FUNCTION__);
+    }
+    return success;
+}
+
+bool DatasetPipeline::run()
+{
+    _timer.reset();
+    _numDone = 0;
+    _numFailed = 0;
+    _numSkipped = 0;
+    if (!this->readManifest())
+    {
+        return false;
+    }
+    _tasks.reset(new BoundedQueue<Task>(_queueSize));
+    _results.reset(new BoundedQueue<Result>(_queueSize));
+    AbcExecutor executor;
+    std::vector<IntType> idle;
+    for (IntType workerIdx = 0; workerIdx < _numWorkers; ++workerIdx)
+    {
+        IntType env = executor.createEnv();
+        if (env >= 0)
+        {
+            idle.push_back(env);
+        }
+    }
+    if (idle.empty())
+    {
+        ERR("%s: cannot start the workers \n", __FUNCTION__);
+        return false;
+    }
+    // The workers, the replacements of dead ones included, are forked by the spawner of the executor, which was forked
+    // before the stages start, so they never inherit a lock held by the reader or the writer
+    bool writerSuccess = true;
+    std::thread reader([this]() { this->readerLoop(); });
+    std::thread writer([this, &writerSuccess]() { writerSuccess = this->writerLoop(); });
+    bool success = this->dispatch(executor, idle);
+    // Release the reader if it is waiting on a full queue
+    _tasks->close();
+    reader.join();
+    _results->close();
+    writer.join();
+    return success && writerSuccess;
+}
+
+PipelineStats DatasetPipeline::stats() const
+{
+    PipelineStats stats;
+    stats.numDesigns = _designs.size();
+    stats.numDone = _numDone;
+    stats.numFailed = _numFailed;
+    stats.numSkipped = _numSkipped;
+    stats.elapsed = _timer.elapsed();
+    stats.designsPerSec = stats.numDone / std::max(stats.elapsed, 1e-9);
+    return stats;
+}
+
+PROJECT_NAMESPACE_END
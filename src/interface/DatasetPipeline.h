@@ -0,0 +1,125 @@
+/**
+ * @file DatasetPipeline.h
+ * @brief Generate trajectory datasets over many designs with a reader, a pool of ABC workers and a writer
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_DATASET_PIPELINE_H_
+#define ABC_PY_DATASET_PIPELINE_H_
+
+#include <atomic>
+#include <set>
+#include "interface/AbcExecutor.h"
+#include "util/BoundedQueue.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::PipelineStats
+/// @brief The progress of a DatasetPipeline
+struct PipelineStats
+{
+    IndexType numDesigns = 0; ///< The number of designs given
+    IndexType numDone = 0; ///< The designs recorded in this run
+    IndexType numFailed = 0; ///< The designs that could not be read or whose actions failed, in this run
+    IndexType numSkipped = 0; ///< The designs already recorded or failed by an earlier run
+    RealType elapsed = 0; ///< The seconds since run() started
+    RealType designsPerSec = 0; ///< The throughput of this run
+};
+
+/// @class ABC_PY::DatasetPipeline
+/// @brief Run an action sequence on every design and record the trajectories into shards, see TrajectoryWriter.
+/// A reader thread picks the designs to run and draws their actions, a pool of AbcExecutor workers runs the
+/// episodes in isolated processes, and a writer thread stores the blocks. The stages are connected by bounded
+/// queues, so a slow writer holds back the workers and the workers hold back the reader.
+///
+/// Progress is committed to <prefix>.manifest each time a shard is complete: the shard and the designs in it,
+/// in the order of their trajectories, and the designs that failed. A run that is stopped or killed loses at
+/// most the open shard; running again with the same designs and prefix skips the designs committed and
+/// continues the shard numbering.
+class DatasetPipeline
+{
+    public:
+        explicit DatasetPipeline() = default;
+        /// @brief set the design files
+        void setDesigns(const std::vector<std::string> &designs) { _designs = designs; }
+        /// @brief set the path prefix of the shards and the manifest
+        void setOutputPrefix(const std::string &prefix) { _prefix = prefix; }
+        /// @brief set the number of worker processes
+        void setNumWorkers(IntType numWorkers) { _numWorkers = numWorkers; }
+        /// @brief set the capacity of the queues between the stages
+        void setQueueSize(IntType queueSize) { _queueSize = queueSize; }
+        /// @brief set the number of random actions of each design
+        void setNumSteps(IntType numSteps) { _numSteps = numSteps; }
+        /// @brief set the seed of the random actions. The actions of a design only depend on the seed and the design index
+        void setRandomSeed(std::uint64_t seed) { _seed = seed; }
+        /// @brief set a fixed sequence of AbcAction run on every design instead of random actions
+        void setScript(const std::vector<IntType> &script) { _script = script; }
+        /// @brief set the size after which a shard is closed
+        void setShardBytes(std::uint64_t shardBytes) { _shardBytes = shardBytes; }
+        /// @brief set the zlib level of the trajectory blocks
+        void setCompressionLevel(IntType level) { _level = level; }
+        /// @brief run the pipeline until all the designs are done or stop() is called
+        /// @return false if the output cannot be written or no worker can be started
+        bool run();
+        /// @brief stop taking new designs. The episodes running are finished and committed. Thread-safe
+        void stop() { _stop = true; }
+        /// @brief the progress. Thread-safe
+        PipelineStats stats() const;
+    private:
+        /// @class ABC_PY::DatasetPipeline::Task
+        /// @brief A design to run
+        struct Task
+        {
+            IndexType designIdx = 0; ///< The design
+            std::vector<IntType> actions; ///< The actions
+        };
+        /// @class ABC_PY::DatasetPipeline::Result
+        /// @brief A finished episode
+        struct Result
+        {
+            IndexType designIdx = 0; ///< The design
+            bool success = false; ///< Whether the episode succeeded
+            std::string block; ///< The uncompressed trajectory block
+            IndexType numSteps = 0; ///< The number of steps
+        };
+        /// @brief read the manifest of an earlier run
+        /// @return false if it exists and cannot be read
+        bool readManifest();
+        /// @brief the loop of the reader stage
+        void readerLoop();
+        /// @brief the loop of the writer stage
+        /// @return if all the shards and the manifest were written
+        bool writerLoop();
+        /// @brief run the episodes on the workers until the tasks are exhausted or stop() is called
+        /// @param first: the executor of the workers
+        /// @param second: the idle workers
+        /// @return false if all the workers are gone
+        bool dispatch(AbcExecutor &executor, std::vector<IntType> &idle);
+        /// @brief append lines to the manifest and sync it
+        /// @return if successful
+        bool appendManifest(const std::string &lines);
+    private:
+        std::vector<std::string> _designs; ///< The design files
+        std::string _prefix = "dataset"; ///< The path prefix of the output
+        IntType _numWorkers = 4; ///< The number of worker processes
+        IntType _queueSize = 16; ///< The capacity of the queues
+        IntType _numSteps = 20; ///< The number of random actions of each design
+        std::uint64_t _seed = 0; ///< The seed of the random actions
+        std::vector<IntType> _script; ///< The fixed actions. Empty for random actions
+        std::uint64_t _shardBytes = 256 << 20; ///< The size after which a shard is closed
+        IntType _level = 6; ///< The zlib level
+        std::set<std::string> _committed; ///< The designs committed by earlier runs
+        IntType _nextShard = 0; ///< The index of the first shard of this run
+        std::unique_ptr<BoundedQueue<Task>> _tasks; ///< From the reader to the workers
+        std::unique_ptr<BoundedQueue<Result>> _results; ///< From the workers to the writer
+        std::atomic<bool> _stop{false}; ///< Whether stop() was called
+        std::atomic<IndexType> _numDone{0}; ///< The designs recorded in this run
+        std::atomic<IndexType> _numFailed{0}; ///< The designs failed in this run
+        std::atomic<IndexType> _numSkipped{0}; ///< The designs skipped
+        MetricsTimer _timer; ///< Started by run()
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_DATASET_PIPELINE_H_
@@ -0,0 +1,72 @@
+#include "FanoutBenchmark.h"
+#include <limits>
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief time a function, taking the best of the rounds
+template<typename Func>
+static RealType bestSeconds(IntType numRounds, Func func)
+{
+    RealType best = std::numeric_limits<RealType>::max();
+    for (IntType round = 0; round < std::max(numRounds, 1); ++round)
+    {
+        MetricsTimer timer;
+        func();
+        best = std::min(best, timer.elapsed());
+    }
+    return best;
+}
+
+std::vector<FanoutBenchmark> benchmarkFanouts(AbcInterface &abc, IntType numRounds)
+{
+    std::vector<FanoutBenchmark> results;
+    bool compressed = abc.compressedFanouts();
+    // The sums keep the traversals from being optimized away
+    volatile std::uint64_t sink = 0;
+    for (bool packed : { false, true })
+    {
+        FanoutBenchmark result;
+        result.packed = packed;
+        abc.setCompressedFanouts(packed);
+        result.buildSeconds = bestSeconds(numRounds, [&]() { abc.updateGraph(); });
+        result.fanoutBytes = abc.graphArena().bytesUsed();
+        const std::vector<AigNode> &nodes = abc.aigNodes();
+        result.mirrorBytes = sizeof(AigNode) * nodes.size() + result.fanoutBytes;
+        for (const AigNode &node : nodes)
+        {
+            result.numFanouts += node.numFanouts();
+        }
+        result.iterateSeconds = bestSeconds(numRounds, [&]()
+                {
+                    std::uint64_t sum = 0;
+                    for (const AigNode &node : nodes)
+                    {
+                        for (IntType fanout : node.fanouts())
+                        {
+                            sum += fanout;
+                        }
+                    }
+                    sink = sink + sum;
+                });
+        result.indexSeconds = bestSeconds(numRounds, [&]()
+                {
+                    std::uint64_t sum = 0;
+                    for (const AigNode &node : nodes)
+                    {
+                        for (IntType idx = 0; idx < node.numFanouts(); ++idx)
+                        {
+                            sum += node.fanout(idx);
+                        }
+                    }
+                    sink = sink + sum;
+                });
+        std::vector<IntType> offsets, fanouts;
+        result.exportSeconds = bestSeconds(numRounds, [&]() { exportFanouts(nodes, offsets, fanouts); });
+        results.push_back(result);
+    }
+    abc.setCompressedFanouts(compressed);
+    abc.updateGraph();
+    return results;
+}
+
+PROJECT_NAMESPACE_END
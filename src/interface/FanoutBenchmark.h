@@ -0,0 +1,38 @@
+/**
+ * @file FanoutBenchmark.h
+ * @brief Compare the memory and the traversal speed of the plain and the packed fanouts of the mirror
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_FANOUT_BENCHMARK_H_
+#define ABC_PY_FANOUT_BENCHMARK_H_
+
+#include "interface/AbcInterface.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::FanoutBenchmark
+/// @brief The figures of one layout of the fanouts
+struct FanoutBenchmark
+{
+    bool packed = false; ///< Whether the fanouts are packed
+    std::uint64_t numFanouts = 0; ///< The number of fanouts in the mirror
+    std::uint64_t fanoutBytes = 0; ///< The bytes of the fanouts in the arena
+    std::uint64_t mirrorBytes = 0; ///< The bytes of the nodes and the arena, the whole footprint of the layout
+    RealType buildSeconds = 0; ///< The time of one updateGraph()
+    RealType iterateSeconds = 0; ///< The time of one pass over all the fanouts with the iterators
+    RealType indexSeconds = 0; ///< The time of one pass over all the fanouts with fanout(idx)
+    RealType exportSeconds = 0; ///< The time of one exportFanouts() of the whole mirror
+};
+
+/// @brief Build the mirror of the current network with plain and then packed fanouts and time the accesses.
+/// Each figure is the best of the rounds. The layout set before is restored and the mirror rebuilt
+/// @param first: the interface, with a network loaded
+/// @param second: the number of rounds
+/// @return the plain figures and the packed figures
+std::vector<FanoutBenchmark> benchmarkFanouts(AbcInterface &abc, IntType numRounds = 10);
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_FANOUT_BENCHMARK_H_
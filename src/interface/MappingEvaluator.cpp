@@ -0,0 +1,199 @@
+#include "MappingEvaluator.h"
+#include <algorithm>
+#include "AbcCommand.h"
+#include "interface/AigStructHash.h"
+#include "util/ForkTask.h"
+#include "util/Metrics.h"
+#include "util/MemoryStats.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The number of values sent back by the child
+constexpr IntType MAPPING_QOR_FIELDS = 5;
+
+std::shared_future<MappingQoR> MappingEvaluator::readyFuture(const MappingQoR &qor)
+{
+    std::promise<MappingQoR> promise;
+    promise.set_value(qor);
+    return promise.get_future().share();
+}
+
+/// @brief map the network in the frame and pack the QoR. Runs in the forked child
+static std::string mapInChild(Abc_Frame_t_ *pAbc, MappingMode mode, const std::string &cmd)
+{
+    MetricsTimer timer;
+    RealType fields[MAPPING_QOR_FIELDS] = { 0, 0, 0, 0, 0 };
+    if (Cmd_CommandExecute(pAbc, cmd.c_str()) == 0)
+    {
+        Abc_Ntk_t *pNtk = pAbc->pNtkCur;
+        fields[0] = 1;
+        if (mode == MappingMode::LUT)
+        {
+            fields[1] = Abc_NtkNodeNum(pNtk);
+            fields[2] = Abc_NtkLevel(pNtk);
+        }
+        else
+        {
+            fields[1] = Abc_NtkGetMappedArea(pNtk);
+            fields[2] = Abc_NtkDelayTrace(pNtk, nullptr, nullptr, 0);
+        }
+        fields[3] = Abc_NtkNodeNum(pNtk);
+    }
+    fields[4] = timer.elapsed();
+    return std::string(reinterpret_cast<const char *>(fields), sizeof(fields));
+}
+
+MappingEvaluator::~MappingEvaluator()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _cond.wait(lock, [this]() { return _numRunning == 0; });
+}
+
+std::shared_future<MappingQoR> MappingEvaluator::evaluate(Abc_Frame_t_ *pAbc, MappingMode mode, IntType lutSize, bool cacheResult)
+{
+    auto &metrics = MetricsRegistry::instance();
+    std::string labels = mode == MappingMode::LUT ? "mode=\"lut\"" : "mode=\"cell\"";
+    std::string cmd = mode == MappingMode::LUT ? "if -K " + std::to_string(lutSize) : "map";
+    if (pAbc == nullptr || pAbc->pNtkCur == nullptr)
+    {
+        ERR("%s: there is no network to map \n", __FUNCTION__);
+        return readyFuture(MappingQoR());
+    }
+    std::uint64_t key = AigStructHash::networkKey(pAbc->pNtkCur);
+    key = klib::splitMix64(key ^ klib::splitMix64((static_cast<std::uint64_t>(mode) << 32) | static_cast<std::uint32_t>(lutSize)));
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (mode == MappingMode::CELL)
+    {
+        if (!_hasLibrary)
+        {
+            ERR("%s: read a cell library before the cell mapping \n", __FUNCTION__);
+            return readyFuture(MappingQoR());
+        }
+        key = klib::splitMix64(key ^ _libraryVersion);
+    }
+    auto iter = _cache.find(key);
+    if (iter != _cache.end())
+    {
+        metrics.counter("abc_py_mapping_cache_hits_total", "Number of mapping results served from the cache", labels).inc();
+        return iter->second;
+    }
+    _cond.wait(lock, [this]() { return _numRunning < _numWorkers; });
+    // The network in the frame is copied by the fork. The parent's network is never mapped
+    auto task = std::make_shared<ForkTask>();
+    if (!task->start([pAbc, mode, cmd]() { return mapInChild(pAbc, mode, cmd); }))
+    {
+        return readyFuture(MappingQoR());
+    }
+    ++_numRunning;
+    metrics.counter("abc_py_mappings_total", "Number of mappings run", labels).inc();
+    std::shared_future<MappingQoR> future = std::async(std::launch::async, [this, task, key, labels]()
+    {
+        std::string bytes;
+        MappingQoR qor;
+        if (task->finish(bytes) == ForkStatus::OK && bytes.size() == sizeof(RealType) * MAPPING_QOR_FIELDS)
+        {
+            RealType fields[MAPPING_QOR_FIELDS];
+            std::copy(bytes.begin(), bytes.end(), reinterpret_cast<char *>(fields));
+            qor.setSuccess(fields[0] != 0);
+            qor.setArea(fields[1]);
+            qor.setDelay(fields[2]);
+            qor.setNumCells(static_cast<IntType>(fields[3]));
+            qor.setRuntime(fields[4]);
+        }
+        auto &metrics = MetricsRegistry::instance();
+        if (qor.success())
+        {
+            metrics.histogram("abc_py_mapping_seconds", "Wall time of one mapping", labels).observe(qor.runtime());
+        }
+        else
+        {
+            metrics.counter("abc_py_mapping_failures_total", "Number of failed mappings", labels).inc();
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            // Let a failed state be retried
+            if (!qor.success())
+            {
+                _cache.erase(key);
+            }
+            --_numRunning;
+            // Notify under the lock: once it is released the destructor may return and free the condition variable
+            _cond.notify_all();
+        }
+        return qor;
+    }).share();
+    if (cacheResult)
+    {
+        _cache[key] = future;
+        // The key of a failed mapping may still be queued. Move it to the back rather than queue it twice
+        auto orderIter = std::find(_cacheOrder.begin(), _cacheOrder.end(), key);
+        if (orderIter != _cacheOrder.end())
+        {
+            _cacheOrder.erase(orderIter);
+        }
+        _cacheOrder.push_back(key);
+        this->trimCache();
+    }
+    return future;
+}
+
+void MappingEvaluator::setNumWorkers(IntType numWorkers)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _numWorkers = std::max(numWorkers, 1);
+    }
+    _cond.notify_all();
+}
+
+void MappingEvaluator::setCacheSize(IntType cacheSize)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cacheSize = std::max(cacheSize, 0);
+    this->trimCache();
+}
+
+IntType MappingEvaluator::numCached()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _cache.size();
+}
+
+void MappingEvaluator::clearCache()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache.clear();
+    _cacheOrder.clear();
+}
+
+std::uint64_t MappingEvaluator::cacheBytes()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Each result also holds the shared state of its future, about the QoR and a few pointers
+    return MemoryStats::hashBytes(_cache) + _cache.size() * (sizeof(MappingQoR) + 8 * sizeof(void *))
+        + _cacheOrder.size() * sizeof(std::uint64_t);
+}
+
+void MappingEvaluator::trimCache()
+{
+    while (static_cast<IntType>(_cache.size()) > _cacheSize && !_cacheOrder.empty())
+    {
+        _cache.erase(_cacheOrder.front());
+        _cacheOrder.pop_front();
+    }
+    // Keys of failed mappings leave the cache early, so keep the order from growing past it
+    if (_cacheOrder.size() > 2 * _cache.size() + 64)
+    {
+        std::deque<std::uint64_t> order;
+        for (std::uint64_t key : _cacheOrder)
+        {
+            if (_cache.count(key))
+            {
+                order.push_back(key);
+            }
+        }
+        _cacheOrder.swap(order);
+    }
+}
+
+PROJECT_NAMESPACE_END
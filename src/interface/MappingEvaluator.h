@@ -0,0 +1,108 @@
+/**
+ * @file MappingEvaluator.h
+ * @brief Post-mapping QoR of the current network, evaluated in the background and cached
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_MAPPING_EVALUATOR_H_
+#define ABC_PY_MAPPING_EVALUATOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include "global/global.h"
+#include <abc_src/base/main/mainInt.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The technology mapping
+enum class MappingMode
+{
+    LUT = 0, ///< FPGA mapping into K-input LUTs, `if -K <K>`
+    CELL = 1 ///< Standard-cell mapping with the library read by readLibrary(), `map`
+};
+
+/// @class ABC_PY::MappingQoR
+/// @brief The quality of results after mapping
+class MappingQoR
+{
+    public:
+        explicit MappingQoR() = default;
+        /// @brief whether the mapping succeeded
+        bool success() const { return _success; }
+        /// @brief the area. The number of LUTs, or the total cell area
+        RealType area() const { return _area; }
+        /// @brief the delay. The LUT depth, or the arrival time of the critical path
+        RealType delay() const { return _delay; }
+        /// @brief the number of LUTs or cells
+        IntType numCells() const { return _numCells; }
+        /// @brief the wall time of the mapping in seconds
+        RealType runtime() const { return _runtime; }
+
+        void setSuccess(bool success) { _success = success; }
+        void setArea(RealType area) { _area = area; }
+        void setDelay(RealType delay) { _delay = delay; }
+        void setNumCells(IntType numCells) { _numCells = numCells; }
+        void setRuntime(RealType runtime) { _runtime = runtime; }
+    private:
+        bool _success = false; ///< Whether the mapping succeeded
+        RealType _area = 0; ///< The area
+        RealType _delay = 0; ///< The delay
+        IntType _numCells = 0; ///< The number of LUTs or cells
+        RealType _runtime = 0; ///< The wall time in seconds
+};
+
+/// @class ABC_PY::MappingEvaluator
+/// @brief Map the current network in a forked child, so the network in the frame is never touched, and return a future.
+/// Results are memoised by the structural key of the network together with the mapping settings,
+/// so a state that was seen before returns the same future without mapping again.
+class MappingEvaluator
+{
+    public:
+        explicit MappingEvaluator() = default;
+        /// @brief wait for the mappings in flight
+        ~MappingEvaluator();
+        MappingEvaluator(const MappingEvaluator &) = delete;
+        MappingEvaluator & operator=(const MappingEvaluator &) = delete;
+        /// @brief start mapping the current network, or get the cached result
+        /// @param first: the ABC framework
+        /// @param second: the mapping
+        /// @param third: the LUT size for the LUT mapping
+        /// @param fourth: whether a new result may be cached
+        /// @return the future of the QoR. Ready with a failed QoR if there is no network
+        std::shared_future<MappingQoR> evaluate(Abc_Frame_t_ *pAbc, MappingMode mode, IntType lutSize, bool cacheResult = true);
+        /// @brief get a future that already holds the result, e.g. a failed QoR for a network that cannot be mapped
+        static std::shared_future<MappingQoR> readyFuture(const MappingQoR &qor);
+        /// @brief note that a new cell library was read, so the cached cell mappings no longer apply
+        void setLibraryRead() { std::lock_guard<std::mutex> lock(_mutex); _hasLibrary = true; ++_libraryVersion; }
+        /// @brief set the largest number of mappings running at once. evaluate() blocks while all are busy
+        void setNumWorkers(IntType numWorkers);
+        /// @brief set the largest number of cached results. The oldest ones are dropped first
+        void setCacheSize(IntType cacheSize);
+        /// @brief get the number of cached results
+        IntType numCached();
+        /// @brief drop the cached results
+        void clearCache();
+        /// @brief get the estimated heap bytes of the cached results
+        std::uint64_t cacheBytes();
+    private:
+        /// @brief drop the oldest results until the cache fits. The caller holds the mutex
+        void trimCache();
+    private:
+        std::mutex _mutex; ///< Guards the members below
+        std::condition_variable _cond; ///< Signalled when a mapping finishes
+        IntType _numWorkers = 4; ///< The largest number of mappings at once
+        IntType _numRunning = 0; ///< The number of mappings running
+        IntType _cacheSize = 65536; ///< The largest number of cached results
+        bool _hasLibrary = false; ///< Whether a cell library was read
+        std::uint64_t _libraryVersion = 0; ///< Incremented by each library read
+        std::unordered_map<std::uint64_t, std::shared_future<MappingQoR>> _cache; ///< The results by key
+        std::deque<std::uint64_t> _cacheOrder; ///< The keys in insertion order
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_MAPPING_EVALUATOR_H_
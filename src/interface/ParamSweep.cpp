@@ -0,0 +1,282 @@
+#include "ParamSweep.h"
+#include <cerrno>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <poll.h>
+#include "AbcCommand.h"
+#include "interface/AigStructHash.h"
+#include "util/ForkTask.h"
+#include "util/Metrics.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The number of values sent back by the child
+constexpr IntType SWEEP_FIELDS = 4;
+
+/// @brief run a point on the network in the frame and pack its result, followed by the network it left if it is
+/// to be kept. Runs in the forked child
+static std::string sweepInChild(Abc_Frame_t_ *pAbc, const std::string &cmd, const std::function<std::string()> &encodeNetwork)
+{
+    MetricsTimer timer;
+    RealType fields[SWEEP_FIELDS] = { 0, 0, 0, 0 };
+    if (Cmd_CommandExecute(pAbc, cmd.c_str()) == 0)
+    {
+        fields[0] = 1;
+        fields[1] = Abc_NtkNodeNum(pAbc->pNtkCur);
+        fields[2] = Abc_AigLevel(pAbc->pNtkCur);
+    }
+    fields[3] = timer.elapsed();
+    std::string result(reinterpret_cast<const char *>(fields), sizeof(fields));
+    if (fields[0] != 0 && encodeNetwork)
+    {
+        result += encodeNetwork();
+    }
+    return result;
+}
+
+/// @brief append a flag with a value, unless the value is -1
+static void appendFlag(std::string &cmd, const char *flag, IntType value)
+{
+    if (value != -1)
+    {
+        cmd += std::string(" ") + flag + " " + std::to_string(value);
+    }
+}
+
+/// @brief append a toggle if set
+static void appendToggle(std::string &cmd, const char *flag, bool value)
+{
+    if (value)
+    {
+        cmd += std::string(" ") + flag;
+    }
+}
+
+void ParamSweep::addResub(const std::vector<IntType> &ks, const std::vector<IntType> &ns, const std::vector<bool> &ls, const std::vector<bool> &zs)
+{
+    for (IntType k : ks)
+    {
+        for (IntType n : ns)
+        {
+            for (bool l : ls)
+            {
+                for (bool z : zs)
+                {
+                    std::string cmd = "resub";
+                    appendFlag(cmd, "-K", k);
+                    appendFlag(cmd, "-N", n);
+                    appendToggle(cmd, "-l", l);
+                    appendToggle(cmd, "-z", z);
+                    _commands.push_back(cmd);
+                }
+            }
+        }
+    }
+}
+
+void ParamSweep::addRefactor(const std::vector<IntType> &ns, const std::vector<bool> &ls, const std::vector<bool> &zs)
+{
+    for (IntType n : ns)
+    {
+        for (bool l : ls)
+        {
+            for (bool z : zs)
+            {
+                std::string cmd = "refactor";
+                appendFlag(cmd, "-N", n);
+                appendToggle(cmd, "-l", l);
+                appendToggle(cmd, "-z", z);
+                _commands.push_back(cmd);
+            }
+        }
+    }
+}
+
+void ParamSweep::addRewrite(const std::vector<bool> &ls, const std::vector<bool> &zs)
+{
+    for (bool l : ls)
+    {
+        for (bool z : zs)
+        {
+            std::string cmd = "rewrite";
+            appendToggle(cmd, "-l", l);
+            appendToggle(cmd, "-z", z);
+            _commands.push_back(cmd);
+        }
+    }
+}
+
+void ParamSweep::addBalance(const std::vector<bool> &ls)
+{
+    for (bool l : ls)
+    {
+        std::string cmd = "balance";
+        appendToggle(cmd, "-l", l);
+        _commands.push_back(cmd);
+    }
+}
+
+std::vector<SweepRow> ParamSweep::run(Abc_Frame_t_ *pAbc, const std::function<std::string()> &encodeNetwork)
+{
+    auto &metrics = MetricsRegistry::instance();
+    std::vector<SweepRow> rows(_commands.size());
+    for (IndexType rowIdx = 0; rowIdx < rows.size(); ++rowIdx)
+    {
+        rows[rowIdx].command = _commands[rowIdx];
+    }
+    if (pAbc == nullptr || pAbc->pNtkCur == nullptr)
+    {
+        ERR("%s: no network is loaded \n", __FUNCTION__);
+        return rows;
+    }
+    if (_keepNetworks && !encodeNetwork)
+    {
+        ERR("%s: the networks of the points cannot be kept without an encoder \n", __FUNCTION__);
+        return rows;
+    }
+    MetricsTimer timer;
+    std::uint64_t networkKey = AigStructHash::networkKey(pAbc->pNtkCur);
+    std::vector<std::uint64_t> keys(rows.size());
+    std::vector<IntType> pending;
+    for (IndexType rowIdx = 0; rowIdx < rows.size(); ++rowIdx)
+    {
+        keys[rowIdx] = klib::splitMix64(networkKey ^ std::hash<std::string>()(rows[rowIdx].command));
+        auto iter = _cache.find(keys[rowIdx]);
+        // A row cached without its network cannot serve a sweep keeping them
+        if (iter != _cache.end() && (!_keepNetworks || !iter->second.network.empty()))
+        {
+            rows[rowIdx] = iter->second;
+            rows[rowIdx].cached = true;
+            metrics.counter("abc_py_sweep_points_total", "Number of sweep points evaluated", "cached=\"true\"").inc();
+        }
+        else
+        {
+            pending.push_back(rowIdx);
+        }
+    }
+    /// A point running in its child
+    struct Running
+    {
+        IntType rowIdx; ///< The row of the point
+        std::unique_ptr<ForkTask> task; ///< The child
+        MetricsTimer timer; ///< Time since the start
+    };
+    // Fill the row of a point from its child, which has finished or run out of its budget
+    auto collect = [&](Running &point)
+    {
+        SweepRow &row = rows[point.rowIdx];
+        std::string bytes;
+        ForkStatus status = point.task->finish(bytes, _timeout > 0 ? std::max(_timeout - point.timer.elapsed(), 0.0) : -1);
+        row.timedOut = status == ForkStatus::TIMEOUT;
+        if (status == ForkStatus::OK && bytes.size() >= sizeof(RealType) * SWEEP_FIELDS)
+        {
+            RealType fields[SWEEP_FIELDS];
+            std::copy(bytes.begin(), bytes.begin() + sizeof(fields), reinterpret_cast<char *>(fields));
+            row.success = fields[0] != 0;
+            row.numAnd = static_cast<IntType>(fields[1]);
+            row.lev = static_cast<IntType>(fields[2]);
+            row.runtime = fields[3];
+            row.network = bytes.substr(sizeof(fields));
+        }
+        else
+        {
+            row.runtime = point.timer.elapsed();
+        }
+        // Only the successful rows are cached, so a failed point is retried
+        if (row.success)
+        {
+            _cache[keys[point.rowIdx]] = row;
+        }
+        metrics.counter("abc_py_sweep_points_total", "Number of sweep points evaluated", "cached=\"false\"").inc();
+    };
+    // The children are collected as they finish, each within its own budget from its own start, and a finished
+    // child frees its slot for the next point right away
+    std::vector<Running> running;
+    std::vector<struct pollfd> pfds;
+    IndexType nextIdx = 0;
+    while (nextIdx < pending.size() || !running.empty())
+    {
+        while (nextIdx < pending.size() && static_cast<IntType>(running.size()) < _numWorkers)
+        {
+            IntType rowIdx = pending[nextIdx++];
+            const std::string &cmd = rows[rowIdx].command;
+            Running point { rowIdx, std::unique_ptr<ForkTask>(new ForkTask()), MetricsTimer() };
+            std::function<std::string()> encode = _keepNetworks ? encodeNetwork : nullptr;
+            if (point.task->start([pAbc, &cmd, encode]() { return sweepInChild(pAbc, cmd, encode); }))
+            {
+                running.push_back(std::move(point));
+            }
+        }
+        if (running.empty())
+        {
+            continue;
+        }
+        // Wait for any child to write, up to the nearest deadline
+        int waitMs = -1;
+        pfds.resize(running.size());
+        for (IndexType idx = 0; idx < running.size(); ++idx)
+        {
+            pfds[idx].fd = running[idx].task->fd();
+            pfds[idx].events = POLLIN;
+            pfds[idx].revents = 0;
+            if (_timeout > 0)
+            {
+                int leftMs = static_cast<int>(std::ceil(std::max(_timeout - running[idx].timer.elapsed(), 0.0) * 1000));
+                waitMs = waitMs < 0 ? leftMs : std::min(waitMs, leftMs);
+            }
+        }
+        if (::poll(pfds.data(), pfds.size(), waitMs) < 0 && errno != EINTR)
+        {
+            ERR("%s: cannot wait for the sweep points \n", __FUNCTION__);
+            break;
+        }
+        for (IndexType idx = running.size(); idx-- > 0; )
+        {
+            Running &point = running[idx];
+            bool closed = pfds[idx].revents != 0 && point.task->readReady();
+            if (closed || (_timeout > 0 && point.timer.elapsed() >= _timeout))
+            {
+                collect(point);
+                running.erase(running.begin() + idx);
+            }
+        }
+    }
+    // Only after a failed poll: the points still running are waited for one by one
+    for (Running &point : running)
+    {
+        collect(point);
+    }
+    metrics.histogram("abc_py_sweep_seconds", "Wall time of one parameter sweep").observe(timer.elapsed());
+    return rows;
+}
+
+std::vector<IntType> ParamSweep::paretoFront(const std::vector<SweepRow> &rows)
+{
+    auto dominates = [](const SweepRow &a, const SweepRow &b)
+    {
+        bool noWorse = a.numAnd <= b.numAnd && a.lev <= b.lev && a.runtime <= b.runtime;
+        bool better = a.numAnd < b.numAnd || a.lev < b.lev || a.runtime < b.runtime;
+        return noWorse && better;
+    };
+    std::vector<IntType> front;
+    for (IndexType rowIdx = 0; rowIdx < rows.size(); ++rowIdx)
+    {
+        if (!rows[rowIdx].success)
+        {
+            continue;
+        }
+        bool dominated = false;
+        for (IndexType otherIdx = 0; otherIdx < rows.size() && !dominated; ++otherIdx)
+        {
+            dominated = rows[otherIdx].success && dominates(rows[otherIdx], rows[rowIdx]);
+        }
+        if (!dominated)
+        {
+            front.push_back(rowIdx);
+        }
+    }
+    return front;
+}
+
+PROJECT_NAMESPACE_END
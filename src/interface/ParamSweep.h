@@ -0,0 +1,110 @@
+/**
+ * @file ParamSweep.h
+ * @brief Sweep the parameters of the ABC passes on copies of the current network in parallel
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_PARAM_SWEEP_H_
+#define ABC_PY_PARAM_SWEEP_H_
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "global/global.h"
+#include <abc_src/base/main/mainInt.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::SweepRow
+/// @brief The result of one point of a sweep
+struct SweepRow
+{
+    std::string command; ///< The ABC command of the point
+    bool success = false; ///< Whether the command succeeded within the timeout
+    bool timedOut = false; ///< Whether the command was killed at the timeout
+    bool cached = false; ///< Whether the row was served from the cache
+    IntType numAnd = -1; ///< The number of AND nodes after the command
+    IntType lev = -1; ///< The depth after the command
+    RealType runtime = 0; ///< The wall time of the command in seconds
+    std::string network; ///< The network the command left, as checkpoint sections, if the sweep keeps the networks. Empty otherwise
+};
+
+/// @class ABC_PY::ParamSweep
+/// @brief A grid of pass parameters evaluated on the current network. Each point runs in a forked child,
+/// whose copy-on-write copy of the process is the duplicated network, so the network in the frame is never
+/// touched and up to numWorkers points run at once. Rows are cached by the structural key of the network
+/// together with the command, so sweeping the same state again costs nothing
+class ParamSweep
+{
+    public:
+        explicit ParamSweep() = default;
+        /*------------------------------*/ 
+        /* The grid                     */
+        /*------------------------------*/ 
+        /// @brief add the points of resub, one per combination. -1 in K or N for no flag
+        /// @param first: the values of -K
+        /// @param second: the values of -N
+        /// @param third: the values of -l
+        /// @param fourth: the values of -z
+        void addResub(const std::vector<IntType> &ks, const std::vector<IntType> &ns, const std::vector<bool> &ls, const std::vector<bool> &zs);
+        /// @brief add the points of refactor, one per combination. -1 in N for no flag
+        /// @param first: the values of -N
+        /// @param second: the values of -l
+        /// @param third: the values of -z
+        void addRefactor(const std::vector<IntType> &ns, const std::vector<bool> &ls, const std::vector<bool> &zs);
+        /// @brief add the points of rewrite, one per combination
+        /// @param first: the values of -l
+        /// @param second: the values of -z
+        void addRewrite(const std::vector<bool> &ls, const std::vector<bool> &zs);
+        /// @brief add the points of balance
+        /// @param the values of -l
+        void addBalance(const std::vector<bool> &ls);
+        /// @brief add a point of any command or script, e.g. "rw -l; rs -K 8 -l"
+        /// @param the command
+        void addCommand(const std::string &cmd) { _commands.push_back(cmd); }
+        /// @brief drop the points
+        void clearGrid() { _commands.clear(); }
+        /// @brief the command of each point
+        const std::vector<std::string> & commands() const { return _commands; }
+        /*------------------------------*/ 
+        /* Settings                     */
+        /*------------------------------*/ 
+        /// @brief set the largest number of points running at once
+        void setNumWorkers(IntType numWorkers) { _numWorkers = std::max(numWorkers, 1); }
+        /// @brief set the time budget of each point from its own start, after which it is killed and fails. 0 for none
+        void setTimeout(RealType timeoutSec) { _timeout = std::max(timeoutSec, 0.0); }
+        /// @brief set whether each successful row keeps the network its point left, so that the best one can be taken
+        /// without running its command again. The networks are cached with their rows
+        void setKeepNetworks(bool keepNetworks) { _keepNetworks = keepNetworks; }
+        /// @brief whether each successful row keeps the network its point left
+        bool keepNetworks() const { return _keepNetworks; }
+        /*------------------------------*/ 
+        /* Run                          */
+        /*------------------------------*/ 
+        /// @brief evaluate every point of the grid on the current network
+        /// @param first: the ABC framework, with a network loaded
+        /// @param second: encode the network in the frame of a child as checkpoint sections, for keepNetworks(). Empty if it cannot
+        /// @return a row per point, in the order of the grid
+        std::vector<SweepRow> run(Abc_Frame_t_ *pAbc, const std::function<std::string()> &encodeNetwork = nullptr);
+        /// @brief the rows no other row beats in numAnd, lev and runtime at once. Failed rows are never in it
+        /// @param the rows
+        /// @return the indices of the Pareto-optimal rows, ascending
+        static std::vector<IntType> paretoFront(const std::vector<SweepRow> &rows);
+        /// @brief the number of cached rows
+        IntType cacheSize() const { return _cache.size(); }
+        /// @brief drop the cached rows
+        void clearCache() { _cache.clear(); }
+    private:
+        std::vector<std::string> _commands; ///< The command of each point
+        IntType _numWorkers = 4; ///< The largest number of points at once
+        RealType _timeout = 0; ///< The time budget of each point. 0 for none
+        bool _keepNetworks = false; ///< Whether the rows keep the networks of their points
+        std::unordered_map<std::uint64_t, SweepRow> _cache; ///< The successful rows by the key of the network and the command
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_PARAM_SWEEP_H_
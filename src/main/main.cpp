@@ -0,0 +1,460 @@
+/**
+ * @file main.cpp
+ * @brief The command-line driver: optimize a list of designs with a script or a greedy search, one process per design
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unordered_map>
+#include "global/global.h"
+#include "interface/AbcInterface.h"
+#include "interface/ParamSweep.h"
+#include "util/ByteStream.h"
+#include "util/ForkTask.h"
+#include "util/Metrics.h"
+#include "util/thirdparty/cmdline.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::DriverOptions
+/// @brief The options of a run of the driver
+struct DriverOptions
+{
+    std::string mode = "script"; ///< "script" or "search"
+    std::string script; ///< The ABC script of the script mode
+    IntType steps = 10; ///< The most steps of the search mode
+    IntType jobs = 4; ///< The most designs optimized at once
+    IntType sweepJobs = 1; ///< The most points of a search step evaluated at once in each design
+    RealType timeout = 0; ///< The time budget of each action in seconds. 0 for none
+    std::string outDir; ///< Where the optimized designs go
+};
+
+/// @class ABC_PY::DesignResult
+/// @brief The outcome of one design, a row of the report
+struct DesignResult
+{
+    std::string design; ///< The design read
+    std::string output; ///< The optimized design written. Empty if none
+    bool success = false; ///< Whether the design was read, optimized and written
+    IntType numAndBefore = -1; ///< The number of AND nodes read
+    IntType levBefore = -1; ///< The depth read
+    IntType numAndAfter = -1; ///< The number of AND nodes written
+    IntType levAfter = -1; ///< The depth written
+    RealType runtime = 0; ///< The wall time of the design in seconds
+    std::string commands; ///< The commands applied, separated by "; "
+};
+
+/// @brief read the design list: one path per line. Blank lines and lines starting with # are skipped
+/// @param first: the list file
+/// @param second: the designs, appended
+/// @return if the file could be read
+static bool readDesignList(const std::string &filename, std::vector<std::string> &designs)
+{
+    std::ifstream in(filename);
+    if (!in.good())
+    {
+        ERR("%s: cannot open the design list %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string::npos || line[begin] == '#')
+        {
+            continue;
+        }
+        std::size_t end = line.find_last_not_of(" \t\r");
+        designs.push_back(line.substr(begin, end - begin + 1));
+    }
+    return true;
+}
+
+/// @brief the output path of each design: the design name without its directory and extension, in the output
+/// directory, with the index of the design appended when two designs share a name
+static std::vector<std::string> outputPaths(const std::vector<std::string> &designs, const std::string &outDir)
+{
+    std::vector<std::string> stems;
+    std::unordered_map<std::string, IntType> numStems;
+    for (const std::string &design : designs)
+    {
+        std::size_t slash = design.find_last_of('/');
+        std::string stem = slash == std::string::npos ? design : design.substr(slash + 1);
+        std::size_t dot = stem.find_last_of('.');
+        if (dot != std::string::npos && dot > 0)
+        {
+            stem.resize(dot);
+        }
+        ++numStems[stem];
+        stems.push_back(stem);
+    }
+    std::vector<std::string> paths;
+    for (IndexType idx = 0; idx < designs.size(); ++idx)
+    {
+        std::string stem = numStems[stems[idx]] > 1 ? stems[idx] + "_" + std::to_string(idx) : stems[idx];
+        paths.push_back(outDir + "/" + stem + ".aig");
+    }
+    return paths;
+}
+
+/// @brief the greedy search: each step sweeps the passes of the action space on the current network and applies
+/// the one leaving the fewest AND nodes, then the lowest depth, until no pass improves or the steps run out
+/// @param first: the ABC interface with the design read
+/// @param second: the options
+/// @param third: the commands applied, appended
+static void greedySearch(AbcInterface &abc, const DriverOptions &options, std::string &commands)
+{
+    ParamSweep sweep;
+    sweep.addBalance({ false });
+    sweep.addRewrite({ false }, { false, true });
+    sweep.addRefactor({ -1 }, { false }, { false, true });
+    sweep.addResub({ -1 }, { -1 }, { false }, { false, true });
+    sweep.setNumWorkers(options.sweepJobs);
+    sweep.setTimeout(options.timeout);
+    // The best point is taken from its child rather than run again here
+    sweep.setKeepNetworks(true);
+    AigStats stats = abc.aigStats();
+    IntType numAnd = stats.numAnd();
+    IntType lev = stats.lev();
+    for (IntType step = 0; step < options.steps; ++step)
+    {
+        std::vector<SweepRow> rows = abc.sweep(sweep);
+        IntType best = -1;
+        for (IndexType idx = 0; idx < rows.size(); ++idx)
+        {
+            const SweepRow &row = rows[idx];
+            if (!row.success)
+            {
+                continue;
+            }
+            if (best < 0 || row.numAnd < rows[best].numAnd || (row.numAnd == rows[best].numAnd && row.lev < rows[best].lev))
+            {
+                best = idx;
+            }
+        }
+        if (best < 0 || rows[best].numAnd > numAnd || (rows[best].numAnd == numAnd && rows[best].lev >= lev))
+        {
+            break;
+        }
+        if (!abc.takeSweepRow(rows[best]))
+        {
+            break;
+        }
+        // The rows of the states left behind are never hit again, and they hold whole networks
+        sweep.clearCache();
+        numAnd = rows[best].numAnd;
+        lev = rows[best].lev;
+        commands += (commands.empty() ? "" : "; ") + rows[best].command;
+    }
+}
+
+/// @brief optimize a design. Run in the forked child of the design, which starts its own ABC framework
+/// @param first: the design
+/// @param second: the output path
+/// @param third: the options
+/// @return the encoded DesignResult
+static std::string optimizeInChild(const std::string &design, const std::string &output, const DriverOptions &options)
+{
+    MetricsTimer timer;
+    AbcInterface abc;
+    abc.start();
+    abc.setActionTimeout(options.timeout);
+    ByteWriter writer;
+    DesignResult result;
+    if (abc.read(design))
+    {
+        AigStats before = abc.aigStats();
+        result.numAndBefore = before.numAnd();
+        result.levBefore = before.lev();
+        bool optimized = true;
+        if (options.mode == "search")
+        {
+            greedySearch(abc, options, result.commands);
+        }
+        else
+        {
+            optimized = abc.execute(options.script);
+            result.commands = options.script;
+        }
+        AigStats after = abc.aigStats();
+        result.numAndAfter = after.numAnd();
+        result.levAfter = after.lev();
+        if (optimized && abc.write(output))
+        {
+            result.output = output;
+            result.success = true;
+        }
+    }
+    writer.write<std::int32_t>(result.success ? 1 : 0);
+    writer.write<std::int32_t>(result.numAndBefore);
+    writer.write<std::int32_t>(result.levBefore);
+    writer.write<std::int32_t>(result.numAndAfter);
+    writer.write<std::int32_t>(result.levAfter);
+    writer.write<RealType>(timer.elapsed());
+    writer.writeString(result.output);
+    writer.writeString(result.commands);
+    return writer.release();
+}
+
+/// @brief decode the result of optimizeInChild
+/// @return if the payload was complete
+static bool decodeResult(const std::string &payload, DesignResult &result)
+{
+    ByteReader reader(payload);
+    std::int32_t success = 0, numAndBefore = -1, levBefore = -1, numAndAfter = -1, levAfter = -1;
+    reader.read(success);
+    reader.read(numAndBefore);
+    reader.read(levBefore);
+    reader.read(numAndAfter);
+    reader.read(levAfter);
+    reader.read(result.runtime);
+    reader.readString(result.output);
+    reader.readString(result.commands);
+    if (!reader.good())
+    {
+        return false;
+    }
+    result.success = success != 0;
+    result.numAndBefore = numAndBefore;
+    result.levBefore = levBefore;
+    result.numAndAfter = numAndAfter;
+    result.levAfter = levAfter;
+    return true;
+}
+
+/// @brief optimize the designs on a pool of forked children, at most options.jobs at once.
+/// A child that crashes or returns nothing fails its design only
+/// @param first: the designs
+/// @param second: the options
+/// @return a result per design, in the order of the designs
+static std::vector<DesignResult> runPool(const std::vector<std::string> &designs, const DriverOptions &options)
+{
+    std::vector<DesignResult> results(designs.size());
+    std::vector<std::string> outputs = outputPaths(designs, options.outDir);
+    std::vector<ForkTask> tasks(std::max(options.jobs, 1));
+    std::vector<IntType> taskDesign(tasks.size(), -1);
+    IndexType next = 0;
+    IndexType numDone = 0;
+    while (numDone < designs.size())
+    {
+        // Fill the idle slots of the pool
+        for (IndexType slot = 0; slot < tasks.size() && next < designs.size(); ++slot)
+        {
+            if (tasks[slot].running())
+            {
+                continue;
+            }
+            IndexType designIdx = next++;
+            results[designIdx].design = designs[designIdx];
+            const std::string &output = outputs[designIdx];
+            if (!tasks[slot].start([&]() { return optimizeInChild(designs[designIdx], output, options); }))
+            {
+                ++numDone;
+                continue;
+            }
+            taskDesign[slot] = designIdx;
+        }
+        std::vector<struct pollfd> pollFds;
+        std::vector<IndexType> pollSlots;
+        for (IndexType slot = 0; slot < tasks.size(); ++slot)
+        {
+            if (tasks[slot].running())
+            {
+                pollFds.push_back({ tasks[slot].fd(), POLLIN, 0 });
+                pollSlots.push_back(slot);
+            }
+        }
+        if (pollFds.empty())
+        {
+            continue;
+        }
+        if (::poll(pollFds.data(), pollFds.size(), -1) < 0 && errno != EINTR)
+        {
+            ERR("%s: cannot wait for the workers \n", __FUNCTION__);
+            break;
+        }
+        for (IndexType idx = 0; idx < pollFds.size(); ++idx)
+        {
+            if (pollFds[idx].revents == 0)
+            {
+                continue;
+            }
+            // The child writes its result at the very end, so a readable pipe means it is done
+            IndexType slot = pollSlots[idx];
+            DesignResult &result = results[taskDesign[slot]];
+            std::string payload;
+            if (tasks[slot].finish(payload) != ForkStatus::OK || !decodeResult(payload, result))
+            {
+                result.success = false;
+                ERR("%s: the worker of %s failed \n", __FUNCTION__, result.design.c_str());
+            }
+            ++numDone;
+            INF("[%u/%u] %s: %s, and %d -> %d, lev %d -> %d, %.2f s \n", numDone, static_cast<IndexType>(designs.size()), result.design.c_str(),
+                    result.success ? "done" : "FAILED", result.numAndBefore, result.numAndAfter, result.levBefore, result.levAfter, result.runtime);
+            taskDesign[slot] = -1;
+        }
+    }
+    return results;
+}
+
+/// @brief quote a field of the CSV report if it needs to
+static std::string csvField(const std::string &field)
+{
+    if (field.find_first_of(",\"\n") == std::string::npos)
+    {
+        return field;
+    }
+    std::string quoted = "\"";
+    for (char c : field)
+    {
+        quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
+/// @brief escape a string of the JSON report, with its quotes
+static std::string jsonString(const std::string &str)
+{
+    std::string escaped = "\"";
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    escaped += buffer;
+                }
+                else
+                {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped + "\"";
+}
+
+/// @brief write the report, JSON if the file name ends with .json and CSV otherwise
+/// @param first: the file name
+/// @param second: the results
+/// @return if the report was written
+static bool writeReport(const std::string &filename, const std::vector<DesignResult> &results)
+{
+    std::ofstream out(filename);
+    if (!out.good())
+    {
+        ERR("%s: cannot write the report %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    bool json = filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0;
+    if (json)
+    {
+        out << "[\n";
+        for (IndexType idx = 0; idx < results.size(); ++idx)
+        {
+            const DesignResult &result = results[idx];
+            out << "  {\"design\": " << jsonString(result.design)
+                << ", \"success\": " << (result.success ? "true" : "false")
+                << ", \"numAndBefore\": " << result.numAndBefore
+                << ", \"levBefore\": " << result.levBefore
+                << ", \"numAndAfter\": " << result.numAndAfter
+                << ", \"levAfter\": " << result.levAfter
+                << ", \"runtime\": " << result.runtime
+                << ", \"output\": " << jsonString(result.output)
+                << ", \"commands\": " << jsonString(result.commands)
+                << "}" << (idx + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+    else
+    {
+        out << "design,success,numAndBefore,levBefore,numAndAfter,levAfter,runtime,output,commands\n";
+        for (const DesignResult &result : results)
+        {
+            out << csvField(result.design) << "," << (result.success ? 1 : 0)
+                << "," << result.numAndBefore << "," << result.levBefore
+                << "," << result.numAndAfter << "," << result.levAfter
+                << "," << result.runtime
+                << "," << csvField(result.output) << "," << csvField(result.commands) << "\n";
+        }
+    }
+    return out.good();
+}
+
+PROJECT_NAMESPACE_END
+
+int main(int argc, char **argv)
+{
+    using namespace PROJECT_NAMESPACE;
+    cmdline::parser parser;
+    parser.set_program_name("abc_py");
+    parser.add<std::string>("designs", 'd', "the design list, one path per line. Designs may also follow the options", false, "");
+    parser.add<std::string>("mode", 'm', "script: run the script on each design. search: greedy search over the passes", false, "script",
+            cmdline::oneof<std::string>("script", "search"));
+    parser.add<std::string>("script", 's', "the ABC script of the script mode, e.g. \"balance; rewrite; refactor\"", false, "");
+    parser.add<int>("steps", 'n', "the most steps of the search mode", false, 10);
+    parser.add<int>("jobs", 'j', "the most designs optimized at once", false, 4);
+    parser.add<double>("timeout", 't', "the time budget of each action in seconds. 0 for none", false, 0);
+    parser.add<std::string>("outdir", 'o', "the directory of the optimized designs", false, "abc_py_out");
+    parser.add<std::string>("report", 'r', "the report, JSON if it ends with .json and CSV otherwise", false, "report.csv");
+    parser.footer("[design ...]");
+    parser.parse_check(argc, argv);
+
+    std::vector<std::string> designs;
+    if (parser.exist("designs") && !readDesignList(parser.get<std::string>("designs"), designs))
+    {
+        return 1;
+    }
+    designs.insert(designs.end(), parser.rest().begin(), parser.rest().end());
+    if (designs.empty())
+    {
+        ERR("No design given \n");
+        std::cerr << parser.usage();
+        return 1;
+    }
+    DriverOptions options;
+    options.mode = parser.get<std::string>("mode");
+    options.script = parser.get<std::string>("script");
+    options.steps = parser.get<int>("steps");
+    options.jobs = std::max(parser.get<int>("jobs"), 1);
+    options.timeout = std::max(parser.get<double>("timeout"), 0.0);
+    options.outDir = parser.get<std::string>("outdir");
+    // Each design child forks the points of its sweeps in turn, so -j is split between the designs and the points
+    // rather than multiplied: a single design sweeps with all the jobs, as many designs as jobs with one each
+    options.sweepJobs = std::max(options.jobs / std::min<IntType>(options.jobs, designs.size()), 1);
+    if (options.mode == "script" && options.script.empty())
+    {
+        ERR("The script mode needs a script \n");
+        return 1;
+    }
+    if (::mkdir(options.outDir.c_str(), 0755) != 0 && errno != EEXIST)
+    {
+        ERR("Cannot create the output directory %s \n", options.outDir.c_str());
+        return 1;
+    }
+
+    std::vector<DesignResult> results = runPool(designs, options);
+    if (!writeReport(parser.get<std::string>("report"), results))
+    {
+        return 1;
+    }
+    IntType numFailed = 0;
+    for (const DesignResult &result : results)
+    {
+        numFailed += result.success ? 0 : 1;
+    }
+    INF("%d designs optimized, %d failed. Report written to %s \n", static_cast<IntType>(results.size()) - numFailed, numFailed,
+            parser.get<std::string>("report").c_str());
+    return numFailed == 0 ? 0 : 2;
+}
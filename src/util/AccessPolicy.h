@@ -0,0 +1,60 @@
+/**
+ * @file AccessPolicy.h
+ * @brief Index checking policies for the hot accessors of the mirrored graph
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_ACCESS_POLICY_H_
+#define ABC_PY_ACCESS_POLICY_H_
+
+#include <stdexcept>
+#include "global/namespace.h"
+#include "MsgPrinter.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::CheckedAccess
+/// @brief Check the index range. Throws std::out_of_range (IndexError in Python) when violated
+struct CheckedAccess
+{
+    static constexpr bool checked = true;
+    /// @brief check whether 0 <= idx < size
+    /// @param first: the index
+    /// @param second: the size of the container
+    /// @param third: the name of the accessed entity, for the message
+    template<typename IdxType, typename SizeType>
+    static void checkRange(IdxType idx, SizeType size, const char *what)
+    {
+        if (idx < 0 || static_cast<long long>(idx) >= static_cast<long long>(size))
+        {
+            outOfRange(static_cast<long long>(idx), static_cast<long long>(size), what);
+        }
+    }
+    private:
+        static void outOfRange(long long idx, long long size, const char *what)
+        {
+            MsgPrinter::log<MsgType::ERR>("Access %s out of range %lld / %lld \n", what, idx, size);
+            throw std::out_of_range(std::string(what) + " index out of range");
+        }
+};
+
+/// @class ABC_PY::UncheckedAccess
+/// @brief Skip the range check entirely
+struct UncheckedAccess
+{
+    static constexpr bool checked = false;
+    template<typename IdxType, typename SizeType>
+    static void checkRange(IdxType, SizeType, const char *) {}
+};
+
+/// The policy used by the graph mirror accessors. Selected at build time with ABC_PY_CHECKED_ACCESS
+#if ABC_PY_CHECKED_ACCESS
+using MirrorAccess = CheckedAccess;
+#else
+using MirrorAccess = UncheckedAccess;
+#endif
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_ACCESS_POLICY_H_
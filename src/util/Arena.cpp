@@ -0,0 +1,57 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+PROJECT_NAMESPACE_BEGIN
+
+Arena::~Arena()
+{
+    this->release();
+}
+
+void Arena::release()
+{
+    for (Chunk &chunk : _chunks)
+    {
+        std::free(chunk.data);
+    }
+    _chunks.clear();
+    _bytesReserved = 0;
+    this->reset();
+}
+
+void * Arena::allocateSlow(std::size_t bytes, std::size_t align)
+{
+    // A chunk starts aligned to max_align_t, so a stricter alignment may need the padding on top
+    std::size_t needed = bytes + (align > alignof(std::max_align_t) ? align : 0);
+    // The chunks after the current one are empty since the last reset. Skip those too small
+    std::size_t chunkIdx = _chunks.empty() ? 0 : _chunkIdx + 1;
+    while (chunkIdx < _chunks.size() && _chunks[chunkIdx].size < needed)
+    {
+        ++chunkIdx;
+    }
+    if (chunkIdx == _chunks.size())
+    {
+        Chunk chunk;
+        chunk.size = std::max(_chunkBytes, needed);
+        chunk.data = static_cast<char *>(std::malloc(chunk.size));
+        if (chunk.data == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        _bytesReserved += chunk.size;
+        _chunks.push_back(chunk);
+    }
+    if (chunkIdx > _chunkIdx + 1)
+    {
+        // Bring the chunk that fits next in line, so the ones skipped stay available after it
+        std::swap(_chunks[_chunkIdx + 1], _chunks[chunkIdx]);
+        chunkIdx = _chunkIdx + 1;
+    }
+    _chunkIdx = chunkIdx;
+    _offset = 0;
+    return this->allocate(bytes, align);
+}
+
+PROJECT_NAMESPACE_END
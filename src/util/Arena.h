@@ -0,0 +1,121 @@
+/**
+ * @file Arena.h
+ * @brief A bump-pointer arena whose memory is released all at once, and an STL allocator drawing from it
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_ARENA_H_
+#define ABC_PY_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::Arena
+/// @brief Hand out memory from large chunks by bumping an offset. Nothing is freed on its own: reset() rewinds
+/// to the first chunk in O(1) and keeps all the chunks, so after the first few rounds a round of allocations
+/// touches the heap not at all. Meant for data rebuilt wholesale, such as the graph mirror of one environment.
+/// Not thread-safe; each environment owns its arena
+class Arena
+{
+    public:
+        /// @brief constructor
+        /// @param the size of a chunk. Larger requests get a chunk of their own size
+        explicit Arena(std::size_t chunkBytes = 1 << 20) : _chunkBytes(chunkBytes > 0 ? chunkBytes : 1) {}
+        ~Arena();
+        Arena(const Arena &) = delete;
+        Arena & operator=(const Arena &) = delete;
+        /// @brief allocate uninitialized memory
+        /// @param first: the bytes
+        /// @param second: the alignment, a power of two
+        /// @return the memory, valid until the next reset()
+        void * allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t))
+        {
+            if (_chunkIdx < _chunks.size())
+            {
+                // Align the address rather than the offset: a chunk is only aligned to max_align_t
+                char *data = _chunks[_chunkIdx].data;
+                std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(data + _offset) + align - 1) & ~(align - 1);
+                std::size_t offset = address - reinterpret_cast<std::uintptr_t>(data);
+                if (offset + bytes <= _chunks[_chunkIdx].size)
+                {
+                    _offset = offset + bytes;
+                    _bytesUsed += bytes;
+                    return _chunks[_chunkIdx].data + offset;
+                }
+            }
+            return this->allocateSlow(bytes, align);
+        }
+        /// @brief allocate an uninitialized array of plain values
+        /// @param the number of elements
+        /// @return the array, valid until the next reset()
+        template<typename T>
+        T * allocateArray(std::size_t count)
+        {
+            return static_cast<T *>(this->allocate(count * sizeof(T), alignof(T)));
+        }
+        /// @brief release everything allocated. The chunks are kept for the next round
+        void reset()
+        {
+            _chunkIdx = 0;
+            _offset = 0;
+            _bytesUsed = 0;
+        }
+        /// @brief free the chunks as well
+        void release();
+        /// @brief the bytes handed out since the last reset()
+        std::uint64_t bytesUsed() const { return _bytesUsed; }
+        /// @brief the bytes of the chunks held
+        std::uint64_t bytesReserved() const { return _bytesReserved; }
+    private:
+        /// @brief move to the next chunk that fits, adding one if none does
+        void * allocateSlow(std::size_t bytes, std::size_t align);
+    private:
+        /// @class ABC_PY::Arena::Chunk
+        /// @brief A block of memory from the heap
+        struct Chunk
+        {
+            char *data = nullptr; ///< The memory, aligned to max_align_t
+            std::size_t size = 0; ///< The bytes
+        };
+        std::size_t _chunkBytes; ///< The size of a regular chunk
+        std::vector<Chunk> _chunks; ///< The chunks, in the order they are filled
+        std::size_t _chunkIdx = 0; ///< The chunk being filled
+        std::size_t _offset = 0; ///< The bytes taken from the chunk being filled
+        std::uint64_t _bytesUsed = 0; ///< The bytes handed out
+        std::uint64_t _bytesReserved = 0; ///< The bytes of the chunks
+};
+
+/// @class ABC_PY::ArenaAllocator
+/// @brief An STL allocator on an Arena. deallocate() does nothing: the memory comes back when the arena is reset,
+/// so a container using it must not outlive the reset. Reserve the size up front, as a grown buffer leaves the old one behind
+template<typename T>
+class ArenaAllocator
+{
+    public:
+        typedef T value_type;
+        explicit ArenaAllocator(Arena &arena) : _arena(&arena) {}
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) : _arena(other.arena()) {}
+        T * allocate(std::size_t count) { return _arena->allocateArray<T>(count); }
+        void deallocate(T *, std::size_t) {}
+        Arena * arena() const { return _arena; }
+        template<typename U>
+        bool operator==(const ArenaAllocator<U> &other) const { return _arena == other.arena(); }
+        template<typename U>
+        bool operator!=(const ArenaAllocator<U> &other) const { return _arena != other.arena(); }
+    private:
+        Arena *_arena; ///< The arena drawn from
+};
+
+/// A vector whose buffer lives in an Arena
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_ARENA_H_
@@ -2,12 +2,15 @@
 #define ZKUTIL_ASSERT_H_
 
 
-#ifndef NDEBUG
+#include "global/define.h"
+
+// Checked unless ABC_PY_ASSERT is 0, see global/define.h. The message is only formatted on a failure
+#if ABC_PY_ASSERT
 
 #include <string>
 #include <cstdio>
+#include <cstdlib>
 #include "MsgPrinter.h"
-#include <cassert>
 
 
 // Assert without message
@@ -17,8 +20,8 @@
             { \
                 char format[1024]; \
                 sprintf(format, "Assertion failed at file %s line %d. \n                                    assert: %s\n", __FILE__, __LINE__, #cond); \
-                MsgPrinter::err(format); \
-                assert(0); \
+                PROJECT_NAMESPACE::MsgPrinter::err(format); \
+                std::abort(); \
                 } \
             } while(false)
 
@@ -30,16 +33,16 @@
                 char prefix[1024]; \
                 sprintf(prefix, "Assertion failed at file %s line %d.\n                                          assert: %s\n", __FILE__, __LINE__, #cond); \
                 std::string format = std::string(prefix) + "                                          message: " + std::string(msg); \
-                MsgPrinter::err(format.c_str(), ##__VA_ARGS__); \
-                assert(0); \
+                PROJECT_NAMESPACE::MsgPrinter::err(format.c_str(), ##__VA_ARGS__); \
+                std::abort(); \
             } \
         } while (false)
-#else // NDEBUG
+#else // ABC_PY_ASSERT
 #define Assert(cond) \
         do { \
         } while(false)
 #define AssertMsg(cond, msg, ...) \
         do { \
         } while (false)
-#endif // NDEBUG
+#endif // ABC_PY_ASSERT
 #endif // ZKTUIL_ASSERT_H_
@@ -0,0 +1,101 @@
+/**
+ * @file BoundedQueue.h
+ * @brief A blocking queue of bounded capacity, connecting the stages of a pipeline with backpressure
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_BOUNDED_QUEUE_H_
+#define ABC_PY_BOUNDED_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::BoundedQueue
+/// @brief Multi-producer multi-consumer FIFO. push() blocks while the queue is full, so a slow consumer
+/// throttles its producers. After close(), pushes fail and pops drain what is left
+template<typename T>
+class BoundedQueue
+{
+    public:
+        /// @brief constructor
+        /// @param the capacity. At least 1
+        explicit BoundedQueue(IndexType capacity = 64) : _capacity(capacity > 0 ? capacity : 1) {}
+        /// @brief add an item, waiting while the queue is full
+        /// @return false if the queue is closed
+        bool push(T item)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notFull.wait(lock, [this]() { return _closed || _items.size() < _capacity; });
+            if (_closed)
+            {
+                return false;
+            }
+            _items.push_back(std::move(item));
+            _notEmpty.notify_one();
+            return true;
+        }
+        /// @brief take an item, waiting while the queue is empty
+        /// @return false if the queue is closed and empty
+        bool pop(T &item)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _notEmpty.wait(lock, [this]() { return _closed || !_items.empty(); });
+            return this->take(item);
+        }
+        /// @brief take an item if there is one, without waiting
+        /// @return if an item was taken
+        bool tryPop(T &item)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return this->take(item);
+        }
+        /// @brief stop accepting items and wake all the waiting threads
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _closed = true;
+            _notEmpty.notify_all();
+            _notFull.notify_all();
+        }
+        /// @brief whether the queue is closed and empty
+        bool done()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _closed && _items.empty();
+        }
+        /// @brief the number of items queued
+        IndexType size()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _items.size();
+        }
+    private:
+        /// @brief take the front item. The caller holds the mutex
+        bool take(T &item)
+        {
+            if (_items.empty())
+            {
+                return false;
+            }
+            item = std::move(_items.front());
+            _items.pop_front();
+            _notFull.notify_one();
+            return true;
+        }
+    private:
+        IndexType _capacity; ///< The capacity
+        std::deque<T> _items; ///< The items
+        bool _closed = false; ///< Whether the queue is closed
+        std::mutex _mutex; ///< Guards the items
+        std::condition_variable _notEmpty; ///< Signalled when an item is added or the queue closed
+        std::condition_variable _notFull; ///< Signalled when an item is taken or the queue closed
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_BOUNDED_QUEUE_H_
@@ -0,0 +1,166 @@
+/**
+ * @file ByteStream.h
+ * @brief Append plain values to a byte string and read them back
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_BYTE_STREAM_H_
+#define ABC_PY_BYTE_STREAM_H_
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class ABC_PY::ByteWriter
+/// @brief Append trivially copyable values, vectors of them and strings to a byte string, in the host byte order
+class ByteWriter
+{
+    public:
+        explicit ByteWriter() = default;
+        /// @brief append one value
+        template<typename T>
+        void write(const T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+            _data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+        /// @brief append raw bytes
+        void writeBytes(const void *data, std::size_t size) { _data.append(static_cast<const char *>(data), size); }
+        /// @brief append the size and the elements of a vector
+        template<typename T, typename Alloc>
+        void writeVector(const std::vector<T, Alloc> &values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+            this->write<std::uint64_t>(values.size());
+            this->writeBytes(values.data(), values.size() * sizeof(T));
+        }
+        /// @brief append the size and the characters of a string
+        void writeString(const std::string &str)
+        {
+            this->write<std::uint64_t>(str.size());
+            _data.append(str);
+        }
+        /// @brief append an unsigned LEB128 varint: 7 bits per byte, low bits first
+        void writeVarint(std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                _data.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            _data.push_back(static_cast<char>(value));
+        }
+        /// @brief append a signed varint, zigzag encoded so small magnitudes take one byte
+        void writeSignedVarint(std::int64_t value)
+        {
+            this->writeVarint((static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+        }
+        /// @brief get the bytes written
+        const std::string & data() const { return _data; }
+        /// @brief take the bytes written, leaving the writer empty
+        std::string release() { std::string data; data.swap(_data); return data; }
+    private:
+        std::string _data; ///< The bytes
+};
+
+/// @class ABC_PY::ByteReader
+/// @brief Read back what ByteWriter wrote. A read past the end fails and leaves the reader not good
+class ByteReader
+{
+    public:
+        explicit ByteReader(const char *data, std::size_t size) : _data(data), _size(size) {}
+        explicit ByteReader(const std::string &data) : _data(data.data()), _size(data.size()) {}
+        /// @brief read one value
+        /// @return if successful
+        template<typename T>
+        bool read(T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+            return this->readBytes(&value, sizeof(T));
+        }
+        /// @brief read raw bytes
+        /// @return if successful
+        bool readBytes(void *data, std::size_t size)
+        {
+            if (!_good || _size - _pos < size)
+            {
+                _good = false;
+                return false;
+            }
+            std::memcpy(data, _data + _pos, size);
+            _pos += size;
+            return true;
+        }
+        /// @brief read a vector written by writeVector
+        /// @return if successful
+        template<typename T>
+        bool readVector(std::vector<T> &values)
+        {
+            std::uint64_t size = 0;
+            if (!this->read(size) || size > (_size - _pos) / sizeof(T))
+            {
+                _good = false;
+                return false;
+            }
+            values.resize(size);
+            return this->readBytes(values.data(), size * sizeof(T));
+        }
+        /// @brief read a string written by writeString
+        /// @return if successful
+        bool readString(std::string &str)
+        {
+            std::uint64_t size = 0;
+            if (!this->read(size) || size > _size - _pos)
+            {
+                _good = false;
+                return false;
+            }
+            str.assign(_data + _pos, size);
+            _pos += size;
+            return true;
+        }
+        /// @brief read a varint written by writeVarint
+        /// @return if successful
+        bool readVarint(std::uint64_t &value)
+        {
+            value = 0;
+            for (IntType shift = 0; shift < 64 && _good && _pos < _size; shift += 7)
+            {
+                std::uint8_t byte = static_cast<std::uint8_t>(_data[_pos++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            _good = false;
+            return false;
+        }
+        /// @brief read a varint written by writeSignedVarint
+        /// @return if successful
+        bool readSignedVarint(std::int64_t &value)
+        {
+            std::uint64_t zigzag = 0;
+            bool ok = this->readVarint(zigzag);
+            value = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+            return ok;
+        }
+        /// @brief whether all the reads so far succeeded
+        bool good() const { return _good; }
+        /// @brief the number of bytes not read yet
+        std::size_t remaining() const { return _size - _pos; }
+    private:
+        const char *_data = nullptr; ///< The bytes
+        std::size_t _size = 0; ///< The number of bytes
+        std::size_t _pos = 0; ///< The read position
+        bool _good = true; ///< Whether all the reads succeeded
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_BYTE_STREAM_H_
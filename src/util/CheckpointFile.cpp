@@ -0,0 +1,172 @@
+#include "CheckpointFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MsgPrinter.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief round up to the section alignment
+static std::size_t alignUp(std::size_t offset)
+{
+    return (offset + CHECKPOINT_ALIGN - 1) / CHECKPOINT_ALIGN * CHECKPOINT_ALIGN;
+}
+
+/// The bytes of the header before the section table
+constexpr std::size_t CHECKPOINT_HEADER_SIZE = sizeof(CHECKPOINT_MAGIC) + 2 * sizeof(std::uint32_t);
+/// The bytes of one entry of the section table
+constexpr std::size_t CHECKPOINT_ENTRY_SIZE = 2 * sizeof(std::uint32_t) + 2 * sizeof(std::uint64_t);
+
+std::string CheckpointWriter::finish() const
+{
+    std::uint32_t numSections = _sections.size();
+    std::string bytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    bytes.append(reinterpret_cast<const char *>(&CHECKPOINT_VERSION), sizeof(CHECKPOINT_VERSION));
+    bytes.append(reinterpret_cast<const char *>(&numSections), sizeof(numSections));
+    std::size_t offset = alignUp(CHECKPOINT_HEADER_SIZE + numSections * CHECKPOINT_ENTRY_SIZE);
+    for (const auto &section : _sections)
+    {
+        std::uint32_t reserved = 0;
+        std::uint64_t sectionOffset = offset, sectionSize = section.second.size();
+        bytes.append(reinterpret_cast<const char *>(&section.first), sizeof(section.first));
+        bytes.append(reinterpret_cast<const char *>(&reserved), sizeof(reserved));
+        bytes.append(reinterpret_cast<const char *>(&sectionOffset), sizeof(sectionOffset));
+        bytes.append(reinterpret_cast<const char *>(&sectionSize), sizeof(sectionSize));
+        offset = alignUp(offset + section.second.size());
+    }
+    for (const auto &section : _sections)
+    {
+        bytes.resize(alignUp(bytes.size()), '\0');
+        bytes.append(section.second);
+    }
+    return bytes;
+}
+
+bool CheckpointWriter::writeFile(const std::string &filename) const
+{
+    std::string bytes = this->finish();
+    std::string tmpPath = filename + ".tmp";
+    FILE *fp = fopen(tmpPath.c_str(), "wb");
+    if (fp == nullptr)
+    {
+        MsgPrinter::err("Cannot open checkpoint file %s \n", tmpPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), fp) == bytes.size();
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || std::rename(tmpPath.c_str(), filename.c_str()) != 0)
+    {
+        MsgPrinter::err("Cannot write checkpoint file %s \n", filename.c_str());
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointReader::open(const char *data, std::size_t size)
+{
+    _data = nullptr;
+    _entries.clear();
+    if (size < CHECKPOINT_HEADER_SIZE || std::memcmp(data, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0)
+    {
+        MsgPrinter::err("Not an abc_py checkpoint \n");
+        return false;
+    }
+    std::uint32_t numSections = 0;
+    std::memcpy(&_version, data + sizeof(CHECKPOINT_MAGIC), sizeof(_version));
+    std::memcpy(&numSections, data + sizeof(CHECKPOINT_MAGIC) + sizeof(_version), sizeof(numSections));
+    if (_version == 0 || _version > CHECKPOINT_VERSION)
+    {
+        MsgPrinter::err("Unsupported checkpoint version %u \n", _version);
+        return false;
+    }
+    if (numSections > (size - CHECKPOINT_HEADER_SIZE) / CHECKPOINT_ENTRY_SIZE)
+    {
+        MsgPrinter::err("Truncated checkpoint \n");
+        return false;
+    }
+    static_assert(sizeof(Entry) == CHECKPOINT_ENTRY_SIZE, "the section table entry must not be padded");
+    _entries.resize(numSections);
+    for (std::uint32_t idx = 0; idx < numSections; ++idx)
+    {
+        const char *entry = data + CHECKPOINT_HEADER_SIZE + idx * CHECKPOINT_ENTRY_SIZE;
+        std::memcpy(&_entries[idx], entry, CHECKPOINT_ENTRY_SIZE);
+        if (_entries[idx].offset > size || _entries[idx].size > size - _entries[idx].offset)
+        {
+            MsgPrinter::err("Truncated checkpoint \n");
+            _entries.clear();
+            return false;
+        }
+    }
+    _data = data;
+    return true;
+}
+
+bool CheckpointReader::has(std::uint32_t id) const
+{
+    for (const auto &entry : _entries)
+    {
+        if (entry.id == id)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CheckpointReader::section(std::uint32_t id, const char *&data, std::size_t &size) const
+{
+    for (const auto &entry : _entries)
+    {
+        if (entry.id == id)
+        {
+            data = _data + entry.offset;
+            size = entry.size;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MappedFile::open(const std::string &filename)
+{
+    this->close();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        MsgPrinter::err("Cannot open file %s \n", filename.c_str());
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        MsgPrinter::err("Cannot map empty or unreadable file %s \n", filename.c_str());
+        ::close(fd);
+        return false;
+    }
+    void *addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED)
+    {
+        MsgPrinter::err("Cannot map file %s \n", filename.c_str());
+        return false;
+    }
+    _data = static_cast<const char *>(addr);
+    _size = st.st_size;
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data != nullptr)
+    {
+        ::munmap(const_cast<char *>(_data), _size);
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+PROJECT_NAMESPACE_END
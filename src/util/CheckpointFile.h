@@ -0,0 +1,136 @@
+/**
+ * @file CheckpointFile.h
+ * @brief A versioned container of binary sections that can be read in place from a memory-mapped file
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_CHECKPOINT_FILE_H_
+#define ABC_PY_CHECKPOINT_FILE_H_
+
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// The magic bytes at the start of a checkpoint
+constexpr char CHECKPOINT_MAGIC[8] = { 'A', 'B', 'C', 'P', 'Y', 'C', 'K', 'P' };
+/// The version written. Readers reject newer versions
+constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+/// The alignment of every section from the start of the file
+constexpr std::size_t CHECKPOINT_ALIGN = 8;
+
+/// @class ABC_PY::CheckpointWriter
+/// @brief Collect sections and lay them out as a checkpoint.
+/// The layout is the header {magic[8], uint32 version, uint32 numSections}, the table of
+/// {uint32 id, uint32 reserved, uint64 offset, uint64 size} per section, then the sections, each aligned to 8 bytes.
+/// Values are in the host byte order, so arrays of plain structs can be used straight from the mapping.
+class CheckpointWriter
+{
+    public:
+        explicit CheckpointWriter() = default;
+        /// @brief add a section of raw bytes
+        /// @param first: the section id. Unique within the checkpoint
+        /// @param second: the bytes
+        void addSection(std::uint32_t id, std::string bytes) { _sections.emplace_back(id, std::move(bytes)); }
+        /// @brief add a section holding an array of plain values
+        template<typename T>
+        void addArray(std::uint32_t id, const std::vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be written");
+            this->addSection(id, std::string(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T)));
+        }
+        /// @brief lay out the checkpoint
+        /// @return the bytes of the checkpoint
+        std::string finish() const;
+        /// @brief lay out the checkpoint and write it to a file. The file is replaced atomically
+        /// @param the file name
+        /// @return if successful
+        bool writeFile(const std::string &filename) const;
+    private:
+        std::vector<std::pair<std::uint32_t, std::string>> _sections; ///< The sections by id
+};
+
+/// @class ABC_PY::CheckpointReader
+/// @brief Locate the sections of a checkpoint in memory without copying them
+class CheckpointReader
+{
+    public:
+        explicit CheckpointReader() = default;
+        /// @brief check the header and the section table. The memory must outlive the reader
+        /// @param first: the start of the checkpoint, aligned to 8 bytes
+        /// @param second: the number of bytes
+        /// @return if the checkpoint is valid and of a supported version
+        bool open(const char *data, std::size_t size);
+        /// @brief the version of the checkpoint
+        std::uint32_t version() const { return _version; }
+        /// @brief whether the checkpoint has a section
+        bool has(std::uint32_t id) const;
+        /// @brief get a section
+        /// @param first: the section id
+        /// @param second: the start of the section
+        /// @param third: the number of bytes
+        /// @return if the section exists
+        bool section(std::uint32_t id, const char *&data, std::size_t &size) const;
+        /// @brief view a section as an array of plain values, in place
+        /// @param first: the section id
+        /// @param second: the number of values
+        /// @return the first value. nullptr if the section is missing or its size is not a multiple of the value size
+        template<typename T>
+        const T * array(std::uint32_t id, std::size_t &count) const
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "only plain values can be read");
+            const char *data = nullptr;
+            std::size_t size = 0;
+            count = 0;
+            if (!this->section(id, data, size) || size % sizeof(T) != 0)
+            {
+                return nullptr;
+            }
+            count = size / sizeof(T);
+            return reinterpret_cast<const T *>(data);
+        }
+    private:
+        /// @class ABC_PY::CheckpointReader::Entry
+        /// @brief An entry of the section table
+        struct Entry
+        {
+            std::uint32_t id; ///< The section id
+            std::uint32_t reserved; ///< Zero
+            std::uint64_t offset; ///< The offset from the start of the checkpoint
+            std::uint64_t size; ///< The number of bytes
+        };
+        const char *_data = nullptr; ///< The checkpoint
+        std::uint32_t _version = 0; ///< The version
+        std::vector<Entry> _entries; ///< The section table
+};
+
+/// @class ABC_PY::MappedFile
+/// @brief A read-only memory mapping of a whole file
+class MappedFile
+{
+    public:
+        explicit MappedFile() = default;
+        ~MappedFile() { this->close(); }
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+        /// @brief map a file
+        /// @param the file name
+        /// @return if successful
+        bool open(const std::string &filename);
+        /// @brief unmap the file
+        void close();
+        /// @brief the start of the mapping. Page aligned
+        const char * data() const { return _data; }
+        /// @brief the number of bytes
+        std::size_t size() const { return _size; }
+    private:
+        const char *_data = nullptr; ///< The mapping
+        std::size_t _size = 0; ///< The file size
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_CHECKPOINT_FILE_H_
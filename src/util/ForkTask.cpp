@@ -0,0 +1,171 @@
+#include "ForkTask.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "MsgPrinter.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief write all the bytes, retrying on interrupts and short writes
+static bool writeAll(int fd, const char *data, std::size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+ForkTask::~ForkTask()
+{
+    this->kill();
+}
+
+bool ForkTask::start(const std::function<std::string()> &fn)
+{
+    this->kill();
+    int fds[2];
+    if (::pipe(fds) != 0)
+    {
+        MsgPrinter::err("Cannot create the pipe of a forked task \n");
+        return false;
+    }
+    // Empty the stdio buffers first, or the child would print what the parent has pending again when it flushes
+    std::fflush(stdout);
+    std::fflush(stderr);
+    pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        MsgPrinter::err("Cannot fork a task \n");
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return false;
+    }
+    if (pid == 0)
+    {
+        // Child. Leave through _exit so the parent's atexit handlers are not run twice
+        ::close(fds[0]);
+        int code = 0;
+        try
+        {
+            std::string result = fn();
+            code = writeAll(fds[1], result.data(), result.size()) ? 0 : 2;
+        }
+        catch (...)
+        {
+            code = 1;
+        }
+        ::close(fds[1]);
+        // _exit skips the stdio buffers, which would lose what the child printed, e.g. the ABC messages
+        std::fflush(stdout);
+        std::fflush(stderr);
+        ::_exit(code);
+    }
+    ::close(fds[1]);
+    _pid = pid;
+    _fd = fds[0];
+    _buffer.clear();
+    _closed = false;
+    return true;
+}
+
+ForkStatus ForkTask::finish(std::string &result, RealType timeoutSec)
+{
+    result.clear();
+    if (!this->running())
+    {
+        return ForkStatus::FAILED;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<RealType>(timeoutSec < 0 ? 0 : timeoutSec));
+    while (!_closed)
+    {
+        int waitMs = -1;
+        if (timeoutSec >= 0)
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+            waitMs = static_cast<int>(std::max<decltype(left)>(left, 0));
+        }
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int ready = ::poll(&pfd, 1, waitMs);
+        if (ready < 0 && errno != EINTR)
+        {
+            this->kill();
+            return ForkStatus::FAILED;
+        }
+        if (ready > 0)
+        {
+            this->readReady();
+        }
+        else if (ready == 0 && waitMs == 0)
+        {
+            // Nothing left to read at the deadline
+            this->kill();
+            return ForkStatus::TIMEOUT;
+        }
+    }
+    result.swap(_buffer);
+    return this->reap() ? ForkStatus::OK : ForkStatus::FAILED;
+}
+
+bool ForkTask::readReady()
+{
+    if (!this->running() || _closed)
+    {
+        return true;
+    }
+    char buffer[4096];
+    ssize_t n = ::read(_fd, buffer, sizeof(buffer));
+    if (n > 0)
+    {
+        _buffer.append(buffer, n);
+    }
+    else if (n == 0 || errno != EINTR)
+    {
+        // End of the pipe: the child has finished
+        _closed = true;
+    }
+    return _closed;
+}
+
+void ForkTask::kill()
+{
+    if (!this->running())
+    {
+        return;
+    }
+    ::kill(_pid, SIGKILL);
+    this->reap();
+}
+
+bool ForkTask::reap()
+{
+    int status = 0;
+    while (::waitpid(_pid, &status, 0) < 0 && errno == EINTR) {}
+    ::close(_fd);
+    _pid = -1;
+    _fd = -1;
+    _buffer.clear();
+    _closed = false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,74 @@
+/**
+ * @file ForkTask.h
+ * @brief Run a function in a forked child process and collect its result
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_FORK_TASK_H_
+#define ABC_PY_FORK_TASK_H_
+
+#include <functional>
+#include <string>
+#include <sys/types.h>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The outcome of a forked task
+enum class ForkStatus
+{
+    OK, ///< The child finished and returned its result
+    FAILED, ///< The child could not be started, crashed or returned a failure
+    TIMEOUT ///< The child was killed at the deadline
+};
+
+/// @class ABC_PY::ForkTask
+/// @brief Run a function in a forked child and send the bytes it returns back through a pipe.
+/// The child works on a copy-on-write snapshot of the whole process taken at start(), so it can run
+/// ABC commands on the current network while the parent carries on. The ABC framework is global and not
+/// thread-safe, so this is how work on a network is moved off the calling thread.
+/// The child must not touch locks other threads may hold, such as the Python interpreter. The metrics registry is
+/// safe, as its lock is held across the fork.
+class ForkTask
+{
+    public:
+        explicit ForkTask() = default;
+        /// @brief kill and reap the child if it is still running
+        ~ForkTask();
+        ForkTask(const ForkTask &) = delete;
+        ForkTask & operator=(const ForkTask &) = delete;
+        /// @brief fork and run the function in the child. An exception in the child is a failure
+        /// @param the function run in the child. Its return value is the result
+        /// @return if the child was started
+        bool start(const std::function<std::string()> &fn);
+        /// @brief wait for the child and collect its result. What the child has written is read before the deadline
+        /// is enforced, so a child that finished just in time is not reported as timed out
+        /// @param first: the result
+        /// @param second: the timeout in seconds. Negative to wait forever, 0 to collect a child already done
+        /// @return the status
+        ForkStatus finish(std::string &result, RealType timeoutSec = -1);
+        /// @brief read what the child has written so far. Call it once poll() reports fd() ready, so it does not block
+        /// @return whether the child has closed the pipe, so that finish() returns without waiting
+        bool readReady();
+        /// @brief kill and reap the child
+        void kill();
+        /// @brief whether a child has been started and not collected
+        bool running() const { return _pid > 0; }
+        /// @brief the read end of the result pipe, to wait on several children with poll() and readReady(). It becomes
+        /// readable once the child writes its result or exits. -1 if not running
+        int fd() const { return _fd; }
+    private:
+        /// @brief reap the child and close the pipe
+        /// @return if the child exited normally with status 0
+        bool reap();
+    private:
+        pid_t _pid = -1; ///< The child process
+        int _fd = -1; ///< The read end of the result pipe
+        std::string _buffer; ///< The bytes read from the pipe so far
+        bool _closed = false; ///< Whether the child has closed the pipe
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_FORK_TASK_H_
@@ -0,0 +1,33 @@
+#include "GroupVarint.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace
+{
+    /// @brief build the shuffle of each tag. The bytes of value i go to lane i, the rest of the lane is zeroed
+    struct ShuffleTableBuilder
+    {
+        std::uint8_t table[256][16];
+        ShuffleTableBuilder()
+        {
+            for (IntType tag = 0; tag < 256; ++tag)
+            {
+                IntType offset = 0;
+                for (IntType idx = 0; idx < 4; ++idx)
+                {
+                    IntType numBytes = ((tag >> (2 * idx)) & 3) + 1;
+                    for (IntType byte = 0; byte < 4; ++byte)
+                    {
+                        table[tag][4 * idx + byte] = byte < numBytes ? static_cast<std::uint8_t>(offset + byte) : 0x80;
+                    }
+                    offset += numBytes;
+                }
+            }
+        }
+    };
+    const ShuffleTableBuilder shuffleTableBuilder;
+}
+
+const std::uint8_t (&GroupVarint::shuffleTable)[256][16] = shuffleTableBuilder.table;
+
+PROJECT_NAMESPACE_END
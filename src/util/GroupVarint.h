@@ -0,0 +1,109 @@
+/**
+ * @file GroupVarint.h
+ * @brief Group varint coding of 32-bit integers, with an SSSE3 decoder
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_GROUP_VARINT_H_
+#define ABC_PY_GROUP_VARINT_H_
+
+#include <cstddef>
+#include <cstring>
+#include "global/type.h"
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief Group varint: the values go in groups of four, each group a tag byte followed by the values in
+/// 1 to 4 little-endian bytes. The tag holds the byte count minus one of each value, two bits apiece, the first
+/// value in the low bits. The last group may be short; the count of values is kept by the caller.
+/// A full group decodes with one shuffle when 16 bytes can be read past its tag
+namespace GroupVarint
+{
+    /// The shuffle of each tag, moving the bytes of the four values to their 32-bit lanes
+    extern const std::uint8_t (&shuffleTable)[256][16];
+
+    /// @brief the bytes of a value, 1 to 4
+    inline IntType valueBytes(std::uint32_t value)
+    {
+        return value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : value < (1u << 24) ? 3 : 4;
+    }
+    /// @brief the bytes of a full group by its tag
+    inline IntType groupBytes(std::uint8_t tag)
+    {
+        return 5 + (tag & 3) + ((tag >> 2) & 3) + ((tag >> 4) & 3) + (tag >> 6);
+    }
+    /// @brief the bytes of the coded values
+    inline std::size_t encodedBytes(const std::uint32_t *values, std::size_t count)
+    {
+        std::size_t bytes = (count + 3) / 4;
+        for (std::size_t idx = 0; idx < count; ++idx)
+        {
+            bytes += valueBytes(values[idx]);
+        }
+        return bytes;
+    }
+    /// @brief code the values
+    /// @param first: the values
+    /// @param second: the number of values
+    /// @param third: the output, of encodedBytes() bytes
+    /// @return the end of the output
+    inline std::uint8_t * encode(const std::uint32_t *values, std::size_t count, std::uint8_t *out)
+    {
+        for (std::size_t begin = 0; begin < count; begin += 4)
+        {
+            std::uint8_t *tag = out++;
+            *tag = 0;
+            for (std::size_t idx = begin; idx < begin + 4 && idx < count; ++idx)
+            {
+                IntType numBytes = valueBytes(values[idx]);
+                *tag |= (numBytes - 1) << (2 * (idx - begin));
+                for (IntType byte = 0; byte < numBytes; ++byte)
+                {
+                    *out++ = static_cast<std::uint8_t>(values[idx] >> (8 * byte));
+                }
+            }
+        }
+        return out;
+    }
+    /// @brief decode a group
+    /// @param first: the group
+    /// @param second: the bytes readable from the group on
+    /// @param third: the number of values in the group, 1 to 4
+    /// @param fourth: the output of four values. Those past the count are undefined
+    /// @return the next group
+    inline const std::uint8_t * decodeGroup(const std::uint8_t *in, std::size_t avail, IntType count, std::uint32_t *out)
+    {
+        std::uint8_t tag = *in++;
+#if defined(__SSSE3__)
+        if (avail >= 17)
+        {
+            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+            __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffleTable[tag]));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_shuffle_epi8(data, shuffle));
+            // The missing values of a short group have no bytes though the tag counts one each
+            return in + groupBytes(tag) - 1 - (4 - count);
+        }
+#endif
+        (void)avail;
+        for (IntType idx = 0; idx < count; ++idx)
+        {
+            IntType numBytes = ((tag >> (2 * idx)) & 3) + 1;
+            std::uint32_t value = 0;
+            for (IntType byte = 0; byte < numBytes; ++byte)
+            {
+                value |= static_cast<std::uint32_t>(in[byte]) << (8 * byte);
+            }
+            out[idx] = value;
+            in += numBytes;
+        }
+        return in;
+    }
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_GROUP_VARINT_H_
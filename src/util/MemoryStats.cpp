@@ -0,0 +1,32 @@
+#include "MemoryStats.h"
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+std::uint64_t MemoryStats::residentBytes()
+{
+    FILE *fp = std::fopen("/proc/self/statm", "r");
+    if (fp == nullptr)
+    {
+        return 0;
+    }
+    unsigned long long size = 0, resident = 0;
+    IntType numRead = std::fscanf(fp, "%llu %llu", &size, &resident);
+    std::fclose(fp);
+    return numRead == 2 ? resident * static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE)) : 0;
+}
+
+std::uint64_t MemoryStats::peakResidentBytes()
+{
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+    // ru_maxrss is in kilobytes on Linux
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,44 @@
+/**
+ * @file MemoryStats.h
+ * @brief Estimate the heap bytes held by containers, and read the memory of the process
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_MEMORY_STATS_H_
+#define ABC_PY_MEMORY_STATS_H_
+
+#include <vector>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief Estimates of the heap bytes of the standard containers. They count the reserved capacity,
+/// and for node-based containers one node per element plus the bucket array, as libstdc++ lays them out
+namespace MemoryStats
+{
+    /// @brief the bytes of the buffer of a vector
+    template<typename T>
+    inline std::uint64_t vectorBytes(const std::vector<T> &values)
+    {
+        return values.capacity() * sizeof(T);
+    }
+    /// @brief the bytes of the nodes and buckets of an unordered container
+    template<typename Container>
+    inline std::uint64_t hashBytes(const Container &container)
+    {
+        // A node holds the next pointer, the value and the cached hash
+        return container.bucket_count() * sizeof(void *)
+            + container.size() * (sizeof(void *) + sizeof(typename Container::value_type) + sizeof(std::size_t));
+    }
+    /// @brief the resident set size of the process, from /proc/self/statm
+    /// @return the bytes. 0 if unknown
+    std::uint64_t residentBytes();
+    /// @brief the peak resident set size of the process, from getrusage
+    /// @return the bytes
+    std::uint64_t peakResidentBytes();
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_MEMORY_STATS_H_
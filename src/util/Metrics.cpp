@@ -0,0 +1,384 @@
+#include "Metrics.h"
+#include <cstdio>
+#include <pthread.h>
+#include <unistd.h>
+#include "MsgPrinter.h"
+#include "Assert.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+void MetricGauge::add(RealType delta)
+{
+    RealType cur = _value.load(std::memory_order_relaxed);
+    while (!_value.compare_exchange_weak(cur, cur + delta, std::memory_order_relaxed)) {}
+}
+
+MetricHistogram::MetricHistogram(const std::vector<RealType> &bounds)
+    : _bounds(bounds), _counts(new std::atomic<std::uint64_t>[bounds.size() + 1])
+{
+    for (IndexType idx = 0; idx <= _bounds.size(); ++idx)
+    {
+        _counts[idx].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(RealType value)
+{
+    IndexType bucket = 0;
+    while (bucket < _bounds.size() && value > _bounds[bucket])
+    {
+        ++bucket;
+    }
+    _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    RealType cur = _sum.load(std::memory_order_relaxed);
+    while (!_sum.compare_exchange_weak(cur, cur + value, std::memory_order_relaxed)) {}
+}
+
+MetricsRegistry & MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+/// The registry whose lock is held across a fork. Null once destroyed
+static MetricsRegistry *forkedRegistry = nullptr;
+
+MetricsRegistry::MetricsRegistry()
+    : _worker(std::to_string(::getpid())), _startTime(std::chrono::steady_clock::now())
+{
+    // Take the lock across every fork, so a child never inherits it held by a thread that does not exist there.
+    // The forked children of abc_py, the workers and the timed actions among them, update the metrics.
+    // The child relabels itself before letting go of the lock, so its dumps are not taken for those of its parent
+    forkedRegistry = this;
+    ::pthread_atfork([]() { if (forkedRegistry) { forkedRegistry->_mutex.lock(); } },
+            []() { if (forkedRegistry) { forkedRegistry->_mutex.unlock(); } },
+            []()
+            {
+                if (forkedRegistry)
+                {
+                    std::string pid = std::to_string(::getpid());
+                    forkedRegistry->_worker = forkedRegistry->_workerBase.empty() ? pid : forkedRegistry->_workerBase + "/" + pid;
+                    forkedRegistry->_mutex.unlock();
+                }
+            });
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    this->stopPeriodicDump();
+    forkedRegistry = nullptr;
+}
+
+const std::vector<RealType> & MetricsRegistry::timeBuckets()
+{
+    static const std::vector<RealType> buckets = {
+        0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1, 0.5, 1, 5, 10, 50, 100, 500 };
+    return buckets;
+}
+
+MetricsRegistry::Entry & MetricsRegistry::findOrCreate(MetricKind kind, const std::string &name, const std::string &help, const std::string &labels)
+{
+    auto key = std::make_pair(name, labels);
+    auto iter = _entries.find(key);
+    if (iter != _entries.end())
+    {
+        AssertMsg(iter->second.kind == kind, "Metric %s is registered with another type \n", name.c_str());
+        return iter->second;
+    }
+    Entry &entry = _entries[key];
+    entry.kind = kind;
+    entry.name = name;
+    entry.help = help;
+    entry.labels = labels;
+    return entry;
+}
+
+MetricCounter & MetricsRegistry::counter(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry &entry = findOrCreate(MetricKind::COUNTER, name, help, labels);
+    if (!entry.counter)
+    {
+        entry.counter.reset(new MetricCounter());
+    }
+    return *entry.counter;
+}
+
+MetricGauge & MetricsRegistry::gauge(const std::string &name, const std::string &help, const std::string &labels)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry &entry = findOrCreate(MetricKind::GAUGE, name, help, labels);
+    if (!entry.gauge)
+    {
+        entry.gauge.reset(new MetricGauge());
+    }
+    return *entry.gauge;
+}
+
+MetricHistogram & MetricsRegistry::histogram(const std::string &name, const std::string &help, const std::string &labels,
+        const std::vector<RealType> &bounds)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Entry &entry = findOrCreate(MetricKind::HISTOGRAM, name, help, labels);
+    if (!entry.histogram)
+    {
+        entry.histogram.reset(new MetricHistogram(bounds.empty() ? timeBuckets() : bounds));
+    }
+    return *entry.histogram;
+}
+
+void MetricsRegistry::setWorker(const std::string &worker)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _worker = worker;
+    _workerBase = worker;
+}
+
+std::string MetricsRegistry::worker()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _worker;
+}
+
+/// @brief escape a Prometheus label value or help text: backslashes and newlines, and the quotes of a label value
+static std::string promEscape(const std::string &text, bool quotes)
+{
+    std::string result;
+    for (char c : text)
+    {
+        if (c == '\\' || (quotes && c == '"')) { result += '\\'; result += c; }
+        else if (c == '\n') { result += "\\n"; }
+        else { result += c; }
+    }
+    return result;
+}
+
+/// @brief escape a JSON string: quotes, backslashes and control characters
+static std::string jsonEscape(const std::string &text)
+{
+    std::string result;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') { result += '\\'; result += c; }
+        else if (c == '\n') { result += "\\n"; }
+        else if (c == '\r') { result += "\\r"; }
+        else if (c == '\t') { result += "\\t"; }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+            result += code;
+        }
+        else { result += c; }
+    }
+    return result;
+}
+
+/// @brief the label string of one sample: the worker label, the metric labels and an extra label
+static std::string sampleLabels(const std::string &worker, const std::string &labels, const std::string &extra = "")
+{
+    std::string result = "{worker=\"" + promEscape(worker, true) + "\"";
+    if (!labels.empty())
+    {
+        result += "," + labels;
+    }
+    if (!extra.empty())
+    {
+        result += "," + extra;
+    }
+    return result + "}";
+}
+
+/// @brief the shortest representation of a bucket bound
+static std::string boundStr(RealType bound)
+{
+    std::ostringstream os;
+    os << bound;
+    return os.str();
+}
+
+/// @brief convert the label string `a="x",b="y"` into JSON object members `"a":"x","b":"y"`.
+/// The values are in the Prometheus syntax, whose escapes are undone before escaping them for JSON
+static std::string jsonLabels(const std::string &labels)
+{
+    std::string result;
+    std::string token;
+    bool inValue = false;
+    bool escaped = false;
+    for (char c : labels)
+    {
+        if (inValue)
+        {
+            if (escaped)
+            {
+                token += c == 'n' ? '\n' : c;
+                escaped = false;
+            }
+            else if (c == '\\')
+            {
+                escaped = true;
+            }
+            else if (c == '"')
+            {
+                result += "\"" + jsonEscape(token) + "\"";
+                token.clear();
+                inValue = false;
+            }
+            else
+            {
+                token += c;
+            }
+            continue;
+        }
+        if (c == '=') { result += "\"" + jsonEscape(token) + "\":"; token.clear(); continue; }
+        if (c == '"') { inValue = true; continue; }
+        if (c == ',') { result += ","; continue; }
+        token += c;
+    }
+    return result;
+}
+
+void MetricsRegistry::renderPrometheus(std::ostringstream &os)
+{
+    std::string lastName;
+    for (const auto &pair : _entries)
+    {
+        const Entry &entry = pair.second;
+        if (entry.name != lastName)
+        {
+            const char *type = entry.kind == MetricKind::COUNTER ? "counter" : entry.kind == MetricKind::GAUGE ? "gauge" : "histogram";
+            os << "# HELP " << entry.name << " " << promEscape(entry.help, false) << "\n";
+            os << "# TYPE " << entry.name << " " << type << "\n";
+            lastName = entry.name;
+        }
+        if (entry.kind == MetricKind::COUNTER)
+        {
+            os << entry.name << sampleLabels(_worker, entry.labels) << " " << entry.counter->value() << "\n";
+        }
+        else if (entry.kind == MetricKind::GAUGE)
+        {
+            os << entry.name << sampleLabels(_worker, entry.labels) << " " << entry.gauge->value() << "\n";
+        }
+        else
+        {
+            const MetricHistogram &hist = *entry.histogram;
+            std::uint64_t cumulative = 0;
+            for (IndexType idx = 0; idx < hist.bounds().size(); ++idx)
+            {
+                cumulative += hist.bucketCount(idx);
+                os << entry.name << "_bucket" << sampleLabels(_worker, entry.labels, "le=\"" + boundStr(hist.bounds()[idx]) + "\"")
+                   << " " << cumulative << "\n";
+            }
+            cumulative += hist.bucketCount(hist.bounds().size());
+            os << entry.name << "_bucket" << sampleLabels(_worker, entry.labels, "le=\"+Inf\"") << " " << cumulative << "\n";
+            os << entry.name << "_sum" << sampleLabels(_worker, entry.labels) << " " << hist.sum() << "\n";
+            os << entry.name << "_count" << sampleLabels(_worker, entry.labels) << " " << hist.count() << "\n";
+        }
+    }
+}
+
+void MetricsRegistry::renderJson(std::ostringstream &os)
+{
+    RealType uptime = std::chrono::duration<RealType>(std::chrono::steady_clock::now() - _startTime).count();
+    os << "{\"worker\":\"" << jsonEscape(_worker) << "\",\"timestamp\":" << std::time(nullptr) << ",\"uptime\":" << uptime << ",\"metrics\":[";
+    bool first = true;
+    for (const auto &pair : _entries)
+    {
+        const Entry &entry = pair.second;
+        if (!first) { os << ","; }
+        first = false;
+        os << "{\"name\":\"" << jsonEscape(entry.name) << "\",\"help\":\"" << jsonEscape(entry.help) << "\",\"labels\":{"
+           << jsonLabels(entry.labels) << "},";
+        if (entry.kind == MetricKind::COUNTER)
+        {
+            os << "\"type\":\"counter\",\"value\":" << entry.counter->value() << "}";
+        }
+        else if (entry.kind == MetricKind::GAUGE)
+        {
+            os << "\"type\":\"gauge\",\"value\":" << entry.gauge->value() << "}";
+        }
+        else
+        {
+            const MetricHistogram &hist = *entry.histogram;
+            os << "\"type\":\"histogram\",\"count\":" << hist.count() << ",\"sum\":" << hist.sum() << ",\"buckets\":[";
+            for (IndexType idx = 0; idx <= hist.bounds().size(); ++idx)
+            {
+                if (idx > 0) { os << ","; }
+                os << "[";
+                if (idx < hist.bounds().size()) { os << hist.bounds()[idx]; }
+                else { os << "\"+Inf\""; }
+                os << "," << hist.bucketCount(idx) << "]";
+            }
+            os << "]}";
+        }
+    }
+    os << "]}\n";
+}
+
+std::string MetricsRegistry::render(MetricsFormat format)
+{
+    std::ostringstream os;
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (format == MetricsFormat::JSON)
+    {
+        renderJson(os);
+    }
+    else
+    {
+        renderPrometheus(os);
+    }
+    return os.str();
+}
+
+bool MetricsRegistry::dump(const std::string &path, MetricsFormat format)
+{
+    std::string text = this->render(format);
+    std::string tmpPath = path + ".tmp";
+    FILE *fp = fopen(tmpPath.c_str(), "w");
+    if (fp == nullptr)
+    {
+        MsgPrinter::err("Cannot open metrics file %s \n", tmpPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(text.data(), 1, text.size(), fp) == text.size();
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        MsgPrinter::err("Cannot write metrics file %s \n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+void MetricsRegistry::startPeriodicDump(const std::string &path, MetricsFormat format, RealType intervalSec)
+{
+    this->stopPeriodicDump();
+    _dumpStop = false;
+    auto interval = std::chrono::duration<RealType>(intervalSec);
+    _dumpThread = std::thread([this, path, format, interval]()
+    {
+        std::unique_lock<std::mutex> lock(_dumpMutex);
+        while (!_dumpStop)
+        {
+            _dumpCond.wait_for(lock, interval, [this]() { return _dumpStop; });
+            this->dump(path, format);
+        }
+    });
+}
+
+void MetricsRegistry::stopPeriodicDump()
+{
+    if (!_dumpThread.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_dumpMutex);
+        _dumpStop = true;
+    }
+    _dumpCond.notify_all();
+    _dumpThread.join();
+}
+
+PROJECT_NAMESPACE_END
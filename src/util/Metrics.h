@@ -0,0 +1,187 @@
+/**
+ * @file Metrics.h
+ * @brief A process-wide registry of counters, gauges and histograms, dumped as JSON or Prometheus text
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_METRICS_H_
+#define ABC_PY_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The output format of the metrics dump
+enum class MetricsFormat
+{
+    JSON,
+    PROMETHEUS
+};
+
+/// @class ABC_PY::MetricCounter
+/// @brief Monotonically increasing counter. Lock-free
+class MetricCounter
+{
+    public:
+        explicit MetricCounter() = default;
+        /// @brief increase the counter
+        /// @param the increment
+        void inc(std::uint64_t n = 1) { _value.fetch_add(n, std::memory_order_relaxed); }
+        /// @brief get the current value
+        std::uint64_t value() const { return _value.load(std::memory_order_relaxed); }
+    private:
+        std::atomic<std::uint64_t> _value{0}; ///< The count
+};
+
+/// @class ABC_PY::MetricGauge
+/// @brief A value that can go up and down. Lock-free
+class MetricGauge
+{
+    public:
+        explicit MetricGauge() = default;
+        /// @brief set the value
+        void set(RealType value) { _value.store(value, std::memory_order_relaxed); }
+        /// @brief add to the value
+        void add(RealType delta);
+        /// @brief get the current value
+        RealType value() const { return _value.load(std::memory_order_relaxed); }
+    private:
+        std::atomic<RealType> _value{0.0}; ///< The value
+};
+
+/// @class ABC_PY::MetricHistogram
+/// @brief Histogram with fixed bucket upper bounds. Lock-free observation
+class MetricHistogram
+{
+    public:
+        /// @brief constructor
+        /// @param the upper bounds of the buckets, sorted. An implicit +Inf bucket is appended
+        explicit MetricHistogram(const std::vector<RealType> &bounds);
+        /// @brief record one observation
+        void observe(RealType value);
+        /// @brief the bucket upper bounds
+        const std::vector<RealType> & bounds() const { return _bounds; }
+        /// @brief the non-cumulative count of bucket idx. idx == bounds().size() is the +Inf bucket
+        std::uint64_t bucketCount(IndexType idx) const { return _counts[idx].load(std::memory_order_relaxed); }
+        /// @brief the number of observations
+        std::uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+        /// @brief the sum of observations
+        RealType sum() const { return _sum.load(std::memory_order_relaxed); }
+    private:
+        std::vector<RealType> _bounds; ///< The upper bounds of the buckets
+        std::unique_ptr<std::atomic<std::uint64_t>[]> _counts; ///< The count of each bucket, plus +Inf
+        std::atomic<std::uint64_t> _count{0}; ///< The number of observations
+        std::atomic<RealType> _sum{0.0}; ///< The sum of observations
+};
+
+/// @class ABC_PY::MetricsRegistry
+/// @brief The process-wide registry. Metrics are identified by name and a label string such as `action="rewrite"`.
+/// Lookups take a lock; the returned references stay valid for the lifetime of the process and updating them does not.
+/// The lock is held across fork(), so a forked child can use the registry whichever thread forked. The child starts
+/// with the counts of its parent and a worker label of its own
+class MetricsRegistry
+{
+    public:
+        /// @brief get the registry of this process
+        static MetricsRegistry & instance();
+        ~MetricsRegistry();
+        /*------------------------------*/
+        /* Get or create metrics        */
+        /*------------------------------*/
+        /// @brief get or create a counter
+        /// @param first: the metric name
+        /// @param second: the help text, used when the metric is created
+        /// @param third: the label string, e.g. `action="rewrite"`, with the values escaped as in the Prometheus text format. Empty for no label
+        MetricCounter & counter(const std::string &name, const std::string &help, const std::string &labels = "");
+        /// @brief get or create a gauge
+        MetricGauge & gauge(const std::string &name, const std::string &help, const std::string &labels = "");
+        /// @brief get or create a histogram
+        /// @param fourth: the bucket upper bounds, used when the metric is created. Empty for timeBuckets()
+        MetricHistogram & histogram(const std::string &name, const std::string &help, const std::string &labels = "",
+                const std::vector<RealType> &bounds = std::vector<RealType>());
+        /// @brief the default buckets for latencies in seconds
+        static const std::vector<RealType> & timeBuckets();
+        /*------------------------------*/
+        /* Export                       */
+        /*------------------------------*/
+        /// @brief set the worker label attached to every exported metric. Defaults to the process id.
+        /// A forked child takes the label followed by its process id, e.g. `trainer/1234`
+        void setWorker(const std::string &worker);
+        /// @brief get the worker label
+        std::string worker();
+        /// @brief render all the metrics
+        /// @param the format
+        /// @return the text
+        std::string render(MetricsFormat format);
+        /// @brief write all the metrics to a file. Written to a temporary file and renamed, so that readers never see a partial file
+        /// @param first: the path
+        /// @param second: the format
+        /// @return if successful
+        bool dump(const std::string &path, MetricsFormat format);
+        /// @brief start dumping to a file periodically from a background thread. Restarts if already running
+        /// @param first: the path
+        /// @param second: the format
+        /// @param third: the interval in seconds
+        void startPeriodicDump(const std::string &path, MetricsFormat format, RealType intervalSec);
+        /// @brief stop the periodic dump. Writes the file one last time
+        void stopPeriodicDump();
+    private:
+        explicit MetricsRegistry();
+        /// @brief the type of a registered metric
+        enum class MetricKind { COUNTER, GAUGE, HISTOGRAM };
+        /// @brief one registered metric
+        struct Entry
+        {
+            MetricKind kind;
+            std::string name;
+            std::string help;
+            std::string labels;
+            std::unique_ptr<MetricCounter> counter;
+            std::unique_ptr<MetricGauge> gauge;
+            std::unique_ptr<MetricHistogram> histogram;
+        };
+        Entry & findOrCreate(MetricKind kind, const std::string &name, const std::string &help, const std::string &labels);
+        void renderJson(std::ostringstream &os);
+        void renderPrometheus(std::ostringstream &os);
+    private:
+        std::mutex _mutex; ///< Protects the entries and the worker label
+        std::map<std::pair<std::string, std::string>, Entry> _entries; ///< (name, labels) -> metric. Ordered to group by name when rendering
+        std::string _worker; ///< The worker label
+        std::string _workerBase; ///< The label set by setWorker(), which the forked children extend. Empty for the process id
+        std::chrono::steady_clock::time_point _startTime; ///< The creation time of the registry
+        std::thread _dumpThread; ///< The periodic dump thread
+        std::mutex _dumpMutex; ///< Protects the periodic dump state
+        std::condition_variable _dumpCond; ///< Wakes the periodic dump thread up on stop
+        bool _dumpStop = false; ///< Whether the periodic dump thread should stop
+};
+
+/// @class ABC_PY::MetricsTimer
+/// @brief Measure the wall time from construction
+class MetricsTimer
+{
+    public:
+        explicit MetricsTimer() : _begin(std::chrono::steady_clock::now()) {}
+        /// @brief restart the timer
+        void reset() { _begin = std::chrono::steady_clock::now(); }
+        /// @brief the elapsed seconds
+        RealType elapsed() const
+        {
+            return std::chrono::duration<RealType>(std::chrono::steady_clock::now() - _begin).count();
+        }
+    private:
+        std::chrono::steady_clock::time_point _begin; ///< The starting time
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ABC_PY_METRICS_H_
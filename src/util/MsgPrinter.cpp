@@ -11,6 +11,7 @@ std::time_t MsgPrinter::_startTime = std::time(nullptr);
 FILE* MsgPrinter::_screenOutStream = stderr;
 FILE* MsgPrinter::_logOutStream = nullptr;
 std::string MsgPrinter::_logFileName = "";
+MsgType MsgPrinter::_level = MSG_COMPILED_LEVEL;
 
 /// Converting enum type to std::string
 std::string msgTypeToStr(MsgType msgType) 
@@ -23,6 +24,7 @@ std::string msgTypeToStr(MsgType msgType)
         case MsgType::DBG:  return "DBG"; break;
     }
     AssertMsg(false, "Unknown MsgType. \n");
+    return "";
 }
 
 /// Open a log file, all output will be stored in the log
@@ -95,9 +97,22 @@ void MsgPrinter::dbg(const char* rawFormat, ...)
     va_end(args);
 }
 
+/// Print a message of a given type. The level has been checked by the caller
+void MsgPrinter::emit(MsgType msgType, const char* rawFormat, ...) 
+{
+    va_list args;
+    va_start(args, rawFormat);
+    print(msgType, rawFormat, args);
+    va_end(args);
+}
+
 /// Message printing kernel
 void MsgPrinter::print(MsgType msgType, const char* rawFormat, va_list args) 
 {
+    if (!isEnabled(msgType))
+    {
+        return;
+    }
     /// Get the message type
     std::string type = "[" + msgTypeToStr(msgType);
 
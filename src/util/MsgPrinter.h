@@ -20,15 +20,18 @@ PROJECT_NAMESPACE_BEGIN
 /// ================================================================================ 
 
 
-/// Enum type for message printing
+/// Enum type for message printing. Ordered from the most severe to the most verbose
 enum class MsgType 
 {
-    INF,
-    WRN,
-    ERR,
-    DBG
+    ERR = 0,
+    WRN = 1,
+    INF = 2,
+    DBG = 3
 };
 
+/// The most verbose message type compiled into the library
+constexpr MsgType MSG_COMPILED_LEVEL = static_cast<MsgType>(ABC_PY_LOG_LEVEL);
+
 /// Function converting enum type to std::string
 std::string msgTypeToStr(MsgType msgType);
 
@@ -47,7 +50,34 @@ class MsgPrinter
         static void err(const char *rawFormat, ...);
         static void dbg(const char *rawFormat, ...);
 
+        static void    setLevel(MsgType level) { _level = level; } // Set the runtime message level
+        static MsgType level()                 { return _level; }  // The runtime message level
+
+        /// Whether a message type is compiled in. Decided at compile time
+        template<MsgType msgType>
+        static constexpr bool isCompiled() { return static_cast<int>(msgType) <= static_cast<int>(MSG_COMPILED_LEVEL); }
+        /// Whether a message type is compiled in and not filtered by the runtime level
+        template<MsgType msgType>
+        static bool isEnabled() { return isCompiled<msgType>() && isEnabled(msgType); }
+        static bool isEnabled(MsgType msgType) 
+        { 
+            return static_cast<int>(msgType) <= static_cast<int>(MSG_COMPILED_LEVEL) 
+                && static_cast<int>(msgType) <= static_cast<int>(_level); 
+        }
+
+        /// Print a message of msgType if it is enabled. The arguments are evaluated by the caller either way;
+        /// the INF/WRN/ERR/DBG macros skip them as well when the message is filtered out
+        template<MsgType msgType, typename... Args>
+        static void log(const char *rawFormat, Args... args)
+        {
+            if (isEnabled<msgType>())
+            {
+                emit(msgType, rawFormat, args...);
+            }
+        }
+
     private:
+        static void emit(MsgType msgType, const char *rawFormat, ...);
         static void print(MsgType msgType, const char *rawFormat, va_list args);
 
     private:
@@ -55,8 +85,19 @@ class MsgPrinter
         static FILE *        _screenOutStream;  // Out stream for screen printing
         static FILE *        _logOutStream;     // Out stream for log printing
         static std::string   _logFileName;      // Current log file name
+        static MsgType       _level;            // Runtime message level
 };
 
 PROJECT_NAMESPACE_END
 
+/// Print a message of msgType. Nothing, the arguments included, is evaluated when the type is filtered out,
+/// and the whole statement folds away when the type is not compiled in
+#define ABC_PY_LOG(msgType, ...) \
+        do { \
+            if (PROJECT_NAMESPACE::MsgPrinter::isEnabled<msgType>()) \
+            { \
+                PROJECT_NAMESPACE::MsgPrinter::log<msgType>(__VA_ARGS__); \
+            } \
+        } while (false)
+
 #endif // ZKUTIL_MSGPRINTER_H_
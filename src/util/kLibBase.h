@@ -181,6 +181,15 @@ namespace klib
     {
         return (klib::absDif<T>(lhs.x(), rhs.x()) + klib::absDif<T>(lhs.y(), rhs.y()) + klib::absDif<T>(lhs.z(), rhs.z())) == 1;
     }
+    /// @brief mix the bits of a 64-bit value (SplitMix64). Used to derive independent random streams from a seed
+    inline std::uint64_t splitMix64(std::uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
     // ================================================================================ 
     // Parser string
     // ================================================================================ 
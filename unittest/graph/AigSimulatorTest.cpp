@@ -0,0 +1,148 @@
+/**
+ * @file AigSimulatorTest.cpp
+ * @brief The signatures and the candidate equivalence classes of the simulator
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <gtest/gtest.h>
+#include "graph/AigSimulator.h"
+#include "TestMirror.h"
+
+using namespace PROJECT_NAMESPACE;
+
+namespace
+{
+
+/// @brief a graph with equivalent nodes: 3 and 4 are a & b, 5 is !a, 6 is constant 0 and 7 is !a & b
+std::vector<AigNode> equivalentNodes()
+{
+    return abc_py_test::buildMirror({
+            { AIG_NODE_CONST1, -1, -1 },
+            { AIG_NODE_PI, -1, -1 },
+            { AIG_NODE_PI, -1, -1 },
+            { AIG_NODE_NONO, 1, 2 },
+            { AIG_NODE_NONO, 2, 1 },
+            { AIG_NODE_INVINV, 1, 1 },
+            { AIG_NODE_INVNO, 1, 1 },
+            { AIG_NODE_INVNO, 1, 2 },
+            { AIG_NODE_PO, 3, -1 },
+            });
+}
+
+/// @brief a random graph large enough for the threads to split its levels
+/// @param the number of AND nodes
+std::vector<AigNode> randomGraph(IntType numAnds)
+{
+    const IntType numPis = 32;
+    std::vector<abc_py_test::NodeSpec> specs = { { AIG_NODE_CONST1, -1, -1 } };
+    for (IntType pi = 0; pi < numPis; ++pi)
+    {
+        specs.push_back({ AIG_NODE_PI, -1, -1 });
+    }
+    const IntType nodeTypes[] = { AIG_NODE_NONO, AIG_NODE_INVNO, AIG_NODE_INVINV };
+    std::uint64_t state = 1;
+    for (IntType idx = 0; idx < numAnds; ++idx)
+    {
+        IntType numNodes = specs.size();
+        state = klib::splitMix64(state);
+        IntType fanin0 = 1 + static_cast<IntType>(state % (numNodes - 1));
+        IntType fanin1 = 1 + static_cast<IntType>((state >> 32) % (numNodes - 1));
+        specs.push_back({ nodeTypes[(state >> 16) % 3], fanin0, fanin1 });
+    }
+    IntType numNodes = specs.size();
+    for (IntType po = 0; po < 16; ++po)
+    {
+        specs.push_back({ AIG_NODE_PO, numNodes - 1 - po, -1 });
+    }
+    return abc_py_test::buildMirror(specs);
+}
+
+/// @brief check the classes of equivalentNodes()
+void expectClasses(const AigSimulator &sim)
+{
+    const std::vector<IntType> &classIds = sim.classIds();
+    const std::vector<IntType> &phases = sim.classPhases();
+    ASSERT_EQ(classIds.size(), 9u);
+    EXPECT_EQ(sim.numClasses(), 3);
+    EXPECT_GE(classIds[3], 0);
+    EXPECT_EQ(classIds[3], classIds[4]);
+    EXPECT_EQ(phases[3], phases[4]);
+    // Equivalent up to complement
+    EXPECT_GE(classIds[1], 0);
+    EXPECT_EQ(classIds[1], classIds[5]);
+    EXPECT_NE(phases[1], phases[5]);
+    EXPECT_GE(classIds[0], 0);
+    EXPECT_EQ(classIds[0], classIds[6]);
+    EXPECT_NE(phases[0], phases[6]);
+    EXPECT_EQ(classIds[2], -1);
+    EXPECT_EQ(classIds[7], -1);
+    // The POs are not classified
+    EXPECT_EQ(classIds[8], -1);
+}
+
+TEST(AigSimulatorTest, ClassesOfUserPatterns)
+{
+    std::vector<AigNode> nodes = equivalentNodes();
+    AigSimulator sim;
+    sim.setNumWords(1);
+    // All four values of (a, b) in bits 0 to 3
+    ASSERT_TRUE(sim.simulate(nodes, { 0xC, 0xA }));
+    EXPECT_EQ(sim.piNodes(), std::vector<IntType>({ 1, 2 }));
+    EXPECT_EQ(sim.signature(3)[0], 0x8u);
+    EXPECT_EQ(sim.signature(7)[0], 0x2u);
+    EXPECT_EQ(sim.signature(8)[0], 0x8u);
+    ASSERT_TRUE(sim.computeClasses(nodes));
+    expectClasses(sim);
+}
+
+TEST(AigSimulatorTest, ClassesOfRandomPatterns)
+{
+    std::vector<AigNode> nodes = equivalentNodes();
+    AigSimulator sim;
+    sim.setNumWords(16);
+    sim.setNumThreads(2);
+    sim.setRandomSeed(7);
+    sim.simulateRandom(nodes);
+    EXPECT_EQ(sim.sigWords(), 16);
+    ASSERT_TRUE(sim.computeClasses(nodes));
+    expectClasses(sim);
+}
+
+TEST(AigSimulatorTest, ThreadsMatchOneThread)
+{
+    // The default 4 words are split by level, 32 words by blocks of words
+    std::vector<AigNode> nodes = randomGraph(4096);
+    for (IntType numWords : { 4, 32 })
+    {
+        AigSimulator serial, parallel;
+        for (AigSimulator *sim : { &serial, &parallel })
+        {
+            sim->setNumWords(numWords);
+            sim->setRandomSeed(3);
+        }
+        serial.setNumThreads(1);
+        parallel.setNumThreads(4);
+        serial.simulateRandom(nodes);
+        parallel.simulateRandom(nodes);
+        EXPECT_TRUE(serial.signatures() == parallel.signatures()) << numWords;
+    }
+}
+
+TEST(AigSimulatorTest, RefusesMismatchedSignatures)
+{
+    std::vector<AigNode> nodes = equivalentNodes();
+    AigSimulator sim;
+    EXPECT_FALSE(sim.computeClasses(nodes));
+    sim.setNumWords(1);
+    EXPECT_FALSE(sim.simulate(nodes, { 0xC }));
+    ASSERT_TRUE(sim.simulate(nodes, { 0xC, 0xA }));
+    // The words per node changed after the simulation do not apply to its signatures
+    sim.setNumWords(4);
+    EXPECT_TRUE(sim.computeClasses(nodes));
+    std::vector<AigNode> fewer(nodes.begin(), nodes.end() - 1);
+    EXPECT_FALSE(sim.computeClasses(fewer));
+    EXPECT_TRUE(sim.classIds().empty());
+}
+
+} // namespace
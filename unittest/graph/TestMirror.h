@@ -0,0 +1,60 @@
+/**
+ * @file TestMirror.h
+ * @brief Mirrored graphs built by hand for the unit tests
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_UNITTEST_TEST_MIRROR_H_
+#define ABC_PY_UNITTEST_TEST_MIRROR_H_
+
+#include <algorithm>
+#include <vector>
+#include "interface/AigNode.h"
+
+namespace abc_py_test
+{
+
+/// @brief one node of a hand-built mirror
+struct NodeSpec
+{
+    PROJECT_NAMESPACE::IntType nodeType; ///< The AigNodeType. AIG_NODE_NUMBER for an empty slot
+    PROJECT_NAMESPACE::IntType fanin0; ///< The fanin 0. -1 for none
+    PROJECT_NAMESPACE::IntType fanin1; ///< The fanin 1. -1 for none
+};
+
+/// @brief build a mirror, deriving the levels and the fanouts from the fanins
+/// @param the nodes, each after its fanins
+/// @return the mirror
+inline std::vector<PROJECT_NAMESPACE::AigNode> buildMirror(const std::vector<NodeSpec> &specs)
+{
+    using PROJECT_NAMESPACE::IntType;
+    std::vector<std::vector<IntType>> fanouts(specs.size());
+    std::vector<IntType> levels(specs.size(), 0);
+    for (IntType idx = 0; idx < static_cast<IntType>(specs.size()); ++idx)
+    {
+        for (IntType fanin : { specs[idx].fanin0, specs[idx].fanin1 })
+        {
+            if (fanin >= 0)
+            {
+                fanouts[fanin].push_back(idx);
+                levels[idx] = std::max(levels[idx], levels[fanin] + 1);
+            }
+        }
+    }
+    std::vector<PROJECT_NAMESPACE::AigNode> nodes(specs.size());
+    for (IntType idx = 0; idx < static_cast<IntType>(specs.size()); ++idx)
+    {
+        const NodeSpec &spec = specs[idx];
+        if (spec.nodeType == PROJECT_NAMESPACE::AIG_NODE_NUMBER)
+        {
+            continue;
+        }
+        nodes[idx].configureNode(spec.nodeType, spec.fanin0, spec.fanin1, false, levels[idx], fanouts[idx].data(), fanouts[idx].size());
+    }
+    return nodes;
+}
+
+} // namespace abc_py_test
+
+#endif //ABC_PY_UNITTEST_TEST_MIRROR_H_
@@ -0,0 +1,107 @@
+/**
+ * @file AigCheckpointTest.cpp
+ * @brief The round trips of the checkpoints, in memory and through a file
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <gtest/gtest.h>
+#include "interface/AbcInterface.h"
+#include "interface/AigCheckpoint.h"
+#include "TestDesign.h"
+
+using namespace PROJECT_NAMESPACE;
+
+namespace
+{
+
+void expectSameStats(const AigStats &expected, const AigStats &actual)
+{
+    EXPECT_EQ(expected.numIn(), actual.numIn());
+    EXPECT_EQ(expected.numOut(), actual.numOut());
+    EXPECT_EQ(expected.numLat(), actual.numLat());
+    EXPECT_EQ(expected.numAnd(), actual.numAnd());
+    EXPECT_EQ(expected.lev(), actual.lev());
+}
+
+TEST(AigCheckpointTest, StatsRoundTrip)
+{
+    AigStats stats;
+    stats.setNumIn(4);
+    stats.setNumOut(2);
+    stats.setNumLat(1);
+    stats.setNumAnd(123456);
+    stats.setLev(17);
+    AigStats decoded;
+    ASSERT_TRUE(AigCheckpoint::decodeStats(AigCheckpoint::encodeStats(stats), decoded));
+    expectSameStats(stats, decoded);
+    EXPECT_FALSE(AigCheckpoint::decodeStats("not a checkpoint", decoded));
+}
+
+TEST(AigCheckpointTest, NodeRoundTrip)
+{
+    const IntType fanouts[] = { 12, 5, 40 };
+    AigNode node;
+    node.configureNode(AIG_NODE_INVNO, 3, 7, false, 2, fanouts, 3);
+    AigNode decoded;
+    ASSERT_TRUE(AigCheckpoint::decodeNode(AigCheckpoint::encodeNode(node), decoded));
+    EXPECT_EQ(node.nodeType(), decoded.nodeType());
+    EXPECT_EQ(node.fanin0(), decoded.fanin0());
+    EXPECT_EQ(node.fanin1(), decoded.fanin1());
+    EXPECT_EQ(node.level(), decoded.level());
+    ASSERT_EQ(node.numFanouts(), decoded.numFanouts());
+    for (IntType idx = 0; idx < node.numFanouts(); ++idx)
+    {
+        EXPECT_EQ(node.fanout(idx), decoded.fanout(idx));
+    }
+}
+
+TEST(AigCheckpointTest, NetworkRoundTripInMemory)
+{
+    AbcInterface abc;
+    abc.start();
+    ASSERT_TRUE(abc.read(abc_py_test::writeDesign("checkpoint_comb.blif", abc_py_test::COMB_BLIF)));
+    AigStats saved = abc.aigStats();
+    std::string bytes = abc.serialize();
+    ASSERT_FALSE(bytes.empty());
+    // Move the network on, so the restore has something to undo
+    ASSERT_TRUE(abc.balance());
+    ASSERT_TRUE(abc.rewrite());
+    ASSERT_TRUE(abc.deserialize(bytes.data(), bytes.size()));
+    expectSameStats(saved, abc.aigStats());
+    // The reference of verify() comes back with the network
+    EXPECT_TRUE(abc.verify().passed());
+}
+
+TEST(AigCheckpointTest, NetworkRoundTripThroughFile)
+{
+    AbcInterface abc;
+    abc.start();
+    ASSERT_TRUE(abc.read(abc_py_test::writeDesign("checkpoint_comb.blif", abc_py_test::COMB_BLIF)));
+    ASSERT_TRUE(abc.rewrite());
+    AigStats saved = abc.aigStats();
+    std::string path = ::testing::TempDir() + "checkpoint_comb.abcckpt";
+    ASSERT_TRUE(abc.checkpoint(path));
+    ASSERT_TRUE(abc.refactor());
+    ASSERT_TRUE(abc.restore(path));
+    expectSameStats(saved, abc.aigStats());
+    EXPECT_TRUE(abc.verify().passed());
+    EXPECT_FALSE(abc.restore(::testing::TempDir() + "no_such_checkpoint.abcckpt"));
+}
+
+TEST(AigCheckpointTest, RefusesLatches)
+{
+    if (ABC_PY_ASSERT)
+    {
+        // The mirror asserts on the latch objects of a network, so only the unchecked build reads one
+        GTEST_SKIP() << "sequential designs need the build without ABC_PY_ASSERT";
+    }
+    AbcInterface abc;
+    abc.start();
+    ASSERT_TRUE(abc.read(abc_py_test::writeDesign("checkpoint_seq.blif", abc_py_test::SEQ_BLIF)));
+    EXPECT_EQ(abc.aigStats().numLat(), 1u);
+    EXPECT_TRUE(abc.serialize().empty());
+    EXPECT_FALSE(abc.checkpoint(::testing::TempDir() + "checkpoint_seq.abcckpt"));
+}
+
+} // namespace
@@ -0,0 +1,113 @@
+/**
+ * @file ParamSweepTest.cpp
+ * @brief The scheduling and the timeouts of the parameter sweep
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <cstdlib>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "interface/AbcCommand.h"
+#include "interface/AbcInterface.h"
+#include "interface/ParamSweep.h"
+#include "util/Metrics.h"
+#include "TestDesign.h"
+#include <abc_src/base/cmd/cmd.h>
+
+using namespace PROJECT_NAMESPACE;
+
+namespace
+{
+
+/// @brief the ABC command "abc_py_test_sleep <seconds>", a point whose run time the test chooses
+int sleepCommand(Abc_Frame_t *, int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        return 1;
+    }
+    ::usleep(static_cast<useconds_t>(std::atof(argv[1]) * 1e6));
+    return 0;
+}
+
+class ParamSweepTest : public ::testing::Test
+{
+    protected:
+        /// @brief start ABC and register the sleeping command once for the suite
+        static void SetUpTestSuite()
+        {
+            AbcInterface abc;
+            abc.start();
+            Cmd_CommandAdd(Abc_FrameGetGlobalFrame(), "Testing", "abc_py_test_sleep", sleepCommand, 0);
+        }
+        void SetUp() override
+        {
+            _abc.start();
+            ASSERT_TRUE(_abc.read(abc_py_test::writeDesign("sweep_comb.blif", abc_py_test::COMB_BLIF)));
+        }
+        AbcInterface _abc;
+};
+
+TEST_F(ParamSweepTest, RunsEveryPointOnACopy)
+{
+    ParamSweep sweep;
+    sweep.addRewrite({ false, true }, { false });
+    sweep.addBalance({ false });
+    AigStats before = _abc.aigStats();
+    std::vector<SweepRow> rows = _abc.sweep(sweep);
+    ASSERT_EQ(rows.size(), 3u);
+    for (const SweepRow &row : rows)
+    {
+        EXPECT_TRUE(row.success) << row.command;
+        EXPECT_FALSE(row.timedOut) << row.command;
+        EXPECT_GT(row.numAnd, 0) << row.command;
+    }
+    // The network itself is left as it was
+    EXPECT_EQ(_abc.aigStats().numAnd(), before.numAnd());
+}
+
+TEST_F(ParamSweepTest, SlowPointDoesNotHoldBackTheOthers)
+{
+    ParamSweep sweep;
+    sweep.addCommand("abc_py_test_sleep 30");
+    for (IntType idx = 0; idx < 6; ++idx)
+    {
+        sweep.addCommand("abc_py_test_sleep 0.05");
+    }
+    sweep.setNumWorkers(2);
+    sweep.setTimeout(1.0);
+    MetricsTimer timer;
+    std::vector<SweepRow> rows = _abc.sweep(sweep);
+    // The fast points take turns in the second slot while the slow one runs out its budget
+    EXPECT_LT(timer.elapsed(), 5.0);
+    ASSERT_EQ(rows.size(), 7u);
+    EXPECT_FALSE(rows[0].success);
+    EXPECT_TRUE(rows[0].timedOut);
+    EXPECT_GE(rows[0].runtime, 1.0);
+    for (IndexType idx = 1; idx < rows.size(); ++idx)
+    {
+        EXPECT_TRUE(rows[idx].success) << idx;
+        EXPECT_FALSE(rows[idx].timedOut) << idx;
+        EXPECT_LT(rows[idx].runtime, 1.0) << idx;
+    }
+}
+
+TEST_F(ParamSweepTest, TimedOutPointsAreRetried)
+{
+    ParamSweep sweep;
+    sweep.addCommand("abc_py_test_sleep 30");
+    sweep.addCommand("abc_py_test_sleep 0.01");
+    sweep.setTimeout(0.5);
+    std::vector<SweepRow> first = _abc.sweep(sweep);
+    EXPECT_TRUE(first[0].timedOut);
+    EXPECT_TRUE(first[1].success);
+    EXPECT_EQ(sweep.cacheSize(), 1);
+    std::vector<SweepRow> second = _abc.sweep(sweep);
+    EXPECT_FALSE(second[0].cached);
+    EXPECT_TRUE(second[0].timedOut);
+    EXPECT_TRUE(second[1].cached);
+    EXPECT_EQ(second[1].numAnd, first[1].numAnd);
+}
+
+} // namespace
@@ -0,0 +1,53 @@
+/**
+ * @file TestDesign.h
+ * @brief Small designs written on the fly for the unit tests
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#ifndef ABC_PY_UNITTEST_TEST_DESIGN_H_
+#define ABC_PY_UNITTEST_TEST_DESIGN_H_
+
+#include <fstream>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace abc_py_test
+{
+
+/// A combinational design of 4 inputs and 2 outputs with some redundancy for the passes to remove
+constexpr const char *COMB_BLIF =
+    ".model comb\n"
+    ".inputs a b c d\n"
+    ".outputs f g\n"
+    ".names a b x\n11 1\n"
+    ".names b a y\n11 1\n"
+    ".names x y c z\n111 1\n"
+    ".names z d f\n1- 1\n-1 1\n"
+    ".names a c d g\n1-0 1\n-11 1\n"
+    ".end\n";
+
+/// A sequential design: one latch toggled by the input
+constexpr const char *SEQ_BLIF =
+    ".model seq\n"
+    ".inputs en\n"
+    ".outputs q\n"
+    ".latch n q 0\n"
+    ".names en q n\n10 1\n01 1\n"
+    ".end\n";
+
+/// @brief write a design into the temporary directory of the tests
+/// @param first: the file name
+/// @param second: the contents
+/// @return the path
+inline std::string writeDesign(const std::string &name, const char *contents)
+{
+    std::string path = ::testing::TempDir() + name;
+    std::ofstream out(path);
+    out << contents;
+    return path;
+}
+
+} // namespace abc_py_test
+
+#endif //ABC_PY_UNITTEST_TEST_DESIGN_H_
@@ -0,0 +1,83 @@
+/**
+ * @file ForkTaskTest.cpp
+ * @brief The results, failures and deadlines of the forked tasks
+ * @author Keren Zhu
+ * @date 10/19/2026
+ */
+
+#include <stdexcept>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "util/ForkTask.h"
+
+using namespace PROJECT_NAMESPACE;
+
+namespace
+{
+
+TEST(ForkTaskTest, ReturnsTheResult)
+{
+    ForkTask task;
+    ASSERT_TRUE(task.start([]() { return std::string("result"); }));
+    EXPECT_TRUE(task.running());
+    std::string result;
+    EXPECT_EQ(task.finish(result), ForkStatus::OK);
+    EXPECT_EQ(result, "result");
+    EXPECT_FALSE(task.running());
+}
+
+TEST(ForkTaskTest, ResultLargerThanThePipe)
+{
+    ForkTask task;
+    ASSERT_TRUE(task.start([]() { return std::string(1 << 20, 'x'); }));
+    std::string result;
+    EXPECT_EQ(task.finish(result, 10), ForkStatus::OK);
+    EXPECT_EQ(result, std::string(1 << 20, 'x'));
+}
+
+TEST(ForkTaskTest, ExceptionFails)
+{
+    ForkTask task;
+    ASSERT_TRUE(task.start([]() -> std::string { throw std::runtime_error("child"); }));
+    std::string result;
+    EXPECT_EQ(task.finish(result), ForkStatus::FAILED);
+}
+
+TEST(ForkTaskTest, KilledAtTheDeadline)
+{
+    ForkTask task;
+    ASSERT_TRUE(task.start([]() { ::sleep(30); return std::string("late"); }));
+    std::string result;
+    EXPECT_EQ(task.finish(result, 0.2), ForkStatus::TIMEOUT);
+    EXPECT_TRUE(result.empty());
+    EXPECT_FALSE(task.running());
+}
+
+TEST(ForkTaskTest, FinishedChildIsNotTimedOut)
+{
+    // The child is done long before it is collected with no time left, as a busy caller would
+    ForkTask task;
+    ASSERT_TRUE(task.start([]() { return std::string("done"); }));
+    ::usleep(200000);
+    std::string result;
+    EXPECT_EQ(task.finish(result, 0), ForkStatus::OK);
+    EXPECT_EQ(result, "done");
+}
+
+TEST(ForkTaskTest, ReadReadyDrainsTheChild)
+{
+    ForkTask task;
+    ASSERT_TRUE(task.start([]() { return std::string("drained"); }));
+    ::usleep(200000);
+    bool closed = false;
+    for (IntType attempt = 0; attempt < 10 && !closed; ++attempt)
+    {
+        closed = task.readReady();
+    }
+    EXPECT_TRUE(closed);
+    std::string result;
+    EXPECT_EQ(task.finish(result, 0), ForkStatus::OK);
+    EXPECT_EQ(result, "drained");
+}
+
+} // namespace